@@ -38,6 +38,10 @@ project "Swift"
 		"src/Swift/Platforms/" .. FirstToUpper("%{cfg.system}") .. "/**.hpp",
 		"src/Swift/Platforms/" .. FirstToUpper("%{cfg.system}") .. "/**.cpp",
 
+		"src/Swift/Platforms/Headless/**.h",
+		"src/Swift/Platforms/Headless/**.hpp",
+		"src/Swift/Platforms/Headless/**.cpp",
+
 		"%{wks.location}/vendor/stb/src/stb_image.cpp"
 	}
 
@@ -65,7 +69,8 @@ project "Swift"
 	links
 	{
 		"%{Dependencies.GLFW.LibName}",
-		"%{Dependencies.VMA.LibName}"
+		"%{Dependencies.VMA.LibName}",
+		"%{Dependencies.Tracy.LibName}"
 	}
 
 	disablewarnings
@@ -90,7 +95,6 @@ project "Swift"
 
 		links
 		{
-			"%{Dependencies.Tracy.LibName}",
 			"%{Dependencies.Vulkan.Windows.LibDir}" .. "%{Dependencies.ShaderC.LibName}",
 			"%{Dependencies.Vulkan.Windows.LibDir}" .. "%{Dependencies.Vulkan.Windows.LibName}"
 		}
@@ -112,7 +116,10 @@ project "Swift"
 		links
 		{
 			"%{Dependencies.Vulkan.Linux.LibDir}" .. "%{Dependencies.Vulkan.Linux.LibName}",
-			"%{Dependencies.Vulkan.Linux.LibDir}" .. "%{Dependencies.ShaderC.LibName}"
+			"%{Dependencies.Vulkan.Linux.LibDir}" .. "%{Dependencies.ShaderC.LibName}",
+
+			"pthread",
+			"dl"
 		}
 
 	filter "configurations:Debug"
@@ -124,6 +131,7 @@ project "Swift"
 		defines
 		{
 			"TRACY_ENABLE",
+			"TRACY_ON_DEMAND",
 			"NOMINMAX"
 		}
 
@@ -135,6 +143,7 @@ project "Swift"
 		defines 
 		{
 			"TRACY_ENABLE",
+			"TRACY_ON_DEMAND",
 			"NOMINMAX"
 		}
 
@@ -7,8 +7,10 @@
 #include "Swift/Core/Input/Input.hpp"
 
 #include "Swift/Renderer/Renderer.hpp"
+#include "Swift/Renderer/FramePipeline.hpp"
 
 #include "Swift/Utils/Profiler.hpp"
+#include "Swift/Utils/JobSystem.hpp"
 
 namespace Swift
 {
@@ -20,16 +22,28 @@ namespace Swift
 	{
 		s_Instance = this;
 	
-		Input::Init();
 		Log::Init();
+		JobSystem::Init();
 
 		m_Window = Window::Create(appInfo.WindowSpecs);
 		m_Window->SetEventCallBack(APP_BIND_EVENT_FN(Application::OnEvent));
 
+		Input::Init();
 		Renderer::Init();
 
-        m_ImGuiLayer = BaseImGuiLayer::Create();
-        m_LayerStack.AddOverlay((Layer*)m_ImGuiLayer);
+		if (m_AppInfo.RenderThread)
+			Renderer::GetPipeline().SetFramesAhead(std::clamp(m_AppInfo.FramesAhead, 1u, RendererSpecification::MaxFramesAhead));
+
+		// Note(Jorben): There is nothing to display ImGui on when running headless
+		if (!m_Window->IsHeadless() && m_AppInfo.RenderThread)
+		{
+			APP_LOG_WARN("ImGui is disabled, it can't be used together with the render thread.");
+		}
+		else if (!m_Window->IsHeadless())
+		{
+			m_ImGuiLayer = BaseImGuiLayer::Create();
+			m_LayerStack.AddOverlay((Layer*)m_ImGuiLayer);
+		}
 	}
 
 	Application::~Application()
@@ -46,6 +60,8 @@ namespace Swift
 
 		Renderer::Destroy();
 		m_Window.reset();
+
+		JobSystem::Destroy();
 	}
 
 	void Application::OnEvent(Event& e)
@@ -65,6 +81,9 @@ namespace Swift
 
 	void Application::Run()
 	{
+		if (m_AppInfo.RenderThread)
+			m_RenderThread = std::thread(&Application::RenderLoop, this);
+
 		while (m_Running)
 		{
 			// Delta Time
@@ -76,10 +95,10 @@ namespace Swift
 
 			// Update & Render
 			m_Window->OnUpdate();
-			{
-				APP_PROFILE_SCOPE("Renderer::Begin");
-				Renderer::BeginFrame();
-			}
+			JobSystem::ExecuteMainThreadJobs();
+
+			// Note(Jorben): Everything submitted from here on is part of this frame's packet
+			Renderer::GetPipeline().BeginBuild();
 			{
 				APP_PROFILE_SCOPE("Update & Render Submit");
 				for (Layer* layer : m_LayerStack)
@@ -90,18 +109,27 @@ namespace Swift
 			}
 
             // ImGui
-            if (!m_Minimized)
+            if (!m_Minimized && m_ImGuiLayer)
             {
                 APP_PROFILE_SCOPE("ImGui Submit");
                 for (Layer* layer : m_LayerStack)
                     layer->OnImGuiRender();
             }
 
-			{
-				APP_PROFILE_SCOPE("Renderer::End");
-				Renderer::EndFrame();
-				m_Window->OnRender();
-			}
+			Renderer::GetPipeline().Publish();
+
+			if (!m_RenderThread.joinable())
+				RenderFrame();
+
+			if (m_AppInfo.MaxFrames && ++m_FrameCount >= m_AppInfo.MaxFrames)
+				Close();
+		}
+
+		// Note(Jorben): The render thread executes the frames that are still in flight before it stops
+		if (m_RenderThread.joinable())
+		{
+			Renderer::GetPipeline().Stop();
+			m_RenderThread.join();
 		}
 	}
 
@@ -123,6 +151,9 @@ namespace Swift
 
 	bool Application::OnWindowResize(WindowResizeEvent& e)
 	{
+		// Note(Jorben): Resizing recreates resources the frames in flight use, so the render thread has to be idle
+		Renderer::GetPipeline().Flush();
+
 		if (e.GetWidth() == 0 || e.GetHeight() == 0)
 		{
 			m_Minimized = true;
@@ -131,10 +162,38 @@ namespace Swift
 
 		Renderer::OnResize(e.GetWidth(), e.GetHeight());
 
-        m_ImGuiLayer->Resize(e.GetWidth(), e.GetHeight());
+        if (m_ImGuiLayer)
+            m_ImGuiLayer->Resize(e.GetWidth(), e.GetHeight());
 
 		m_Minimized = false;
 		return false;
 	}
 
+	void Application::RenderLoop()
+	{
+		APP_PROFILE_THREAD("Render thread");
+
+		while (RenderFrame())
+			;
+	}
+
+	bool Application::RenderFrame()
+	{
+		if (!Renderer::GetPipeline().Acquire())
+			return false;
+
+		{
+			APP_PROFILE_SCOPE("Renderer::Begin");
+			Renderer::BeginFrame();
+		}
+		{
+			APP_PROFILE_SCOPE("Renderer::End");
+			Renderer::EndFrame();
+			m_Window->OnRender();
+		}
+
+		Renderer::GetPipeline().Release();
+		return true;
+	}
+
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include <vector>
 #include <memory>
 #include <queue>
+#include <thread>
 #include <filesystem>
 
 namespace Swift
@@ -20,6 +21,15 @@ namespace Swift
 	public:
 		WindowSpecification WindowSpecs = { };
 
+		// Note(Jorben): Closes the application after this amount of frames, 0 means run until closed
+		uint32_t MaxFrames = 0u;
+
+		// Note(Jorben): Records & submits frames on a separate thread while the main thread updates and builds the next one.
+		// Every frame the main thread is allowed to run ahead adds a frame of latency (see RenderData::FrameLatency).
+		// ImGui isn't available with the render thread, since its GLFW backend has to run on the main thread.
+		bool RenderThread = false;
+		uint32_t FramesAhead = 1u; // Clamped to [1, RendererSpecification::MaxFramesAhead]
+
 	public:
 		ApplicationSpecification() = default;
 	};
@@ -48,12 +58,18 @@ namespace Swift
 		bool OnWindowClose(WindowCloseEvent& e);
 		bool OnWindowResize(WindowResizeEvent& e);
 
+		void RenderLoop();
+		bool RenderFrame();
+
 	private:
 		ApplicationSpecification m_AppInfo = {};
 
 		std::unique_ptr<Window> m_Window = nullptr;
 		bool m_Running = true;
 		bool m_Minimized = false;
+		uint32_t m_FrameCount = 0u;
+
+		std::thread m_RenderThread = {};
 
         BaseImGuiLayer* m_ImGuiLayer = nullptr;
 
@@ -2,8 +2,10 @@
 #include "Input.hpp"
 
 #include "Swift/Core/Logging.hpp"
+#include "Swift/Core/Application.hpp"
 
 #include "Swift/Platforms/Windows/WindowsInput.hpp"
+#include "Swift/Platforms/Headless/HeadlessInput.hpp"
 
 namespace Swift
 {
@@ -12,6 +14,13 @@ namespace Swift
 
 	void Input::Init()
 	{
+		// Note(Jorben): Input depends on the window, so it has to be created after the window
+		if (Application::Get().GetWindow().IsHeadless())
+		{
+			s_Instance = new HeadlessInput();
+			return;
+		}
+
 		#ifdef APP_PLATFORM_WINDOWS
 		s_Instance = new WindowsInput();
 		#endif
@@ -2,12 +2,16 @@
 #include "Window.hpp"
 
 #include "Swift/Platforms/Windows/WindowsWindow.hpp"
+#include "Swift/Platforms/Headless/HeadlessWindow.hpp"
 
 namespace Swift
 {
 
 	std::unique_ptr<Window> Window::Create(const WindowSpecification& properties)
 	{
+		if (properties.Headless)
+			return std::make_unique<HeadlessWindow>(properties);
+
 		#ifdef APP_PLATFORM_WINDOWS
 		return std::make_unique<WindowsWindow>(properties);
 		#endif
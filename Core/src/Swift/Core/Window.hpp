@@ -23,6 +23,9 @@ namespace Swift
 		//bool Titlebar = true; // TODO(Jorben): Implement using an updated GLFW branch
 		bool VSync = true;
 
+		// Note(Jorben): Creates no OS window, the renderer renders into offscreen images and doesn't present
+		bool Headless = false;
+
 		bool CustomPos = false;
 		uint32_t X = 0u;
 		uint32_t Y = 0u;
@@ -75,6 +78,8 @@ namespace Swift
 
 		virtual void SetTitle(const std::string& title) = 0;
 
+		virtual bool IsHeadless() const = 0;
+
 		virtual void* GetNativeWindow() const = 0;
 
 		static std::unique_ptr<Window> Create(const WindowSpecification& properties = WindowSpecification());
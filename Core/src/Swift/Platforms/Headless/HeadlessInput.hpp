@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Swift/Core/Input/Input.hpp"
+
+namespace Swift
+{
+
+	// Note(Jorben): Nothing is ever pressed without a window
+	class HeadlessInput : public Input
+	{
+	public:
+		HeadlessInput() = default;
+		virtual ~HeadlessInput() = default;
+
+		bool IsKeyPressedImplementation(Key keycode) override { return false; }
+		bool IsMousePressedImplementation(MouseButton button) override { return false; }
+
+		glm::vec2 GetMousePositionImplementation() override { return { 0.0f, 0.0f }; }
+
+		void SetCursorPositionImplementation(glm::vec2 position) override {}
+		void SetCursorModeImplementation(CursorMode mode) override {}
+	};
+
+}
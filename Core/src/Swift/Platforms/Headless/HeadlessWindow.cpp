@@ -0,0 +1,26 @@
+#include "swpch.h"
+#include "HeadlessWindow.hpp"
+
+#include "Swift/Utils/Profiler.hpp"
+
+namespace Swift
+{
+
+	HeadlessWindow::HeadlessWindow(const WindowSpecification& properties)
+	{
+		m_Data.Name = properties.Name;
+		m_Data.Width = properties.Width;
+		m_Data.Height = properties.Height;
+		m_Data.VSync = false; // Note(Jorben): There is nothing to sync to
+	}
+
+	void HeadlessWindow::OnUpdate()
+	{
+	}
+
+	void HeadlessWindow::OnRender()
+	{
+		APP_MARK_FRAME;
+	}
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Swift/Core/Window.hpp"
+
+namespace Swift
+{
+
+	// Note(Jorben): A window without an OS window behind it, used for rendering offscreen (benchmarks, CI, software ICDs)
+	class HeadlessWindow : public Window
+	{
+	public:
+		HeadlessWindow(const WindowSpecification& properties);
+		virtual ~HeadlessWindow() = default;
+
+		void SetEventCallBack(EventCallBackFunction func) override { m_Data.CallBack = func; }
+
+		void OnUpdate() override;
+		void OnRender() override;
+
+		uint32_t GetWidth() const override { return m_Data.Width; }
+		uint32_t GetHeight() const override { return m_Data.Height; }
+
+		uint32_t GetPositionX() const override { return 0u; }
+		uint32_t GetPositionY() const override { return 0u; }
+
+		uint32_t GetMonitorWidth() const override { return m_Data.Width; }
+		uint32_t GetMonitorHeight() const override { return m_Data.Height; }
+
+		void SetVSync(bool enabled) override { m_Data.VSync = enabled; }
+		bool IsVSync() const override { return m_Data.VSync; }
+
+		void SetTitle(const std::string& title) override { m_Data.Name = title; }
+
+		bool IsHeadless() const override { return true; }
+
+		void* GetNativeWindow() const override { return nullptr; }
+
+	private:
+		WindowData m_Data = {};
+
+	};
+
+}
@@ -143,7 +143,9 @@ namespace Swift::Utils
 
 	double WindowsToolKit::GetTimeImpl() const
 	{
-		return glfwGetTime();
+		// Note(Jorben): Not using glfwGetTime() since GLFW isn't initialized when running headless
+		static const auto start = std::chrono::steady_clock::now();
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 	}
 
 }
\ No newline at end of file
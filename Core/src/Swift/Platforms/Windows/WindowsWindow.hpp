@@ -32,6 +32,8 @@ namespace Swift
 
 		void SetTitle(const std::string& title) override;
 
+		bool IsHeadless() const override { return false; }
+
 		void* GetNativeWindow() const override { return (void*)m_Window; }
 
 	private:
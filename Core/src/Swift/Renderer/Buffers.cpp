@@ -87,7 +87,22 @@ namespace Swift
 		switch (RendererSpecification::API)
 		{
 		case RendererSpecification::RenderingAPI::Vulkan:
-			return RefHelper::Create<VulkanVertexBuffer>(data, size);
+			return RefHelper::Create<VulkanVertexBuffer>(data, size, false);
+
+		default:
+			APP_LOG_ERROR("Invalid API selected.");
+			break;
+		}
+
+		return nullptr;
+	}
+
+	Ref<VertexBuffer> VertexBuffer::CreateAsync(void* data, size_t size)
+	{
+		switch (RendererSpecification::API)
+		{
+		case RendererSpecification::RenderingAPI::Vulkan:
+			return RefHelper::Create<VulkanVertexBuffer>(data, size, true);
 
 		default:
 			APP_LOG_ERROR("Invalid API selected.");
@@ -102,7 +117,22 @@ namespace Swift
 		switch (RendererSpecification::API)
 		{
 		case RendererSpecification::RenderingAPI::Vulkan:
-			return RefHelper::Create<VulkanIndexBuffer>(indices, count);
+			return RefHelper::Create<VulkanIndexBuffer>(indices, count, false);
+
+		default:
+			APP_LOG_ERROR("Invalid API selected.");
+			break;
+		}
+
+		return nullptr;
+	}
+
+	Ref<IndexBuffer> IndexBuffer::CreateAsync(uint32_t* indices, uint32_t count)
+	{
+		switch (RendererSpecification::API)
+		{
+		case RendererSpecification::RenderingAPI::Vulkan:
+			return RefHelper::Create<VulkanIndexBuffer>(indices, count, true);
 
 		default:
 			APP_LOG_ERROR("Invalid API selected.");
@@ -157,4 +187,19 @@ namespace Swift
 		return nullptr;
 	}
 
+	Ref<IndirectBuffer> IndirectBuffer::Create(uint32_t maxCommands)
+	{
+		switch (RendererSpecification::API)
+		{
+		case RendererSpecification::RenderingAPI::Vulkan:
+			return RefHelper::Create<VulkanIndirectBuffer>(maxCommands);
+
+		default:
+			APP_LOG_ERROR("Invalid API selected.");
+			break;
+		}
+
+		return nullptr;
+	}
+
 }
\ No newline at end of file
@@ -3,12 +3,13 @@
 #include "Swift/Core/Core.hpp"
 #include "Swift/Utils/Utils.hpp"
 
+#include "Swift/Renderer/CommandBuffer.hpp"
+
 namespace Swift
 {
 
 	struct Descriptor;
 	class DescriptorSet;
-	class CommandBuffer;
 
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	// Specifications 
@@ -58,6 +59,17 @@ namespace Swift
 		uint32_t m_Stride = 0;
 	};
 
+	// Same layout as VkDrawIndexedIndirectCommand
+	struct IndexedIndirectCommand
+	{
+	public:
+		uint32_t IndexCount = 0;
+		uint32_t InstanceCount = 0;
+		uint32_t FirstIndex = 0;
+		int32_t VertexOffset = 0;
+		uint32_t FirstInstance = 0;
+	};
+
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	// Buffers 
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -69,7 +81,12 @@ namespace Swift
 
 		virtual void Bind(Ref<CommandBuffer> commandBuffer) = 0;
 
+		// Note(Jorben): Always true for buffers made with Create (unless the data failed to stage), see CreateAsync
+		virtual bool IsReady() const = 0;
+
 		static Ref<VertexBuffer> Create(void* data, size_t size);
+		// Returns right after the data is staged (see UploadManager), the buffer can't be used until it IsReady
+		static Ref<VertexBuffer> CreateAsync(void* data, size_t size);
 	};
 
 	class IndexBuffer
@@ -82,10 +99,14 @@ namespace Swift
 
 		virtual uint32_t GetCount() const = 0;
 
+		virtual bool IsReady() const = 0;
+
 		static Ref<IndexBuffer> Create(uint32_t* indices, uint32_t count);
+		static Ref<IndexBuffer> CreateAsync(uint32_t* indices, uint32_t count);
 	};
 
 	// Note(Jorben): Needs to be created after the pipeline
+	// Note(Jorben): SetData only writes to the copy of the current frame in flight, so data that changes has to be set every frame
 	class UniformBuffer
 	{
 	public:
@@ -127,6 +148,9 @@ namespace Swift
 
 		virtual void SetData(void* data, size_t size, size_t offset = 0) = 0;
 
+		// Note(Jorben): Resizing throws away the old contents and the descriptors have to be uploaded again
+		virtual void Resize(size_t dataSize) = 0;
+
 		virtual void* StartRetrieval() = 0;
 		virtual void EndRetrieval() = 0;
 
@@ -134,7 +158,37 @@ namespace Swift
 
 		virtual void Upload(Ref<DescriptorSet> set, Descriptor element) = 0;
 
+		// Hands the current frame's copy from one queue to another, see Image2D::Release & Image2D::Acquire.
+		// Note(Jorben): Only needed when the contents have to survive, a queue that overwrites the buffer can just start using it.
+		virtual void Release(Ref<CommandBuffer> commandBuffer, Queue from, Queue to) = 0;
+		virtual void Acquire(Ref<CommandBuffer> commandBuffer, Queue from, Queue to) = 0;
+
 		static Ref<StorageBuffer> Create(size_t dataSize);
 	};
 
+	// A draw count followed by IndexedIndirectCommands, so both can be written by a compute shader (std430):
+	// uint Count; uint Padding[3]; IndexedIndirectCommand Commands[];
+	// Note(Jorben): Like the StorageBuffer there's a copy per frame in flight, the setters only write to the current frame's copy
+	class IndirectBuffer
+	{
+	public:
+		inline static constexpr const size_t CommandOffset = 16;
+
+	public:
+		IndirectBuffer() = default;
+		virtual ~IndirectBuffer() = default;
+
+		virtual void SetCommands(const IndexedIndirectCommand* commands, uint32_t count, uint32_t first = 0) = 0;
+		virtual void SetCount(uint32_t count) = 0;
+
+		// Note(Jorben): Resizing throws away the old contents and the descriptors have to be uploaded again
+		virtual void Resize(uint32_t maxCommands) = 0;
+		virtual uint32_t GetMaxCommands() const = 0;
+
+		// As a storage buffer, for the shader filling it in
+		virtual void Upload(Ref<DescriptorSet> set, Descriptor element) = 0;
+
+		static Ref<IndirectBuffer> Create(uint32_t maxCommands);
+	};
+
 }
\ No newline at end of file
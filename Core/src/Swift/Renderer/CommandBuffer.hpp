@@ -11,7 +11,8 @@ namespace Swift
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	enum class CommandBufferUsage
 	{
-		None = 0, Sequence = BIT(0), Parallel = BIT(1)
+		None = 0, Sequence = BIT(0), Parallel = BIT(1),
+		Secondary = BIT(2) // Note(Jorben): Recorded inside a render pass begun with RenderPassContents::Secondary, can't be submitted
 	};
 	DEFINE_BITWISE_OPS(CommandBufferUsage)
 
@@ -20,10 +21,31 @@ namespace Swift
 		None = 0, Graphics, Compute
 	};
 
+	enum class TimingFlags : uint8_t
+	{
+		None = 0, PipelineStatistics = BIT(0) // Note(Jorben): Vertex, fragment & compute invocations, if the device supports it
+	};
+	DEFINE_BITWISE_OPS(TimingFlags)
+
+	// Where a pass reads or writes the buffers other passes on its queue use, see CommandBuffer::Barrier
+	enum class PipelineAccess : uint8_t
+	{
+		None = 0,
+		ComputeRead = BIT(0), ComputeWrite = BIT(1),
+		IndirectRead = BIT(2), VertexRead = BIT(3), FragmentRead = BIT(4)
+	};
+	DEFINE_BITWISE_OPS(PipelineAccess)
+
 	struct CommandBufferSpecification
 	{
 	public:
 		CommandBufferUsage Usage = CommandBufferUsage::Sequence;
+
+		// The only queue it can be submitted to. Note(Jorben): Compute may run on its own queue family, which needs command buffers of its own.
+		Queue SubmitQueue = Queue::Graphics;
+
+		// Recording thread whose command pools are used, only for secondary command buffers
+		uint32_t Thread = 0;
 	};
 
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -41,7 +63,37 @@ namespace Swift
 
 		virtual void WaitOnFinish() = 0;
 
+		virtual bool IsRecording() const = 0;
+
+		// Makes the writes of earlier work on this queue visible to the reads recorded after it, has to be recorded outside of a render pass.
+		// Note(Jorben): Sequence command buffers on the same queue share a batch without anything in between, so every pass
+		// orders its own inputs against the pass that produced them. Image layouts are handled by Image2D::Transition & the render passes.
+		virtual void Barrier(PipelineAccess written, PipelineAccess read) = 0;
+
+		// Note(Jorben): Has to be called between Begin() and End(), scopes can be nested.
+		// The results end up in Renderer::GetRenderData().Timings under the given name.
+		virtual void BeginTiming(const std::string& name, TimingFlags flags = TimingFlags::None) = 0;
+		virtual void EndTiming() = 0;
+
 		static Ref<CommandBuffer> Create(CommandBufferSpecification specs = {});
 	};
 
+	// Calls BeginTiming on construction and EndTiming on destruction
+	class ScopedTiming
+	{
+	public:
+		ScopedTiming(Ref<CommandBuffer> commandBuffer, const std::string& name, TimingFlags flags = TimingFlags::None)
+			: m_CommandBuffer(commandBuffer)
+		{
+			m_CommandBuffer->BeginTiming(name, flags);
+		}
+		~ScopedTiming()
+		{
+			m_CommandBuffer->EndTiming();
+		}
+
+	private:
+		Ref<CommandBuffer> m_CommandBuffer = nullptr;
+	};
+
 }
\ No newline at end of file
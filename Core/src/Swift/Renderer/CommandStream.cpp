@@ -0,0 +1,166 @@
+#include "swpch.h"
+#include "CommandStream.hpp"
+
+#include "Swift/Core/Logging.hpp"
+#include "Swift/Utils/Profiler.hpp"
+
+namespace Swift
+{
+
+	CommandStream::CommandStream()
+	{
+		for (auto& arena : m_Arenas)
+		{
+			arena.Head = AcquireBlock(BlockSize);
+			arena.Current = arena.Head;
+		}
+	}
+
+	CommandStream::~CommandStream()
+	{
+		Clear();
+	}
+
+	void CommandStream::Execute()
+	{
+		APP_PROFILE_SCOPE("CommandStream::Execute");
+
+		while (Drain(true))
+			;
+	}
+
+	void CommandStream::Clear()
+	{
+		while (Drain(false))
+			;
+	}
+
+	bool CommandStream::Empty() const
+	{
+		return m_Arenas[0].Head->Offset.load(std::memory_order_acquire) == 0 && m_Arenas[1].Head->Offset.load(std::memory_order_acquire) == 0;
+	}
+
+	CommandStream::Arena& CommandStream::BeginWrite()
+	{
+		// Note(Jorben): If the arenas got swapped between loading and registering, the consumer
+		// might already be draining this arena, so we back off and try the new one.
+		while (true)
+		{
+			Arena& arena = m_Arenas[m_Active.load(std::memory_order_seq_cst)];
+			arena.Writers.fetch_add(1, std::memory_order_seq_cst);
+
+			if (&arena == &m_Arenas[m_Active.load(std::memory_order_seq_cst)])
+				return arena;
+
+			arena.Writers.fetch_sub(1, std::memory_order_seq_cst);
+		}
+	}
+
+	void CommandStream::EndWrite(Arena& arena)
+	{
+		arena.Writers.fetch_sub(1, std::memory_order_release);
+	}
+
+	CommandStream::Header* CommandStream::Reserve(Arena& arena, size_t size)
+	{
+		while (true)
+		{
+			Block* block = arena.Current.load(std::memory_order_acquire);
+			size_t offset = block->Offset.fetch_add(size, std::memory_order_relaxed);
+
+			if (offset + size <= block->Capacity)
+				return (Header*)(block->Memory.get() + offset);
+
+			// Note(Jorben): We're the one who crossed the end of the block, so we mark the rest of it as padding
+			if (offset < block->Capacity)
+			{
+				Header* padding = new (block->Memory.get() + offset) Header();
+				padding->Size = (uint32_t)(block->Capacity - offset);
+			}
+
+			Grow(arena, block, size);
+		}
+	}
+
+	void CommandStream::Grow(Arena& arena, Block* full, size_t size)
+	{
+		std::scoped_lock<std::mutex> lock(m_BlockMutex);
+
+		// Someone else already moved on to a new block
+		if (arena.Current.load(std::memory_order_acquire) != full)
+			return;
+
+		Block* block = AcquireBlock(size);
+		full->Next = block;
+		arena.Current.store(block, std::memory_order_release);
+	}
+
+	CommandStream::Block* CommandStream::AcquireBlock(size_t size)
+	{
+		for (auto it = m_FreeBlocks.begin(); it != m_FreeBlocks.end(); ++it)
+		{
+			if ((*it)->Capacity >= size)
+			{
+				Block* block = *it;
+				m_FreeBlocks.erase(it);
+				return block;
+			}
+		}
+
+		// Note(Jorben): Only happens while the stream grows to the size a frame needs
+		std::unique_ptr<Block>& block = m_Blocks.emplace_back(std::make_unique<Block>());
+		block->Capacity = AlignUp(std::max(size, BlockSize));
+		block->Memory = std::make_unique<std::byte[]>(block->Capacity);
+
+		return block.get();
+	}
+
+	bool CommandStream::Drain(bool execute)
+	{
+		// Note(Jorben): New commands go to the other arena from here on, we only have to wait on the ones being written
+		Arena& arena = m_Arenas[m_Active.fetch_xor(1, std::memory_order_seq_cst)];
+		while (arena.Writers.load(std::memory_order_acquire) != 0)
+			std::this_thread::yield();
+
+		bool any = false;
+		for (Block* block = arena.Head; block; block = block->Next)
+		{
+			size_t end = std::min(block->Offset.load(std::memory_order_acquire), block->Capacity);
+
+			size_t position = 0;
+			while (position < end)
+			{
+				Header* header = (Header*)(block->Memory.get() + position);
+				if (header->Invoke)
+				{
+					header->Invoke((std::byte*)header + AlignUp(sizeof(Header)), execute);
+					any = true;
+				}
+
+				position += header->Size;
+			}
+		}
+
+		// Reset, the extra blocks go back to the pool for the next frame
+		std::scoped_lock<std::mutex> lock(m_BlockMutex);
+
+		Block* block = arena.Head->Next;
+		while (block)
+		{
+			Block* next = block->Next;
+
+			block->Offset = 0;
+			block->Next = nullptr;
+			m_FreeBlocks.push_back(block);
+
+			block = next;
+		}
+
+		arena.Head->Offset = 0;
+		arena.Head->Next = nullptr;
+		arena.Current.store(arena.Head, std::memory_order_release);
+
+		return any;
+	}
+
+}
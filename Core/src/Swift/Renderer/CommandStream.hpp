@@ -0,0 +1,116 @@
+#pragma once
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+#include "Swift/Core/Core.hpp"
+
+namespace Swift
+{
+
+	// A multi-producer, single-consumer stream of commands (any callable) which are stored inline in linear arenas.
+	// Appending is lock-free and doesn't allocate once the arena has grown to what a frame needs.
+	// Note(Jorben): There are two arenas, Execute swaps them so commands can be submitted while (and from inside) executing.
+	class CommandStream
+	{
+	public:
+		inline static constexpr const size_t BlockSize = 64ull * 1024ull;
+		inline static constexpr const size_t Alignment = 16;
+
+		CommandStream();
+		virtual ~CommandStream();
+
+		template<typename Func>
+		void Submit(Func&& func);
+
+		// Runs every command in submission order, including the ones submitted while executing.
+		// Note(Jorben): Only a single thread may execute (or clear) at a time.
+		void Execute();
+		// Destroys every command without running it
+		void Clear();
+
+		bool Empty() const;
+
+	private:
+		// Note(Jorben): Padding packets have no function and just skip to the end of a block
+		struct Header
+		{
+		public:
+			void (*Invoke)(void* payload, bool execute) = nullptr;
+			uint32_t Size = 0; // Including the header
+		};
+		static_assert(sizeof(Header) <= Alignment, "A header has to fit in the gap at the end of a block.");
+		static_assert(Alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Blocks are allocated with the default new alignment.");
+
+		struct Block
+		{
+		public:
+			std::unique_ptr<std::byte[]> Memory = nullptr;
+			size_t Capacity = 0;
+
+			std::atomic<size_t> Offset = 0;
+			Block* Next = nullptr;
+		};
+
+		struct Arena
+		{
+		public:
+			Block* Head = nullptr;
+			std::atomic<Block*> Current = nullptr;
+
+			std::atomic<uint32_t> Writers = 0;
+		};
+
+		static constexpr size_t AlignUp(size_t size) { return (size + Alignment - 1) & ~(Alignment - 1); }
+
+		Arena& BeginWrite();
+		void EndWrite(Arena& arena);
+
+		Header* Reserve(Arena& arena, size_t size);
+		void Grow(Arena& arena, Block* full, size_t size);
+
+		Block* AcquireBlock(size_t size);
+		bool Drain(bool execute);
+
+	private:
+		Arena m_Arenas[2] = { };
+		std::atomic<uint32_t> m_Active = 0;
+
+		std::mutex m_BlockMutex = {}; // Note(Jorben): Only taken when an arena runs out of space
+		std::vector<std::unique_ptr<Block>> m_Blocks = { };
+		std::vector<Block*> m_FreeBlocks = { };
+	};
+
+	template<typename Func>
+	void CommandStream::Submit(Func&& func)
+	{
+		using Payload = std::decay_t<Func>;
+		static_assert(alignof(Payload) <= Alignment, "Command payloads can't be aligned to more than CommandStream::Alignment.");
+
+		constexpr const size_t size = AlignUp(sizeof(Header)) + AlignUp(sizeof(Payload));
+
+		Arena& arena = BeginWrite();
+
+		Header* header = Reserve(arena, size);
+		new ((std::byte*)header + AlignUp(sizeof(Header))) Payload(std::forward<Func>(func));
+
+		header->Size = (uint32_t)size;
+		header->Invoke = [](void* payload, bool execute)
+		{
+			Payload* command = (Payload*)payload;
+			if (execute)
+				(*command)();
+
+			command->~Payload();
+		};
+
+		EndWrite(arena);
+	}
+
+}
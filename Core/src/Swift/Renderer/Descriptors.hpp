@@ -21,7 +21,7 @@ namespace Swift
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	enum class DescriptorType : uint8_t
 	{
-		None = 0, UniformBuffer, DynamicUniformBuffer, Image, StorageImage, StorageBuffer
+		None = 0, UniformBuffer, DynamicUniformBuffer, Image, StorageImage, StorageBuffer, DynamicStorageBuffer
 	};
 
 	enum class ShaderStage : uint8_t
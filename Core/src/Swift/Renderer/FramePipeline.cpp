@@ -0,0 +1,135 @@
+#include "swpch.h"
+#include "FramePipeline.hpp"
+
+#include "Swift/Core/Logging.hpp"
+#include "Swift/Utils/Profiler.hpp"
+
+#include "Swift/Renderer/Renderer.hpp"
+
+namespace Swift
+{
+
+	void FramePipeline::SetFramesAhead(uint32_t frames)
+	{
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+		APP_ASSERT((m_Published == m_Released), "FramePipeline::SetFramesAhead can't be called while frames are in flight.");
+
+		m_Packets = std::min(frames, RendererSpecification::MaxFramesAhead) + 1;
+		m_Building = (uint32_t)(m_Published % m_Packets);
+	}
+
+	void FramePipeline::BeginBuild()
+	{
+		APP_PROFILE_SCOPE("FramePipeline::BeginBuild");
+
+		double start = Utils::ToolKit::GetTime();
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Condition.wait(lock, [this]() { return m_Published - m_Released < m_Packets; });
+		}
+
+		FramePacket& packet = m_Ring[m_Building];
+		packet.BuildStart = start;
+		packet.BuildWait = (float)((Utils::ToolKit::GetTime() - start) * 1000.0);
+	}
+
+	void FramePipeline::Publish()
+	{
+		{
+			std::scoped_lock<std::mutex> lock(m_Mutex);
+			m_Ring[m_Building].Frame = m_Published++;
+		}
+		m_Condition.notify_all();
+
+		m_Building = (m_Building + 1) % m_Packets;
+	}
+
+	void FramePipeline::Flush()
+	{
+		APP_PROFILE_SCOPE("FramePipeline::Flush");
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_Condition.wait(lock, [this]() { return m_Released == m_Published; });
+	}
+
+	FramePacket* FramePipeline::Acquire()
+	{
+		APP_PROFILE_SCOPE("FramePipeline::Acquire");
+
+		double start = Utils::ToolKit::GetTime();
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Condition.wait(lock, [this]() { return m_Acquired < m_Published || m_Stopped; });
+
+			if (m_Acquired == m_Published)
+				return nullptr;
+
+			m_Executing = (uint32_t)(m_Acquired++ % m_Packets);
+		}
+		m_Executor.store(std::this_thread::get_id(), std::memory_order_release);
+
+		FramePacket& packet = m_Ring[m_Executing];
+
+		RenderData& data = Renderer::GetRenderData();
+		data.BuildWait = packet.BuildWait;
+		data.ExecuteWait = (float)((Utils::ToolKit::GetTime() - start) * 1000.0);
+
+		return &packet;
+	}
+
+	void FramePipeline::Release()
+	{
+		FramePacket& packet = m_Ring[m_Executing];
+
+		RenderData& data = Renderer::GetRenderData();
+		data.FrameLatency = (float)((Utils::ToolKit::GetTime() - packet.BuildStart) * 1000.0);
+
+		APP_PROFILE_PLOT("Frame latency (ms)", data.FrameLatency);
+		APP_PROFILE_PLOT("Build wait (ms)", data.BuildWait);
+		APP_PROFILE_PLOT("Execute wait (ms)", data.ExecuteWait);
+
+		m_Executor.store(std::thread::id(), std::memory_order_release);
+		{
+			std::scoped_lock<std::mutex> lock(m_Mutex);
+			m_Released++;
+		}
+		m_Condition.notify_all();
+	}
+
+	void FramePipeline::Stop()
+	{
+		{
+			std::scoped_lock<std::mutex> lock(m_Mutex);
+			m_Stopped = true;
+		}
+		m_Condition.notify_all();
+	}
+
+	CommandStream& FramePipeline::GetRenderStream()
+	{
+		return GetSubmitPacket().Render;
+	}
+
+	CommandStream& FramePipeline::GetUIStream()
+	{
+		return GetSubmitPacket().UI;
+	}
+
+	void FramePipeline::Clear()
+	{
+		for (auto& packet : m_Ring)
+		{
+			packet.Render.Clear();
+			packet.UI.Clear();
+		}
+	}
+
+	FramePacket& FramePipeline::GetSubmitPacket()
+	{
+		if (m_Executor.load(std::memory_order_acquire) == std::this_thread::get_id())
+			return m_Ring[m_Executing];
+
+		return m_Ring[m_Building];
+	}
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+
+#include "Swift/Core/Core.hpp"
+
+#include "Swift/Renderer/RendererConfig.hpp"
+#include "Swift/Renderer/CommandStream.hpp"
+
+namespace Swift
+{
+
+	// Everything the main thread submitted for a single frame
+	struct FramePacket
+	{
+	public:
+		CommandStream Render = {};
+		CommandStream UI = {};
+
+		uint64_t Frame = 0;
+
+		double BuildStart = 0.0; // Note(Jorben): Taken before waiting for the packet, so right after the frame's input was polled
+		float BuildWait = 0.0f;  // Milliseconds the main thread waited for this packet to become free
+	};
+
+	// A bounded ring of frame packets between the thread building frames (main) and the one executing them.
+	// Without a render thread there is a single packet which is built and executed back to back on the main thread.
+	// Note(Jorben): Every extra packet allows the main thread to run one more frame ahead, which adds a frame of latency.
+	class FramePipeline
+	{
+	public:
+		inline static constexpr const uint32_t MaxPackets = RendererSpecification::MaxFramesAhead + 1;
+
+		FramePipeline() = default;
+		virtual ~FramePipeline() = default;
+
+		// Note(Jorben): Can only be changed while no frame is in flight
+		void SetFramesAhead(uint32_t frames);
+		inline uint32_t GetFramesAhead() const { return m_Packets - 1; }
+
+		// Building side (main thread)
+		void BeginBuild(); // Waits until the next packet is free
+		void Publish();
+		void Flush();      // Waits until every published packet has been executed
+
+		// Executing side (render thread, or the main thread when there is none)
+		FramePacket* Acquire(); // Waits for a published packet, nullptr once stopped and everything is executed
+		void Release();
+		void Stop();
+
+		// Note(Jorben): Commands submitted while executing a packet belong to that packet
+		CommandStream& GetRenderStream();
+		CommandStream& GetUIStream();
+
+		// Destroys every command without running it
+		void Clear();
+
+	private:
+		FramePacket& GetSubmitPacket();
+
+	private:
+		std::array<FramePacket, MaxPackets> m_Ring = { };
+		uint32_t m_Packets = 1;
+
+		std::mutex m_Mutex = {};
+		std::condition_variable m_Condition = {};
+
+		uint64_t m_Published = 0;
+		uint64_t m_Acquired = 0;
+		uint64_t m_Released = 0;
+		bool m_Stopped = false;
+
+		uint32_t m_Building = 0;  // Note(Jorben): Only used by the building thread
+		uint32_t m_Executing = 0; // Note(Jorben): Only used by the executing thread
+		std::atomic<std::thread::id> m_Executor = std::thread::id();
+	};
+
+}
@@ -0,0 +1,28 @@
+#include "swpch.h"
+#include "FrameUploadRing.hpp"
+
+#include "Swift/Core/Logging.hpp"
+
+#include "Swift/Renderer/Renderer.hpp"
+
+#include "Swift/Vulkan/VulkanFrameUploadRing.hpp"
+
+namespace Swift
+{
+
+	Ref<FrameUploadRing> FrameUploadRing::Create(size_t sizePerFrame)
+	{
+		switch (RendererSpecification::API)
+		{
+		case RendererSpecification::RenderingAPI::Vulkan:
+			return RefHelper::Create<VulkanFrameUploadRing>(sizePerFrame);
+
+		default:
+			APP_ASSERT(false, "Invalid API selected.");
+			break;
+		}
+
+		return nullptr;
+	}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Swift/Core/Core.hpp"
+#include "Swift/Utils/Utils.hpp"
+
+namespace Swift
+{
+
+	struct Descriptor;
+	class DescriptorSet;
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Specifications 
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Note(Jorben): Only valid for the frame it was allocated in
+	struct FrameAllocation
+	{
+	public:
+		void* Data = nullptr;
+		size_t Offset = 0;
+		size_t Size = 0;
+
+	public:
+		inline bool Valid() const { return Data != nullptr; }
+		inline uint32_t GetDynamicOffset() const { return (uint32_t)Offset; }
+	};
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// FrameUploadRing 
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Note(Jorben): One host visible buffer per frame in flight, everything allocated in a frame is thrown away 
+	// once the ring is reset. The renderer's ring (Renderer::GetUploadRing()) is reset at Renderer::BeginFrame.
+	class FrameUploadRing
+	{
+	public:
+		FrameUploadRing() = default;
+		virtual ~FrameUploadRing() = default;
+
+		// Returns an aligned region in the current frame's buffer, thread safe
+		// Note(Jorben): Running out asserts, size the ring with RendererSpecification::UploadRingSize
+		virtual FrameAllocation Allocate(size_t size) = 0;
+		virtual FrameAllocation Push(const void* data, size_t size) = 0;
+
+		template<typename T>
+		inline FrameAllocation Push(const T& data) { return Push((const void*)&data, sizeof(T)); }
+
+		virtual void Reset() = 0;
+
+		virtual size_t GetAlignment() const = 0;
+		virtual size_t GetCapacity() const = 0;
+		virtual size_t GetUsed() const = 0;
+
+		// Points a DynamicUniformBuffer/DynamicStorageBuffer descriptor at the ring, pass the allocation's offset as dynamic offset when binding.
+		// Note(Jorben): This only has to be done once, the buffers never change.
+		virtual void Upload(Ref<DescriptorSet> set, Descriptor element, size_t range) = 0;
+
+		static Ref<FrameUploadRing> Create(size_t sizePerFrame);
+	};
+
+}
@@ -0,0 +1,28 @@
+#include "swpch.h"
+#include "GeometryPool.hpp"
+
+#include "Swift/Core/Logging.hpp"
+
+#include "Swift/Renderer/Renderer.hpp"
+
+#include "Swift/Vulkan/VulkanGeometryPool.hpp"
+
+namespace Swift
+{
+
+	Ref<GeometryPool> GeometryPool::Create(size_t vertexStride, uint32_t vertexCapacity, uint32_t indexCapacity)
+	{
+		switch (RendererSpecification::API)
+		{
+		case RendererSpecification::RenderingAPI::Vulkan:
+			return RefHelper::Create<VulkanGeometryPool>(vertexStride, vertexCapacity, indexCapacity);
+
+		default:
+			APP_ASSERT(false, "Invalid API selected.");
+			break;
+		}
+
+		return nullptr;
+	}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Swift/Core/Core.hpp"
+#include "Swift/Utils/Utils.hpp"
+
+#include "Swift/Renderer/UploadManager.hpp"
+
+namespace Swift
+{
+
+	class CommandBuffer;
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Specifications 
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Where a mesh lives in the pool, VertexOffset is added to every index (base vertex)
+	struct GeometryRange
+	{
+	public:
+		uint32_t VertexOffset = 0;
+		uint32_t VertexCount = 0;
+		uint32_t FirstIndex = 0;
+		uint32_t IndexCount = 0;
+
+		UploadPoint Upload = {};
+
+	public:
+		inline bool Valid() const { return IndexCount != 0; }
+	};
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GeometryPool 
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// One device local vertex buffer & index buffer that meshes are sub-allocated from, so both only have to be bound once per pass.
+	// Note(Jorben): The renderer's pool (Renderer::GetGeometryPool()) holds MeshVertex vertices and uint32_t indices.
+	class GeometryPool
+	{
+	public:
+		GeometryPool() = default;
+		virtual ~GeometryPool() = default;
+
+		// Stages the data through the UploadManager and returns right away, the range can't be drawn until its Upload is reached.
+		// Returns an invalid range when the pool is full or the data couldn't be staged. Thread safe.
+		virtual GeometryRange Allocate(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) = 0;
+		// Note(Jorben): Doesn't block, the range is given back once its upload and the frames in flight are done with it
+		virtual void Free(const GeometryRange& range) = 0;
+
+		// Binds the vertex buffer to binding 0 and the index buffer
+		virtual void Bind(Ref<CommandBuffer> commandBuffer) const = 0;
+
+		virtual size_t GetVertexStride() const = 0;
+		virtual uint32_t GetVertexCapacity() const = 0;
+		virtual uint32_t GetVerticesUsed() const = 0;
+		virtual uint32_t GetIndexCapacity() const = 0;
+		virtual uint32_t GetIndicesUsed() const = 0;
+
+		static Ref<GeometryPool> Create(size_t vertexStride, uint32_t vertexCapacity, uint32_t indexCapacity);
+	};
+
+}
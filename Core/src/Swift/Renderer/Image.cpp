@@ -25,7 +25,22 @@ namespace Swift
 		switch (RendererSpecification::API)
 		{
 		case RendererSpecification::RenderingAPI::Vulkan:
-			return RefHelper::Create<VulkanImage2D>(specs);
+			return RefHelper::Create<VulkanImage2D>(specs, false);
+
+		default:
+			APP_LOG_ERROR("Invalid API selected.");
+			break;
+		}
+
+		return nullptr;
+	}
+
+	Ref<Image2D> Image2D::CreateAsync(const ImageSpecification& specs)
+	{
+		switch (RendererSpecification::API)
+		{
+		case RendererSpecification::RenderingAPI::Vulkan:
+			return RefHelper::Create<VulkanImage2D>(specs, true);
 
 		default:
 			APP_LOG_ERROR("Invalid API selected.");
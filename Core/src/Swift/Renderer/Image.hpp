@@ -6,6 +6,8 @@
 #include "Swift/Core/Core.hpp"
 #include "Swift/Utils/Utils.hpp"
 
+#include "Swift/Renderer/CommandBuffer.hpp"
+
 namespace Swift
 {
 
@@ -66,19 +68,34 @@ namespace Swift
 		Image2D() = default;
 		virtual ~Image2D() = default;
 
+		// Note(Jorben): Waits on the upload, only images made with ImageUsage::File are uploaded asynchronously (see CreateAsync)
 		virtual void SetData(void* data, size_t size) = 0;
 
 		virtual void Resize(uint32_t width, uint32_t height) = 0;
 
 		virtual void Upload(Ref<DescriptorSet> set, Descriptor element) = 0;
+		// Note(Jorben): This one submits & waits on its own command, only use it outside of the frame (init/resize)
 		virtual void Transition(ImageLayout initial, ImageLayout final) = 0;
+		// Records the transition into the current frame of the commandBuffer, does nothing if the image is already in the final layout
+		// Note(Jorben): The barrier starts from the tracked layout, initial has to match it (or be Undefined)
+		virtual void Transition(Ref<CommandBuffer> commandBuffer, ImageLayout initial, ImageLayout final) = 0;
+
+		// Hands the image (and transitions it) from one queue to another. The release is recorded into a command buffer of the queue
+		// giving it up, the acquire into one of the queue receiving it, both with the same layouts.
+		// Note(Jorben): When both queues are of the same family the release is a regular transition and the acquire does nothing.
+		virtual void Release(Ref<CommandBuffer> commandBuffer, Queue from, Queue to, ImageLayout initial, ImageLayout final) = 0;
+		virtual void Acquire(Ref<CommandBuffer> commandBuffer, Queue from, Queue to, ImageLayout initial, ImageLayout final) = 0;
 
 		virtual ImageSpecification& GetSpecification() = 0;
 
 		virtual uint32_t GetWidth() const = 0;
 		virtual uint32_t GetHeight() const = 0;
 
+		virtual bool IsReady() const = 0;
+
 		static Ref<Image2D> Create(const ImageSpecification& specs);
+		// The file is still loaded right away, only the upload is done in the background (see UploadManager). The image can't be used until it IsReady.
+		static Ref<Image2D> CreateAsync(const ImageSpecification& specs);
 	};
 
 }
\ No newline at end of file
@@ -27,6 +27,11 @@ namespace Swift
 		None = 0x7FFFFFFF, Fill = 0, Line = 1
 	};
 
+	enum class CompareOperation : uint8_t
+	{
+		Never = 0, Less, Equal, LessOrEqual, Greater, NotEqual, GreaterOrEqual, Always
+	};
+
 	struct PipelineSpecification
 	{
 	public:
@@ -37,6 +42,12 @@ namespace Swift
 
 		float LineWidth = 1.0f;
 		bool Blending = false;
+
+		// Note(Jorben): A pass that runs after a depth pre-pass should load the depth buffer, 
+		// disable DepthWrite and use CompareOperation::Equal or CompareOperation::LessOrEqual.
+		bool DepthTest = true;
+		bool DepthWrite = true;
+		CompareOperation DepthCompareOp = CompareOperation::Less;
 	};
 
 	enum class PipelineBindPoint
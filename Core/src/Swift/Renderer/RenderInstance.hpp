@@ -6,13 +6,19 @@
 #include "Swift/Utils/Utils.hpp"
 
 #include "Swift/Renderer/RendererConfig.hpp"
+#include "Swift/Renderer/CommandStream.hpp"
 
 namespace Swift
 {
 
 	class CommandBuffer;
 	class IndexBuffer;
+	class IndirectBuffer;
 	class Image2D;
+	class FrameUploadRing;
+	class UploadManager;
+	class GeometryPool;
+	class FramePipeline;
 
 	class RenderInstance
 	{
@@ -25,23 +31,25 @@ namespace Swift
 		virtual void BeginFrame() = 0;
 		virtual void EndFrame() = 0;
 
-		virtual void Submit(RenderFunction function) = 0;
-		virtual void SubmitFree(FreeFunction function) = 0;
-		virtual void SubmitUI(UIFunction function) = 0;
-
 		virtual void Wait() = 0;
 
 		virtual void Draw(Ref<CommandBuffer> commandBuffer, uint32_t verticeCount) = 0;
-		virtual void DrawIndexed(Ref<CommandBuffer> commandBuffer, Ref<IndexBuffer> indexBuffer) = 0;
+		virtual void DrawIndexed(Ref<CommandBuffer> commandBuffer, Ref<IndexBuffer> indexBuffer, uint32_t instanceCount, uint32_t firstInstance) = 0;
+		virtual void DrawIndexed(Ref<CommandBuffer> commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) = 0;
+		virtual void DrawIndexedIndirect(Ref<CommandBuffer> commandBuffer, Ref<IndirectBuffer> buffer, uint32_t drawCount, uint32_t firstDraw) = 0;
+		virtual void DrawIndexedIndirectCount(Ref<CommandBuffer> commandBuffer, Ref<IndirectBuffer> buffer, uint32_t maxDrawCount) = 0;
 
 		virtual void OnResize(uint32_t width, uint32_t height) = 0;
 
-		virtual Utils::Queue<RenderFunction>& GetRenderQueue() = 0;
-		virtual Utils::Queue<FreeFunction>& GetFreeQueue() = 0;
+		virtual FramePipeline& GetPipeline() = 0;
+		virtual CommandStream& GetFreeStream() = 0;
 
 		virtual uint32_t GetCurrentFrame() const = 0;
 		virtual std::vector<Ref<Image2D>>& GetSwapChainImages() = 0;
 		virtual Ref<Image2D> GetDepthImage() = 0;
+		virtual Ref<FrameUploadRing> GetUploadRing() = 0;
+		virtual Ref<UploadManager> GetUploadManager() = 0;
+		virtual Ref<GeometryPool> GetGeometryPool() = 0;
 		
 		static RenderInstance* Create();
 	};
@@ -7,11 +7,16 @@
 
 #include <glm/glm.hpp>
 
+#include <functional>
+
 namespace Swift
 {
 
 	class CommandBuffer;
 
+	// Records draws [first, first + count) of a draw list into the given (secondary) command buffer
+	typedef std::function<void(Ref<CommandBuffer> commandBuffer, uint32_t first, uint32_t count)> RecordFunction;
+
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	// Specification 
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -21,6 +26,11 @@ namespace Swift
 	};
 	DEFINE_BITWISE_OPS(LoadOperation)
 
+	enum class RenderPassContents : uint8_t
+	{
+		Inline = 0, Secondary = 1
+	};
+
 	struct RenderPassSpecification
 	{
 	public:
@@ -45,10 +55,16 @@ namespace Swift
 		RenderPass() = default;
 		virtual ~RenderPass() = default;
 
-		virtual void Begin() = 0;
+		// Note(Jorben): Begins the command buffer as well, unless it's already recording. That way
+		// timing scopes can be opened around the render pass, which is required for secondary contents.
+		virtual void Begin(RenderPassContents contents = RenderPassContents::Inline) = 0;
 		virtual void End() = 0;
 		virtual void Submit(const std::vector<Ref<CommandBuffer>>& waitOn = { }) = 0;
 
+		// Splits [0, count) over the recording threads, records every range into a secondary command buffer
+		// and executes them in order. Only valid after Begin(RenderPassContents::Secondary).
+		virtual void RecordParallel(uint32_t count, RecordFunction function) = 0;
+
 		virtual void Resize(uint32_t width, uint32_t height) = 0;
 
 		virtual RenderPassSpecification& GetSpecification() = 0;
@@ -4,6 +4,7 @@
 #include "Swift/Core/Logging.hpp"
 
 #include "Swift/Renderer/RenderInstance.hpp"
+#include "Swift/Renderer/FramePipeline.hpp"
 
 #include "Swift/Renderer/Buffers.hpp"
 #include "Swift/Renderer/CommandBuffer.hpp"
@@ -41,34 +42,34 @@ namespace Swift
 		s_RenderInstance->EndFrame();
 	}
 
-	void Renderer::Submit(RenderFunction function)
+	void Renderer::Wait()
 	{
-		s_RenderInstance->Submit(function);
+		s_RenderInstance->Wait();
 	}
 
-	void Renderer::SubmitFree(FreeFunction function)
+	void Renderer::Draw(Ref<CommandBuffer> commandBuffer, uint32_t verticeCount)
 	{
-		s_RenderInstance->SubmitFree(function);
+		s_RenderInstance->Draw(commandBuffer, verticeCount);
 	}
 
-	void Renderer::SubmitUI(UIFunction function)
+	void Renderer::DrawIndexed(Ref<CommandBuffer> commandBuffer, Ref<IndexBuffer> indexBuffer, uint32_t instanceCount, uint32_t firstInstance)
 	{
-		s_RenderInstance->SubmitUI(function);
+		s_RenderInstance->DrawIndexed(commandBuffer, indexBuffer, instanceCount, firstInstance);
 	}
 
-	void Renderer::Wait()
+	void Renderer::DrawIndexed(Ref<CommandBuffer> commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
 	{
-		s_RenderInstance->Wait();
+		s_RenderInstance->DrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 	}
 
-	void Renderer::Draw(Ref<CommandBuffer> commandBuffer, uint32_t verticeCount)
+	void Renderer::DrawIndexedIndirect(Ref<CommandBuffer> commandBuffer, Ref<IndirectBuffer> buffer, uint32_t drawCount, uint32_t firstDraw)
 	{
-		s_RenderInstance->Draw(commandBuffer, verticeCount);
+		s_RenderInstance->DrawIndexedIndirect(commandBuffer, buffer, drawCount, firstDraw);
 	}
 
-	void Renderer::DrawIndexed(Ref<CommandBuffer> commandBuffer, Ref<IndexBuffer> indexBuffer)
+	void Renderer::DrawIndexedIndirectCount(Ref<CommandBuffer> commandBuffer, Ref<IndirectBuffer> buffer, uint32_t maxDrawCount)
 	{
-		s_RenderInstance->DrawIndexed(commandBuffer, indexBuffer);
+		s_RenderInstance->DrawIndexedIndirectCount(commandBuffer, buffer, maxDrawCount);
 	}
 
 	void Renderer::OnResize(uint32_t width, uint32_t height)
@@ -76,14 +77,24 @@ namespace Swift
 		s_RenderInstance->OnResize(width, height);
 	}
 
-	Utils::Queue<RenderFunction>& Renderer::GetRenderQueue()
+	FramePipeline& Renderer::GetPipeline()
+	{
+		return s_RenderInstance->GetPipeline();
+	}
+
+	CommandStream& Renderer::GetRenderStream()
 	{
-		return s_RenderInstance->GetRenderQueue();
+		return s_RenderInstance->GetPipeline().GetRenderStream();
 	}
 
-	Utils::Queue<FreeFunction>& Renderer::GetFreeQueue()
+	CommandStream& Renderer::GetFreeStream()
 	{
-		return s_RenderInstance->GetFreeQueue();
+		return s_RenderInstance->GetFreeStream();
+	}
+
+	CommandStream& Renderer::GetUIStream()
+	{
+		return s_RenderInstance->GetPipeline().GetUIStream();
 	}
 
 	uint32_t Renderer::GetCurrentFrame()
@@ -101,6 +112,21 @@ namespace Swift
 		return s_RenderInstance->GetDepthImage();
 	}
 
+	Ref<FrameUploadRing> Renderer::GetUploadRing()
+	{
+		return s_RenderInstance->GetUploadRing();
+	}
+
+	Ref<UploadManager> Renderer::GetUploadManager()
+	{
+		return s_RenderInstance->GetUploadManager();
+	}
+
+	Ref<GeometryPool> Renderer::GetGeometryPool()
+	{
+		return s_RenderInstance->GetGeometryPool();
+	}
+
 	RenderInstance* Renderer::GetInstance()
 	{
 		return s_RenderInstance;
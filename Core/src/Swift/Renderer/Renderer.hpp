@@ -7,6 +7,7 @@
 #include "Swift/Utils/Utils.hpp"
 
 #include "Swift/Renderer/RendererConfig.hpp"
+#include "Swift/Renderer/CommandStream.hpp"
 
 namespace Swift
 {
@@ -14,7 +15,12 @@ namespace Swift
 	class CommandBuffer;
 	class RenderInstance;
 	class IndexBuffer;
+	class IndirectBuffer;
 	class Image2D;
+	class FrameUploadRing;
+	class UploadManager;
+	class GeometryPool;
+	class FramePipeline;
 
 	class Renderer
 	{
@@ -26,23 +32,42 @@ namespace Swift
 		static void BeginFrame();
 		static void EndFrame();
 
-		static void Submit(RenderFunction function);
-		static void SubmitFree(FreeFunction function);
-		static void SubmitUI(UIFunction function);
+		// Note(Jorben): Commands are stored inline in the renderer's CommandStreams, they can be submitted
+		// from any thread and from inside other commands (which then run in the same Execute).
+		// Render & UI commands go into the packet of the frame that's being built (see FramePipeline).
+		template<typename Func>
+		inline static void Submit(Func&& function) { GetRenderStream().Submit(std::forward<Func>(function)); }
+		template<typename Func>
+		inline static void SubmitFree(Func&& function) { GetFreeStream().Submit(std::forward<Func>(function)); }
+		template<typename Func>
+		inline static void SubmitUI(Func&& function) { GetUIStream().Submit(std::forward<Func>(function)); }
 
 		static void Wait();
 
 		static void Draw(Ref<CommandBuffer> commandBuffer, uint32_t verticeCount = 3);
-		static void DrawIndexed(Ref<CommandBuffer> commandBuffer, Ref<IndexBuffer> indexBuffer);
+		// Note(Jorben): firstInstance is added to gl_InstanceIndex, which can be used to index per instance data
+		static void DrawIndexed(Ref<CommandBuffer> commandBuffer, Ref<IndexBuffer> indexBuffer, uint32_t instanceCount = 1, uint32_t firstInstance = 0);
+		// Draws from whatever index & vertex buffer are bound, like a GeometryRange of the GeometryPool
+		static void DrawIndexed(Ref<CommandBuffer> commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+		// Draws the buffer's commands [firstDraw, firstDraw + drawCount) from the bound index & vertex buffer
+		static void DrawIndexedIndirect(Ref<CommandBuffer> commandBuffer, Ref<IndirectBuffer> buffer, uint32_t drawCount, uint32_t firstDraw = 0);
+		// Draws as many commands as the buffer's count (written on the GPU) says, up to maxDrawCount
+		// Note(Jorben): Without drawIndirectCount support all maxDrawCount commands are drawn, so the ones past the count need an InstanceCount of 0
+		static void DrawIndexedIndirectCount(Ref<CommandBuffer> commandBuffer, Ref<IndirectBuffer> buffer, uint32_t maxDrawCount);
 
 		static void OnResize(uint32_t width, uint32_t height);
 
-		static Utils::Queue<RenderFunction>& GetRenderQueue();
-		static Utils::Queue<FreeFunction>& GetFreeQueue();
+		static FramePipeline& GetPipeline();
+		static CommandStream& GetRenderStream();
+		static CommandStream& GetFreeStream();
+		static CommandStream& GetUIStream();
 
 		static uint32_t GetCurrentFrame();
 		static std::vector<Ref<Image2D>>& GetSwapChainImages();
 		static Ref<Image2D> GetDepthImage();
+		static Ref<FrameUploadRing> GetUploadRing();
+		static Ref<UploadManager> GetUploadManager();
+		static Ref<GeometryPool> GetGeometryPool();
 
 		inline static RenderData& GetRenderData() { return s_Data; }
 
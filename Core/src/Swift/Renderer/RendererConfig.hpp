@@ -1,5 +1,11 @@
 #pragma once
 
+#include <map>
+#include <array>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <algorithm>
 #include <functional>
 
 #include "Swift/Core/Core.hpp"
@@ -7,10 +13,6 @@
 namespace Swift
 {
 
-	typedef std::function<void()> RenderFunction;
-	typedef std::function<void()> FreeFunction;
-	typedef std::function<void()> UIFunction;
-
 	struct RendererSpecification
 	{
 	public:
@@ -25,12 +27,89 @@ namespace Swift
 	public:
 		inline static constexpr const RenderingAPI API = RenderingAPI::Vulkan;
 		inline static constexpr const BufferMode BufferCount = BufferMode::Triple;
+
+		// Size of the renderer's FrameUploadRing per frame in flight
+		inline static constexpr const size_t UploadRingSize = 4ull * 1024ull * 1024ull;
+		// Size of the UploadManager's staging ring, a single upload that's bigger gets a staging buffer of its own
+		inline static constexpr const size_t StagingRingSize = 32ull * 1024ull * 1024ull;
+		// Amount of vertices & indices the renderer's GeometryPool has room for, every Mesh is sub-allocated from it
+		inline static constexpr const uint32_t GeometryPoolVertices = 2u * 1024u * 1024u;
+		inline static constexpr const uint32_t GeometryPoolIndices = 8u * 1024u * 1024u;
+
+		// Max amount of batches (each with its own command pools per frame in flight) RenderPass::RecordParallel records on the JobSystem
+		inline static const uint32_t RecordingThreads = std::clamp(std::thread::hardware_concurrency(), 1u, 16u);
+		// Ranges smaller than this aren't worth a secondary command buffer of their own
+		inline static constexpr const uint32_t MinRecordBatch = 64;
+
+		// Max amount of frames the main thread can build ahead of the render thread (see ApplicationSpecification::FramesAhead)
+		inline static constexpr const uint32_t MaxFramesAhead = 2;
+	};
+
+	struct PipelineStatistics
+	{
+	public:
+		uint64_t VertexInvocations = 0;
+		uint64_t FragmentInvocations = 0;
+		uint64_t ComputeInvocations = 0;
+	};
+
+	// Timings of a named GPU scope in milliseconds, over the last Window resolved frames
+	struct GPUTiming
+	{
+	public:
+		inline static constexpr const size_t Window = 120;
+
+		float Last = 0.0f;
+		float Min = 0.0f;
+		float Average = 0.0f;
+		float Max = 0.0f;
+
+		// Note(Jorben): Only filled in when the scope was started with TimingFlags::PipelineStatistics
+		PipelineStatistics Statistics = {};
+
+	public:
+		inline void AddSample(float time)
+		{
+			Last = time;
+
+			m_Samples[m_Next] = time;
+			m_Next = (m_Next + 1) % Window;
+			m_Count = std::min(m_Count + 1, Window);
+
+			Min = time;
+			Max = time;
+			float total = 0.0f;
+			for (size_t i = 0; i < m_Count; i++)
+			{
+				Min = std::min(Min, m_Samples[i]);
+				Max = std::max(Max, m_Samples[i]);
+				total += m_Samples[i];
+			}
+			Average = total / (float)m_Count;
+		}
+
+	private:
+		std::array<float, Window> m_Samples = { };
+		size_t m_Count = 0;
+		size_t m_Next = 0;
 	};
 
 	struct RenderData
 	{
 	public:
-		uint32_t DrawCalls = 0;
+		std::atomic<uint32_t> DrawCalls = 0; // Note(Jorben): Draws can be recorded from multiple threads
+
+		// Note(Jorben): GPU timings are resolved once a frame's GPU work has finished, so they lag
+		// RendererSpecification::BufferCount frames behind and are not reset every frame.
+		float GPUTime = 0.0f; // Sum of the top level scopes of the last resolved frame
+		std::map<std::string, GPUTiming> Timings = { };
+		float AsyncComputeOverlap = 0.0f; // Milliseconds top level compute scopes ran alongside graphics ones, 0 without a dedicated compute family
+
+		// Note(Jorben): Frame pipelining in milliseconds, written by the thread executing the frames.
+		// The waits are of the frame being executed, the latency is of the last presented frame.
+		float BuildWait = 0.0f; // Main thread waiting for a free packet (the render thread is the bottleneck)
+		float ExecuteWait = 0.0f; // Render thread waiting for a published packet (the main thread is the bottleneck)
+		float FrameLatency = 0.0f; // From polling the frame's input until it was presented
 
 	public:
 		inline void Reset()
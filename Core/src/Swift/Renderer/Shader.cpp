@@ -67,6 +67,36 @@ namespace Swift
 		return nullptr;
 	}
 
+	// Returns the latest write time of the shader and all the files it (recursively) includes
+	static std::filesystem::file_time_type GetLatestWriteTime(const std::filesystem::path& shader, uint32_t depth = 0)
+	{
+		auto latest = std::filesystem::last_write_time(shader);
+		if (depth > 8)
+			return latest;
+
+		std::ifstream file(shader);
+		std::string line = {};
+		while (std::getline(file, line))
+		{
+			size_t start = line.find("#include \"");
+			if (start == std::string::npos)
+				continue;
+
+			start += std::string("#include \"").size();
+			size_t end = line.find('"', start);
+			if (end == std::string::npos)
+				continue;
+
+			std::filesystem::path include = shader.parent_path() / line.substr(start, end - start);
+			if (!std::filesystem::exists(include))
+				continue;
+
+			latest = std::max(latest, GetLatestWriteTime(include, depth + 1));
+		}
+
+		return latest;
+	}
+
 	void ShaderCacher::Cache(const std::filesystem::path& path, const std::vector<char>& code)
 	{
 		std::ofstream file(path, std::ios::binary);
@@ -96,7 +126,7 @@ namespace Swift
 		}
 
 		auto cacheTime = std::filesystem::last_write_time(cache);
-		auto shaderTime = std::filesystem::last_write_time(shader);
+		auto shaderTime = GetLatestWriteTime(shader);
 
 		return cacheTime >= shaderTime;
 	}
@@ -106,7 +136,7 @@ namespace Swift
 		if (CacheUpToDate(cache, shader))
 			return Retrieve(cache);
 
-		auto result = compiler->Compile(ShaderSpecification::ReadGLSLFile(shader), stage);
+		auto result = compiler->Compile(ShaderSpecification::ReadGLSLFile(shader), stage, shader);
 		Cache(cache, result);
 		return result;
 	}
@@ -43,7 +43,8 @@ namespace Swift
 		ShaderCompiler() = default;
 		virtual ~ShaderCompiler() = default;
 
-		virtual std::vector<char> Compile(const std::string& code, ShaderStage stage) = 0;
+		// Note(Jorben): The path is used to resolve `#include "..."` directives (relative to the including file)
+		virtual std::vector<char> Compile(const std::string& code, ShaderStage stage, const std::filesystem::path& path = {}) = 0;
 		virtual ShaderSpecification Compile(const std::string& fragment, const std::string& vertex) = 0;
 
 		static Ref<ShaderCompiler> Create();
@@ -58,6 +59,7 @@ namespace Swift
 		void Cache(const std::filesystem::path& path, const std::vector<char>& code);
 		std::vector<char> Retrieve(const std::filesystem::path& path);
 
+		// Note(Jorben): Also takes the shader's (nested) includes into account
 		bool CacheUpToDate(const std::filesystem::path& cache, const std::filesystem::path& shader);
 
 		std::vector<char> GetLatest(Ref<ShaderCompiler> compiler, const std::filesystem::path& cache, const std::filesystem::path& shader, ShaderStage stage);
@@ -0,0 +1,28 @@
+#include "swpch.h"
+#include "UploadManager.hpp"
+
+#include "Swift/Core/Logging.hpp"
+
+#include "Swift/Renderer/Renderer.hpp"
+
+#include "Swift/Vulkan/VulkanUploadManager.hpp"
+
+namespace Swift
+{
+
+	Ref<UploadManager> UploadManager::Create(size_t stagingSize)
+	{
+		switch (RendererSpecification::API)
+		{
+		case RendererSpecification::RenderingAPI::Vulkan:
+			return RefHelper::Create<VulkanUploadManager>(stagingSize);
+
+		default:
+			APP_ASSERT(false, "Invalid API selected.");
+			break;
+		}
+
+		return nullptr;
+	}
+
+}
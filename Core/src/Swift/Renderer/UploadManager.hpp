@@ -0,0 +1,60 @@
+#pragma once
+
+#include <functional>
+
+#include "Swift/Core/Core.hpp"
+#include "Swift/Utils/Utils.hpp"
+
+namespace Swift
+{
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Specifications
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// A batch of uploads, it's done once the manager's timeline reached the value
+	// Note(Jorben): A Failed point (the data couldn't be staged) is never complete, so whatever depends on it is never treated as ready
+	struct UploadPoint
+	{
+	public:
+		inline static constexpr const uint64_t FailedValue = MAX_UINT64;
+
+		uint64_t Value = 0;
+
+		inline operator bool() const { return Value != 0; }
+		inline bool Failed() const { return Value == FailedValue; }
+	};
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// UploadManager
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Collects the copies of everything created with data (VertexBuffer, IndexBuffer, Image2D) into batches. The data is copied
+	// into a reusable staging ring right away and a whole batch is submitted at once on the transfer queue.
+	// Note(Jorben): The renderer's manager (Renderer::GetUploadManager()) submits what's staged and runs finished callbacks at Renderer::BeginFrame.
+	class UploadManager
+	{
+	public:
+		UploadManager() = default;
+		virtual ~UploadManager() = default;
+
+		// Submits everything staged so far as a single batch, without waiting on it
+		virtual void Flush() = 0;
+		// Reclaims the staging memory of finished batches and runs their callbacks
+		virtual void Poll() = 0;
+		// Flushes if needed and waits until the point is reached, an empty point waits on everything staged so far and a failed one returns right away
+		virtual void Wait(UploadPoint point = {}) = 0;
+
+		// Note(Jorben): Only changes when a batch is found to be done, so during Poll/Wait
+		virtual bool IsComplete(UploadPoint point) const = 0;
+		// The point everything staged so far reaches
+		virtual UploadPoint GetPoint() const = 0;
+
+		// Runs once the point is reached (or right away if it already is, or failed) on the thread calling Poll/Wait, an empty point means everything staged so far
+		virtual void OnComplete(std::function<void()> callback, UploadPoint point = {}) = 0;
+
+		virtual size_t GetCapacity() const = 0;
+		virtual size_t GetUsed() const = 0;
+
+		static Ref<UploadManager> Create(size_t stagingSize);
+	};
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <charconv>
+
+namespace Swift::Utils
+{
+
+	// Command line helpers for CreateApplication.
+	// Note(Jorben): The logger isn't initialized yet, so invalid values are reported on stderr and the application exits with EXIT_FAILURE
+	class Arguments
+	{
+	public:
+		// The whole value has to be a valid T, otherwise it's reported as invalid
+		template<typename T>
+		inline static void ParseValue(const std::string& argument, const char* value, T& result)
+		{
+			const char* end = value + std::strlen(value);
+
+			T parsed = {};
+			auto [last, error] = std::from_chars(value, end, parsed);
+			if (error != std::errc() || last != end)
+				Invalid(argument, value);
+
+			result = parsed;
+		}
+
+		// For values that don't go through ParseValue (names, options), expected lists what is accepted
+		[[noreturn]] inline static void Invalid(const std::string& argument, const char* value, const char* expected = nullptr)
+		{
+			if (expected)
+				std::fprintf(stderr, "Invalid value '%s' for %s, expected %s.\n", value, argument.c_str(), expected);
+			else
+				std::fprintf(stderr, "Invalid value '%s' for %s.\n", value, argument.c_str());
+
+			std::exit(EXIT_FAILURE);
+		}
+	};
+
+}
@@ -0,0 +1,95 @@
+#include "swpch.h"
+#include "FreeList.hpp"
+
+#include "Swift/Core/Logging.hpp"
+
+namespace Swift
+{
+
+	FreeList::FreeList(uint64_t capacity)
+		: m_Capacity(capacity)
+	{
+		if (m_Capacity > 0)
+			m_Blocks[0] = m_Capacity;
+	}
+
+	bool FreeList::Allocate(uint64_t size, uint64_t& offset)
+	{
+		if (size == 0)
+			return false;
+
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+
+		for (auto it = m_Blocks.begin(); it != m_Blocks.end(); it++)
+		{
+			if (it->second < size)
+				continue;
+
+			offset = it->first;
+			uint64_t remaining = it->second - size;
+
+			m_Blocks.erase(it);
+			if (remaining > 0)
+				m_Blocks[offset + size] = remaining;
+
+			m_Used += size;
+			return true;
+		}
+
+		return false;
+	}
+
+	void FreeList::Free(uint64_t offset, uint64_t size)
+	{
+		if (size == 0)
+			return;
+
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+		APP_ASSERT(offset + size <= m_Capacity, "Freed a block outside of the FreeList.");
+
+		m_Used -= size;
+
+		auto next = m_Blocks.lower_bound(offset);
+		APP_ASSERT(next == m_Blocks.end() || next->first >= offset + size, "Freed a block that overlaps a free block.");
+
+		// Merge with the block after it
+		if (next != m_Blocks.end() && next->first == offset + size)
+		{
+			size += next->second;
+			next = m_Blocks.erase(next);
+		}
+
+		// And with the block before it
+		if (next != m_Blocks.begin())
+		{
+			auto previous = std::prev(next);
+			APP_ASSERT(previous->first + previous->second <= offset, "Freed a block that overlaps a free block.");
+
+			if (previous->first + previous->second == offset)
+			{
+				previous->second += size;
+				return;
+			}
+		}
+
+		m_Blocks[offset] = size;
+	}
+
+	uint64_t FreeList::GetUsed() const
+	{
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+		return m_Used;
+	}
+
+	uint64_t FreeList::GetLargestFree() const
+	{
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+
+		uint64_t largest = 0;
+		for (auto& [offset, size] : m_Blocks)
+			largest = std::max(largest, size);
+
+		return largest;
+	}
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+
+#include "Swift/Core/Core.hpp"
+
+namespace Swift
+{
+
+	// First fit sub-allocator over [0, capacity), neighbouring free blocks are merged again when freed.
+	// Note(Jorben): Only keeps track of offsets (in whatever unit the user picks), thread safe.
+	class FreeList
+	{
+	public:
+		FreeList(uint64_t capacity);
+		virtual ~FreeList() = default;
+
+		// Returns false when no free block is big enough
+		bool Allocate(uint64_t size, uint64_t& offset);
+		void Free(uint64_t offset, uint64_t size);
+
+		inline uint64_t GetCapacity() const { return m_Capacity; }
+		uint64_t GetUsed() const;
+		// The biggest size an allocation can currently have
+		uint64_t GetLargestFree() const;
+
+	private:
+		uint64_t m_Capacity = 0;
+		uint64_t m_Used = 0;
+
+		std::map<uint64_t, uint64_t> m_Blocks = { }; // Offset -> size of every free block
+
+		mutable std::mutex m_Mutex = {};
+	};
+
+}
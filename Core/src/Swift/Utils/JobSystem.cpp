@@ -0,0 +1,343 @@
+#include "swpch.h"
+#include "JobSystem.hpp"
+
+#include "Swift/Core/Logging.hpp"
+#include "Swift/Utils/Profiler.hpp"
+
+namespace Swift
+{
+
+	struct JobCounter::Job
+	{
+	public:
+		JobFunction Function = nullptr;
+		JobHandle Counter = nullptr;
+		JobAffinity Affinity = JobAffinity::Any;
+
+		// Unfinished dependencies (+1 while the job is still being scheduled)
+		std::atomic<uint32_t> Waiting = 0;
+	};
+
+	static thread_local uint32_t s_ThreadIndex = 0;
+
+	std::vector<std::thread> JobSystem::s_Workers = { };
+	std::vector<std::unique_ptr<JobSystem::WorkQueue>> JobSystem::s_Queues = { };
+	JobSystem::WorkQueue JobSystem::s_MainThreadQueue = {};
+
+	std::mutex JobSystem::s_WakeMutex = {};
+	std::condition_variable JobSystem::s_WakeCondition = {};
+	std::atomic<uint32_t> JobSystem::s_QueuedJobs = 0;
+	std::atomic<bool> JobSystem::s_Running = false;
+	std::atomic<uint32_t> JobSystem::s_NextQueue = 0;
+
+	std::thread::id JobSystem::s_MainThread = {};
+
+	void JobSystem::Init(uint32_t workers)
+	{
+		if (s_Running)
+		{
+			APP_LOG_WARN("JobSystem::Init called twice.");
+			return;
+		}
+
+		if (workers == 0)
+			workers = std::max(std::thread::hardware_concurrency(), 2u) - 1u;
+
+		s_MainThread = std::this_thread::get_id();
+		s_Running = true;
+
+		s_Queues.resize((size_t)workers + 1);
+		for (auto& queue : s_Queues)
+			queue = std::make_unique<WorkQueue>();
+
+		s_Workers.reserve((size_t)workers);
+		for (uint32_t i = 1; i <= workers; i++)
+			s_Workers.emplace_back(&JobSystem::WorkerLoop, i);
+	}
+
+	bool JobSystem::Initialized()
+	{
+		return s_Running;
+	}
+
+	void JobSystem::Destroy()
+	{
+		if (!s_Running)
+			return;
+
+		// Note(Jorben): Finish everything that's still queued before shutting down
+		while (s_QueuedJobs.load(std::memory_order_acquire) > 0)
+		{
+			if (!TryExecute(0))
+				std::this_thread::yield();
+		}
+		ExecuteMainThreadJobs();
+
+		{
+			std::scoped_lock<std::mutex> lock(s_WakeMutex);
+			s_Running = false;
+		}
+		s_WakeCondition.notify_all();
+
+		for (auto& worker : s_Workers)
+			worker.join();
+
+		s_Workers.clear();
+		s_Queues.clear();
+	}
+
+	JobHandle JobSystem::Schedule(JobFunction function, const std::vector<JobHandle>& dependencies, JobAffinity affinity)
+	{
+		JobHandle counter = RefHelper::Create<JobCounter>(1);
+
+		// Note(Jorben): Without workers (before Init/after Destroy) jobs run right away
+		if (!s_Running)
+		{
+			Wait(dependencies);
+			function();
+			counter->m_Pending = 0;
+			return counter;
+		}
+
+		Ref<JobCounter::Job> job = RefHelper::Create<JobCounter::Job>();
+		job->Function = std::move(function);
+		job->Counter = counter;
+		job->Affinity = affinity;
+		job->Waiting = (uint32_t)dependencies.size() + 1;
+
+		for (auto& dependency : dependencies)
+		{
+			bool pending = false;
+			if (dependency)
+			{
+				std::scoped_lock<std::mutex> lock(dependency->m_Mutex);
+				if (!dependency->IsFinished())
+				{
+					dependency->m_Continuations.push_back(job);
+					pending = true;
+				}
+			}
+
+			if (!pending)
+				job->Waiting--;
+		}
+
+		if (job->Waiting.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			Push(job);
+
+		return counter;
+	}
+
+	JobHandle JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, ParallelForFunction function, const std::vector<JobHandle>& dependencies)
+	{
+		batchSize = std::max(batchSize, 1u);
+		uint32_t batches = (count + batchSize - 1) / batchSize;
+
+		if (batches <= 1)
+		{
+			return Schedule([count, function]()
+			{
+				if (count)
+					function(0, count);
+			}, dependencies);
+		}
+
+		// Note(Jorben): All batches share one counter, so there's only a single handle to wait on
+		JobHandle counter = RefHelper::Create<JobCounter>(batches);
+		Ref<ParallelForFunction> shared = RefHelper::Create<ParallelForFunction>(std::move(function));
+
+		for (uint32_t i = 0; i < batches; i++)
+		{
+			uint32_t first = i * batchSize;
+			uint32_t amount = std::min(batchSize, count - first);
+
+			Schedule([counter, shared, first, amount]()
+			{
+				(*shared)(first, amount);
+				Finish(counter);
+			}, dependencies);
+		}
+
+		return counter;
+	}
+
+	void JobSystem::Wait(const JobHandle& handle)
+	{
+		if (!handle)
+			return;
+
+		APP_PROFILE_SCOPE("JobSystem::Wait");
+
+		bool mainThread = IsMainThread();
+		while (!handle->IsFinished())
+		{
+			if (TryExecute(s_ThreadIndex))
+				continue;
+
+			// Note(Jorben): The main thread might be waiting on a job that's bound to it
+			if (mainThread)
+			{
+				Ref<JobCounter::Job> job = nullptr;
+				{
+					std::scoped_lock<std::mutex> lock(s_MainThreadQueue.Mutex);
+					if (!s_MainThreadQueue.Jobs.empty())
+					{
+						job = s_MainThreadQueue.Jobs.front();
+						s_MainThreadQueue.Jobs.pop_front();
+					}
+				}
+
+				if (job)
+				{
+					Execute(job);
+					continue;
+				}
+			}
+
+			std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::Wait(const std::vector<JobHandle>& handles)
+	{
+		for (auto& handle : handles)
+			Wait(handle);
+	}
+
+	void JobSystem::ExecuteMainThreadJobs()
+	{
+		APP_PROFILE_SCOPE("JobSystem::ExecuteMainThreadJobs");
+		APP_ASSERT(IsMainThread(), "Main thread jobs can only be executed on the main thread.");
+
+		std::deque<Ref<JobCounter::Job>> jobs = { };
+		{
+			std::scoped_lock<std::mutex> lock(s_MainThreadQueue.Mutex);
+			std::swap(jobs, s_MainThreadQueue.Jobs);
+		}
+
+		for (auto& job : jobs)
+			Execute(job);
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return (uint32_t)s_Workers.size();
+	}
+
+	uint32_t JobSystem::GetThreadIndex()
+	{
+		return s_ThreadIndex;
+	}
+
+	bool JobSystem::IsMainThread()
+	{
+		return std::this_thread::get_id() == s_MainThread;
+	}
+
+	void JobSystem::WorkerLoop(uint32_t index)
+	{
+		s_ThreadIndex = index;
+
+		while (s_Running)
+		{
+			if (TryExecute(index))
+				continue;
+
+			std::unique_lock<std::mutex> lock(s_WakeMutex);
+			s_WakeCondition.wait(lock, []() { return !s_Running || s_QueuedJobs.load(std::memory_order_acquire) > 0; });
+		}
+	}
+
+	void JobSystem::Push(Ref<JobCounter::Job> job)
+	{
+		if (job->Affinity == JobAffinity::MainThread)
+		{
+			std::scoped_lock<std::mutex> lock(s_MainThreadQueue.Mutex);
+			s_MainThreadQueue.Jobs.push_back(job);
+			return;
+		}
+
+		// Note(Jorben): Workers push onto their own deque, other threads spread their jobs over the workers
+		uint32_t index = s_ThreadIndex;
+		if (index == 0 && s_Queues.size() > 1)
+			index = 1 + (s_NextQueue.fetch_add(1, std::memory_order_relaxed) % (uint32_t)(s_Queues.size() - 1));
+
+		// Note(Jorben): Counted under the deque's lock, the same one a thief takes to pop & uncount it, so the count
+		// never goes below zero and never counts a job that isn't there yet (which would keep idle workers spinning)
+		{
+			std::scoped_lock<std::mutex> lock(s_Queues[index]->Mutex);
+			s_Queues[index]->Jobs.push_back(job);
+			s_QueuedJobs.fetch_add(1, std::memory_order_release);
+		}
+
+		// Note(Jorben): Taken so a worker can't miss the notify between checking the count & going to sleep
+		{
+			std::scoped_lock<std::mutex> lock(s_WakeMutex);
+		}
+		s_WakeCondition.notify_one();
+	}
+
+	bool JobSystem::TryExecute(uint32_t index)
+	{
+		if (index >= s_Queues.size())
+			return false;
+
+		Ref<JobCounter::Job> job = nullptr;
+
+		// Own deque first (newest job, it's likely still in cache)
+		{
+			std::scoped_lock<std::mutex> lock(s_Queues[index]->Mutex);
+			if (!s_Queues[index]->Jobs.empty())
+			{
+				job = s_Queues[index]->Jobs.back();
+				s_Queues[index]->Jobs.pop_back();
+				s_QueuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+			}
+		}
+
+		// Steal the oldest job from someone else
+		for (size_t i = 1; !job && i < s_Queues.size(); i++)
+		{
+			WorkQueue& victim = *s_Queues[(index + i) % s_Queues.size()];
+
+			std::scoped_lock<std::mutex> lock(victim.Mutex);
+			if (!victim.Jobs.empty())
+			{
+				job = victim.Jobs.front();
+				victim.Jobs.pop_front();
+				s_QueuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+			}
+		}
+
+		if (!job)
+			return false;
+
+		Execute(job);
+		return true;
+	}
+
+	void JobSystem::Execute(Ref<JobCounter::Job> job)
+	{
+		job->Function();
+		Finish(job->Counter);
+	}
+
+	void JobSystem::Finish(const JobHandle& counter)
+	{
+		if (counter->m_Pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+
+		std::vector<Ref<JobCounter::Job>> continuations = { };
+		{
+			std::scoped_lock<std::mutex> lock(counter->m_Mutex);
+			std::swap(continuations, counter->m_Continuations);
+		}
+
+		for (auto& job : continuations)
+		{
+			if (job->Waiting.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				Push(job);
+		}
+	}
+
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+#include "Swift/Core/Core.hpp"
+
+namespace Swift
+{
+
+	typedef std::function<void()> JobFunction;
+	typedef std::function<void(uint32_t first, uint32_t count)> ParallelForFunction;
+
+	enum class JobAffinity : uint8_t
+	{
+		None = 0, Any, MainThread // Note(Jorben): MainThread jobs run in JobSystem::ExecuteMainThreadJobs (or while the main thread waits)
+	};
+
+	// Keeps track of unfinished jobs, jobs depending on it get scheduled once it reaches zero
+	class JobCounter
+	{
+	public:
+		JobCounter(uint32_t pending = 0)
+			: m_Pending(pending)
+		{
+		}
+		virtual ~JobCounter() = default;
+
+		inline bool IsFinished() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+
+	private:
+		struct Job;
+
+		std::atomic<uint32_t> m_Pending = 0;
+
+		std::mutex m_Mutex = {};
+		std::vector<Ref<Job>> m_Continuations = { };
+
+		friend class JobSystem;
+	};
+
+	typedef Ref<JobCounter> JobHandle;
+
+	// A persistent pool of worker threads, every worker owns a deque it pushes to & pops from at the back.
+	// Idle workers steal from the front of the other workers' deques.
+	class JobSystem
+	{
+	public:
+		static void Init(uint32_t workers = 0); // 0 = hardware concurrency - 1, the main thread helps out while waiting
+		static bool Initialized();
+		static void Destroy();
+
+		// Note(Jorben): The job only starts once all its dependencies are finished
+		static JobHandle Schedule(JobFunction function, const std::vector<JobHandle>& dependencies = { }, JobAffinity affinity = JobAffinity::Any);
+		// Splits [0, count) into ranges of batchSize, the returned handle finishes once every range is done
+		static JobHandle ParallelFor(uint32_t count, uint32_t batchSize, ParallelForFunction function, const std::vector<JobHandle>& dependencies = { });
+
+		// Note(Jorben): Waiting threads execute other jobs in the meantime, so waiting from inside a job is fine
+		static void Wait(const JobHandle& handle);
+		static void Wait(const std::vector<JobHandle>& handles);
+
+		// Runs all jobs scheduled with JobAffinity::MainThread, has to be called from the main thread
+		static void ExecuteMainThreadJobs();
+
+		static uint32_t GetWorkerCount();
+		static uint32_t GetThreadIndex(); // 0 = main (or any non worker) thread, workers start at 1
+		static bool IsMainThread();
+
+	private:
+		struct WorkQueue
+		{
+		public:
+			std::mutex Mutex = {};
+			std::deque<Ref<JobCounter::Job>> Jobs = { };
+		};
+
+		static void WorkerLoop(uint32_t index);
+
+		static void Push(Ref<JobCounter::Job> job);
+		static bool TryExecute(uint32_t index);
+		static void Execute(Ref<JobCounter::Job> job);
+		static void Finish(const JobHandle& counter);
+
+	private:
+		static std::vector<std::thread> s_Workers;
+		static std::vector<std::unique_ptr<WorkQueue>> s_Queues; // [0] is used by non worker threads
+		static WorkQueue s_MainThreadQueue;
+
+		static std::mutex s_WakeMutex;
+		static std::condition_variable s_WakeCondition;
+		static std::atomic<uint32_t> s_QueuedJobs;
+		static std::atomic<bool> s_Running;
+		static std::atomic<uint32_t> s_NextQueue;
+
+		static std::thread::id s_MainThread;
+	};
+
+}
@@ -4,6 +4,7 @@
 #include "Swift/Core/Logging.hpp"
 
 #include "Swift/Renderer/Renderer.hpp"
+#include "Swift/Renderer/UploadManager.hpp"
 
 #include <assimp/Importer.hpp>   
 #include <assimp/scene.h>        
@@ -27,20 +28,55 @@ namespace Swift
 		return layout;
 	}
 
-	Mesh::Mesh(const std::filesystem::path& path)
+	Mesh::Mesh(const std::filesystem::path& path, bool async)
 	{
 		std::vector<MeshVertex> vertices = { };
 		std::vector<uint32_t> indices = { };
 
 		LoadModel(path, vertices, indices);
 
-		m_VertexBuffer = VertexBuffer::Create((void*)vertices.data(), sizeof(vertices[0]) * vertices.size());
-		m_IndexBuffer = IndexBuffer::Create(indices.data(), (uint32_t)indices.size());
+		// Note(Jorben): Centered on the bounding box, which is tight enough for culling
+		if (!vertices.empty())
+		{
+			glm::vec3 min = vertices[0].Position;
+			glm::vec3 max = vertices[0].Position;
+			for (auto& vertex : vertices)
+			{
+				min = glm::min(min, vertex.Position);
+				max = glm::max(max, vertex.Position);
+			}
+
+			m_Bounds.Center = (min + max) * 0.5f;
+			for (auto& vertex : vertices)
+				m_Bounds.Radius = std::max(m_Bounds.Radius, glm::length(vertex.Position - m_Bounds.Center));
+		}
+
+		m_Geometry = Renderer::GetGeometryPool()->Allocate((const void*)vertices.data(), (uint32_t)vertices.size(), indices.data(), (uint32_t)indices.size());
+
+		if (!async && m_Geometry.Valid())
+			Renderer::GetUploadManager()->Wait(m_Geometry.Upload);
+	}
+
+	Mesh::~Mesh()
+	{
+		// Note(Jorben): The pool is gone when the last meshes are released after the renderer
+		if (auto pool = Renderer::GetGeometryPool())
+			pool->Free(m_Geometry);
+	}
+
+	bool Mesh::IsReady() const
+	{
+		return m_Geometry.Valid() && Renderer::GetUploadManager()->IsComplete(m_Geometry.Upload);
 	}
 
 	Ref<Mesh> Mesh::Create(const std::filesystem::path& path)
 	{
-		return RefHelper::Create<Mesh>(path);
+		return RefHelper::Create<Mesh>(path, false);
+	}
+
+	Ref<Mesh> Mesh::CreateAsync(const std::filesystem::path& path)
+	{
+		return RefHelper::Create<Mesh>(path, true);
 	}
 
 	static void LoadModel(const std::filesystem::path& path, std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices)
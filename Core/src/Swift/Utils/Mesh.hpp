@@ -8,6 +8,7 @@
 #include <glm/glm.hpp>
 
 #include "Swift/Renderer/Buffers.hpp"
+#include "Swift/Renderer/GeometryPool.hpp"
 
 namespace Swift
 {
@@ -23,22 +24,35 @@ namespace Swift
 		static BufferLayout GetLayout();
 	};
 
+	// In the mesh's local space
+	struct BoundingSphere
+	{
+	public:
+		glm::vec3 Center = { };
+		float Radius = 0.0f;
+	};
+
 	class Mesh
 	{
 	public:
 		Mesh() = default;
-		Mesh(const std::filesystem::path& path);
-		virtual ~Mesh() = default;
+		Mesh(const std::filesystem::path& path, bool async = false);
+		virtual ~Mesh();
+
+		// Where the mesh lives in the renderer's GeometryPool, bind the pool and draw with these offsets
+		inline const GeometryRange& GetGeometry() const { return m_Geometry; }
+		inline const BoundingSphere& GetBounds() const { return m_Bounds; }
 
-		Ref<VertexBuffer>& GetVertexBuffer() { return m_VertexBuffer; }
-		Ref<IndexBuffer>& GetIndexBuffer() { return m_IndexBuffer; }
+		// Whether the vertices & indices have finished uploading
+		bool IsReady() const;
 
 		static Ref<Mesh> Create(const std::filesystem::path& path);
+		// Returns right away, the geometry is uploaded with the next batch of the UploadManager
+		static Ref<Mesh> CreateAsync(const std::filesystem::path& path);
 
 	private:
-		Ref<VertexBuffer> m_VertexBuffer = nullptr;
-		Ref<IndexBuffer> m_IndexBuffer = nullptr;
-
+		GeometryRange m_Geometry = {};
+		BoundingSphere m_Bounds = {};
 	};
 
 }
\ No newline at end of file
@@ -1,28 +1,47 @@
 #include "swpch.h"
 #include "Profiler.hpp"
 
-#if !defined(APP_DIST) && APP_ENABLE_PROFILING && APP_PLATFORM_WINDOWS
+#if !defined(APP_DIST) && APP_ENABLE_PROFILING && defined(TRACY_ENABLE)
 #if APP_MEM_PROFILING
+// Note(Jorben): The secure variants check if the profiler is still alive, allocations
+// made before it starts or after it shuts down (static init/destruction) are ignored.
 void* operator new(size_t size) 
 {
     auto ptr = std::malloc(size);
     if (!ptr) 
         throw std::bad_alloc();
 
-    TracyAlloc(ptr, size);
+    TracySecureAlloc(ptr, size);
     return ptr;
 }
 
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
 void operator delete(void* ptr) noexcept 
 {
-    TracyFree(ptr);
+    if (!ptr)
+        return;
+
+    TracySecureFree(ptr);
     std::free(ptr);
 }
 
+void operator delete[](void* ptr) noexcept
+{
+    operator delete(ptr);
+}
+
 void operator delete(void* ptr, size_t size) noexcept 
 {
-    TracyFree(ptr);
-    std::free(ptr);
+    operator delete(ptr);
+}
+
+void operator delete[](void* ptr, size_t size) noexcept
+{
+    operator delete(ptr);
 }
 #endif
-#endif
\ No newline at end of file
+#endif
@@ -1,31 +1,41 @@
 #pragma once
 
-#ifdef APP_PLATFORM_WINDOWS
 #include <tracy/Tracy.hpp>
 #include <tracy/TracyC.h>
 
 #include <new>
 #include <cstdlib>
 
-// Note(Jorben): Profiling leaks memory, so don't keep on during any real tests. // TODO: Fix
+// Note(Jorben): Tracy is built with TRACY_ON_DEMAND, so nothing is kept in memory until a profiler connects
 #define APP_ENABLE_PROFILING 1
 #define APP_MEM_PROFILING 0
 
-#if !defined(APP_DIST) && APP_ENABLE_PROFILING
+#if !defined(APP_DIST) && APP_ENABLE_PROFILING && defined(TRACY_ENABLE)
 
 #define APP_MARK_FRAME FrameMark
 #define APP_PROFILE_SCOPE(name) ZoneScopedN(name)
+#define APP_PROFILE_THREAD(name) tracy::SetThreadName(name)
+#define APP_PROFILE_PLOT(name, value) TracyPlot(name, value)
+
+// Note(Jorben): GPU zones are emitted by the command buffers' BeginTiming/EndTiming
+#define APP_GPU_PROFILING 1
 
 #if APP_MEM_PROFILING
 void* operator new(size_t size);
+void* operator new[](size_t size);
 void operator delete(void* ptr) noexcept;
+void operator delete[](void* ptr) noexcept;
 void operator delete(void* ptr, size_t size) noexcept;
+void operator delete[](void* ptr, size_t size) noexcept;
 #endif
 
 #else
 
 #define APP_MARK_FRAME
-#define APP_PROFILE_SCOPE
+#define APP_PROFILE_SCOPE(name)
+#define APP_PROFILE_THREAD(name)
+#define APP_PROFILE_PLOT(name, value)
+
+#define APP_GPU_PROFILING 0
 
 #endif
-#endif
\ No newline at end of file
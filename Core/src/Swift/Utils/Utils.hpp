@@ -17,6 +17,8 @@
 
 #include "Swift/Core/Logging.hpp"
 
+#include "Swift/Utils/JobSystem.hpp"
+
 #define BIT(x) (1 << x)
 #define BIT_X(x, y) (x << y)
 
@@ -117,39 +119,53 @@ namespace Swift::Utils
             return func;
         }
 
-        // Note(Jorben): Executing simultaneously clears the queue.
+        // Note(Jorben): Executing simultaneously clears the queue. The queue is swapped out before
+        // running anything, so functions can be added (even from inside the queued functions) while executing.
         template<typename ...Args>
         inline void Execute(ExecutionStyle style = ExecutionStyle::InOrder, Args&& ...args)
         {
-            std::scoped_lock<std::mutex> lock(m_Mutex);
-
             switch (style)
             {
             case ExecutionStyle::InOrder:
             {
-                while (!m_Queue.empty())
+                // Note(Jorben): Functions added while executing are run in the same call
+                while (true)
                 {
-                    Func& func = m_Queue.front();
-                    func(std::forward<Args>(args)...);
-                    m_Queue.pop();
+                    std::queue<Func> queue = { };
+                    {
+                        std::scoped_lock<std::mutex> lock(m_Mutex);
+                        std::swap(queue, m_Queue);
+                    }
+
+                    if (queue.empty())
+                        break;
+
+                    while (!queue.empty())
+                    {
+                        queue.front()(args...);
+                        queue.pop();
+                    }
                 }
                 break;
             }
             case ExecutionStyle::Parallel:
             {
-                std::vector<std::future<void>> futures = { };
-
-                while (!m_Queue.empty()) 
+                std::queue<Func> queue = { };
                 {
-                    Func func = std::move(m_Queue.front());
-                    m_Queue.pop();
-                    futures.emplace_back(std::async(std::launch::async, std::move(func), std::forward<Args>(args)...));
+                    std::scoped_lock<std::mutex> lock(m_Mutex);
+                    std::swap(queue, m_Queue);
                 }
 
-                // Wait
-                for (auto& future : futures)
-                    future.get();
+                std::vector<JobHandle> jobs = { };
+                jobs.reserve(queue.size());
+
+                while (!queue.empty()) 
+                {
+                    jobs.push_back(JobSystem::Schedule([func = std::move(queue.front()), &args...]() mutable { func(args...); }));
+                    queue.pop();
+                }
 
+                JobSystem::Wait(jobs);
                 break;
             }
 
@@ -10,32 +10,33 @@
 #include "Swift/Vulkan/VulkanRenderer.hpp"
 #include "Swift/Vulkan/VulkanCommandBuffer.hpp"
 #include "Swift/Vulkan/VulkanDescriptors.hpp"
+#include "Swift/Vulkan/VulkanUploadManager.hpp"
 
 namespace Swift
 {
 
-	VulkanVertexBuffer::VulkanVertexBuffer(void* data, size_t size)
+	VulkanVertexBuffer::VulkanVertexBuffer(void* data, size_t size, bool async)
 		: m_BufferSize(size)
 	{
 		VulkanAllocator allocator = {};
 
 		m_BufferAllocation = allocator.AllocateBuffer(m_BufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY, m_Buffer);
 
-		VkBuffer stagingBuffer = VK_NULL_HANDLE;
-		VmaAllocation stagingBufferAllocation = VK_NULL_HANDLE;
-		stagingBufferAllocation = allocator.AllocateBuffer(m_BufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY, stagingBuffer);
+		auto uploadManager = RefHelper::RefAs<VulkanUploadManager>(Renderer::GetUploadManager());
+		m_Upload = uploadManager->StageBuffer(m_Buffer, data, m_BufferSize);
+		if (m_Upload.Failed())
+			APP_LOG_ERROR("Failed to stage the vertex buffer's data ({0} bytes), it will never be ready.", m_BufferSize);
 
-		void* mappedData = nullptr;
-		allocator.MapMemory(stagingBufferAllocation, mappedData);
-		memcpy(mappedData, data, m_BufferSize);
-		allocator.UnMapMemory(stagingBufferAllocation);
-
-		allocator.CopyBuffer(stagingBuffer, m_Buffer, m_BufferSize);
-		allocator.DestroyBuffer(stagingBuffer, stagingBufferAllocation);
+		if (!async)
+			uploadManager->Wait(m_Upload);
 	}
 
 	VulkanVertexBuffer::~VulkanVertexBuffer()
 	{
+		// Note(Jorben): The copy can take longer than the frames in flight the free stream waits on
+		if (!IsReady())
+			Renderer::GetUploadManager()->Wait(m_Upload);
+
 		auto buffer = m_Buffer;
 		auto allocation = m_BufferAllocation;
 
@@ -56,9 +57,14 @@ namespace Swift
 		vkCmdBindVertexBuffers(cmdBuf->GetVulkanCommandBuffer(Renderer::GetCurrentFrame()), 0, 1, &m_Buffer, offsets);
 	}
 
+	bool VulkanVertexBuffer::IsReady() const
+	{
+		return !m_Upload || Renderer::GetUploadManager()->IsComplete(m_Upload);
+	}
+
 
 
-	VulkanIndexBuffer::VulkanIndexBuffer(uint32_t* indices, uint32_t count)
+	VulkanIndexBuffer::VulkanIndexBuffer(uint32_t* indices, uint32_t count, bool async)
 		: m_Count(count)
 	{
 		VulkanAllocator allocator = {};
@@ -66,21 +72,20 @@ namespace Swift
 		VkDeviceSize bufferSize = sizeof(uint32_t) * count;
 		m_BufferAllocation = allocator.AllocateBuffer(bufferSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY, m_Buffer);
 
-		VkBuffer stagingBuffer = VK_NULL_HANDLE;
-		VmaAllocation stagingBufferAllocation = VK_NULL_HANDLE;
-		stagingBufferAllocation = allocator.AllocateBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY, stagingBuffer);
+		auto uploadManager = RefHelper::RefAs<VulkanUploadManager>(Renderer::GetUploadManager());
+		m_Upload = uploadManager->StageBuffer(m_Buffer, indices, (size_t)bufferSize);
+		if (m_Upload.Failed())
+			APP_LOG_ERROR("Failed to stage the index buffer's data ({0} bytes), it will never be ready.", (size_t)bufferSize);
 
-		void* mappedData = nullptr;
-		allocator.MapMemory(stagingBufferAllocation, mappedData);
-		memcpy(mappedData, indices, bufferSize);
-		allocator.UnMapMemory(stagingBufferAllocation);
-
-		allocator.CopyBuffer(stagingBuffer, m_Buffer, bufferSize);
-		allocator.DestroyBuffer(stagingBuffer, stagingBufferAllocation);
+		if (!async)
+			uploadManager->Wait(m_Upload);
 	}
 
 	VulkanIndexBuffer::~VulkanIndexBuffer()
 	{
+		if (!IsReady())
+			Renderer::GetUploadManager()->Wait(m_Upload);
+
 		auto buffer = m_Buffer;
 		auto allocation = m_BufferAllocation;
 
@@ -100,6 +105,11 @@ namespace Swift
 		vkCmdBindIndexBuffer(cmdBuf->GetVulkanCommandBuffer(Renderer::GetCurrentFrame()), m_Buffer, 0, VK_INDEX_TYPE_UINT32);
 	}
 
+	bool VulkanIndexBuffer::IsReady() const
+	{
+		return !m_Upload || Renderer::GetUploadManager()->IsComplete(m_Upload);
+	}
+
 
 
 	VulkanUniformBuffer::VulkanUniformBuffer(size_t dataSize)
@@ -108,10 +118,11 @@ namespace Swift
 		uint32_t framesInFlight = (uint32_t)RendererSpecification::BufferCount;
 		m_Buffers.resize((size_t)framesInFlight);
 		m_Allocations.resize((size_t)framesInFlight);
+		m_MappedData.resize((size_t)framesInFlight);
 
 		VulkanAllocator allocator = {};
 		for (size_t i = 0; i < framesInFlight; i++)
-			m_Allocations[i] = allocator.AllocateBuffer((VkDeviceSize)dataSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU, m_Buffers[i]);
+			m_Allocations[i] = allocator.AllocateMappedBuffer((VkDeviceSize)dataSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU, m_Buffers[i], m_MappedData[i]);
 	}
 
 	VulkanUniformBuffer::~VulkanUniformBuffer()
@@ -141,13 +152,10 @@ namespace Swift
 			return;
 		}
 
-		for (size_t i = 0; i < (size_t)RendererSpecification::BufferCount; i++)
-		{
-			void* mappedMemory = nullptr;
-			VulkanAllocator::MapMemory(m_Allocations[i], mappedMemory);
-			memcpy(static_cast<uint8_t*>(mappedMemory) + offset, data, size);
-			VulkanAllocator::UnMapMemory(m_Allocations[i]);
-		}
+		// Note(Jorben): Only the copy of the current frame is written, the other copies might still be in use by the GPU
+		uint32_t frame = Renderer::GetCurrentFrame();
+		memcpy(static_cast<uint8_t*>(m_MappedData[frame]) + offset, data, size);
+		VulkanAllocator::FlushMemory(m_Allocations[frame], (VkDeviceSize)offset, (VkDeviceSize)size);
 	}
 
 	void VulkanUniformBuffer::Upload(Ref<DescriptorSet> set, Descriptor element)
@@ -163,16 +171,7 @@ namespace Swift
 			bufferInfo.offset = 0;
 			bufferInfo.range = m_Size;
 
-			VkWriteDescriptorSet descriptorWrite = {};
-			descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			descriptorWrite.dstSet = vkSet->GetVulkanSet((uint32_t)i);
-			descriptorWrite.dstBinding = element.Binding;
-			descriptorWrite.dstArrayElement = 0;
-			descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			descriptorWrite.descriptorCount = element.Count;
-			descriptorWrite.pBufferInfo = &bufferInfo;
-
-			vkUpdateDescriptorSets(((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice(), 1, &descriptorWrite, 0, nullptr);
+			vkSet->Write((uint32_t)i, element.Binding, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, element.Count, bufferInfo);
 		}
 	}
 
@@ -187,10 +186,11 @@ namespace Swift
 		uint32_t framesInFlight = (uint32_t)RendererSpecification::BufferCount;
 		m_Buffers.resize((size_t)framesInFlight);
 		m_Allocations.resize((size_t)framesInFlight);
+		m_MappedData.resize((size_t)framesInFlight);
 
 		VulkanAllocator allocator = {};
 		for (size_t i = 0; i < framesInFlight; i++)
-			m_Allocations[i] = allocator.AllocateBuffer((VkDeviceSize)(m_ElementCount * m_AlignmentOfOneElement), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU, m_Buffers[i]);
+			m_Allocations[i] = allocator.AllocateMappedBuffer((VkDeviceSize)(m_ElementCount * m_AlignmentOfOneElement), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU, m_Buffers[i], m_MappedData[i]);
 
 		m_IndexedData.resize((size_t)elements);
 	}
@@ -222,13 +222,9 @@ namespace Swift
 			return;
 		}
 
-		for (size_t i = 0; i < (size_t)RendererSpecification::BufferCount; i++)
-		{
-			void* mappedMemory = nullptr;
-			VulkanAllocator::MapMemory(m_Allocations[i], mappedMemory);
-			memcpy(mappedMemory, data, size);
-			VulkanAllocator::UnMapMemory(m_Allocations[i]);
-		}
+		uint32_t frame = Renderer::GetCurrentFrame();
+		memcpy(m_MappedData[frame], data, size);
+		VulkanAllocator::FlushMemory(m_Allocations[frame], 0, (VkDeviceSize)size);
 	}
 
 	void VulkanDynamicUniformBuffer::SetDataIndexed(uint32_t index, void* data, size_t size)
@@ -240,22 +236,19 @@ namespace Swift
 	{
 		APP_PROFILE_SCOPE("VulkanDynamicUniformBuffer::UploadIndexedData");
 
-		for (size_t i = 0; i < (size_t)RendererSpecification::BufferCount; i++)
-		{
-			void* mappedMemory = nullptr;
-			VulkanAllocator::MapMemory(m_Allocations[i], mappedMemory);
+		uint32_t frame = Renderer::GetCurrentFrame();
+		void* mappedMemory = m_MappedData[frame];
 
-			for (size_t j = 0; j < m_IndexedData.size(); j++)
-			{
-				void* srcData = m_IndexedData[j].first;
-				size_t srcSize = m_IndexedData[j].second;
-				size_t copySize = std::min(srcSize, m_AlignmentOfOneElement); // Ensure not to copy more than the aligned size
-				memcpy(static_cast<char*>(mappedMemory) + j * m_AlignmentOfOneElement, srcData, copySize);
-			}
-
-			VulkanAllocator::UnMapMemory(m_Allocations[i]);
+		for (size_t j = 0; j < m_IndexedData.size(); j++)
+		{
+			void* srcData = m_IndexedData[j].first;
+			size_t srcSize = m_IndexedData[j].second;
+			size_t copySize = std::min(srcSize, m_AlignmentOfOneElement); // Ensure not to copy more than the aligned size
+			memcpy(static_cast<char*>(mappedMemory) + j * m_AlignmentOfOneElement, srcData, copySize);
 		}
 
+		VulkanAllocator::FlushMemory(m_Allocations[frame], 0, (VkDeviceSize)(m_IndexedData.size() * m_AlignmentOfOneElement));
+
 		m_IndexedData.clear();
 		m_IndexedData.resize(m_ElementCount);
 	}
@@ -273,16 +266,7 @@ namespace Swift
 			bufferInfo.offset = 0;
 			bufferInfo.range = m_ElementCount * m_AlignmentOfOneElement;
 
-			VkWriteDescriptorSet descriptorWrite = {};
-			descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			descriptorWrite.dstSet = vkSet->GetVulkanSet((uint32_t)i);
-			descriptorWrite.dstBinding = element.Binding;
-			descriptorWrite.dstArrayElement = 0;
-			descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-			descriptorWrite.descriptorCount = element.Count;
-			descriptorWrite.pBufferInfo = &bufferInfo;
-
-			vkUpdateDescriptorSets(((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice(), 1, &descriptorWrite, 0, nullptr);
+			vkSet->Write((uint32_t)i, element.Binding, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, element.Count, bufferInfo);
 		}
 	}
 
@@ -299,34 +283,103 @@ namespace Swift
 			bufferInfo.offset = offset;
 			bufferInfo.range = m_AlignmentOfOneElement;
 
-			VkWriteDescriptorSet descriptorWrite = {};
-			descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			descriptorWrite.dstSet = vkSet->GetVulkanSet((uint32_t)i);
-			descriptorWrite.dstBinding = element.Binding;
-			descriptorWrite.dstArrayElement = 0;
-			descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-			descriptorWrite.descriptorCount = element.Count;
-			descriptorWrite.pBufferInfo = &bufferInfo;
-
-			vkUpdateDescriptorSets(((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice(), 1, &descriptorWrite, 0, nullptr);
+			vkSet->Write((uint32_t)i, element.Binding, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, element.Count, bufferInfo);
 		}
 	}
 
 
 
 	VulkanStorageBuffer::VulkanStorageBuffer(size_t dataSize)
-		: m_Size(dataSize)
 	{
+		Create(dataSize);
+	}
+
+	VulkanStorageBuffer::~VulkanStorageBuffer()
+	{
+		Destroy();
+	}
+
+	void VulkanStorageBuffer::SetData(void* data, size_t size, size_t offset)
+	{
+		APP_PROFILE_SCOPE("VulkanStorageBuffer::SetData");
+
+		if (size + offset > m_Size)
+		{
+			APP_ASSERT(false, "Data exceeds buffer size in SetData()");
+			return;
+		}
+
+		// Note(Jorben): Only the copy of the current frame is written, the other copies might still be in use by the GPU
+		uint32_t frame = Renderer::GetCurrentFrame();
+		memcpy(static_cast<uint8_t*>(m_MappedData[frame]) + offset, data, size);
+		VulkanAllocator::FlushMemory(m_Allocations[frame], (VkDeviceSize)offset, (VkDeviceSize)size);
+	}
+
+	void VulkanStorageBuffer::Resize(size_t dataSize)
+	{
+		APP_PROFILE_SCOPE("VulkanStorageBuffer::Resize");
+
+		Destroy();
+		Create(dataSize);
+	}
+
+	void* VulkanStorageBuffer::StartRetrieval()
+	{
+		uint32_t frame = Renderer::GetCurrentFrame();
+		VulkanAllocator::InvalidateMemory(m_Allocations[frame], 0, (VkDeviceSize)m_Size);
+
+		return m_MappedData[frame];
+	}
+
+	void VulkanStorageBuffer::EndRetrieval()
+	{
+		// Note(Jorben): The memory is persistently mapped, so there is nothing to unmap
+	}
+
+	void VulkanStorageBuffer::Upload(Ref<DescriptorSet> set, Descriptor element)
+	{
+		APP_PROFILE_SCOPE("VulkanStorageBuffer::Upload");
+
+		auto vkSet = RefHelper::RefAs<VulkanDescriptorSet>(set);
+
+		for (size_t i = 0; i < (size_t)RendererSpecification::BufferCount; i++)
+		{
+			VkDescriptorBufferInfo bufferInfo = {};
+			bufferInfo.buffer = m_Buffers[i];
+			bufferInfo.offset = 0;
+			bufferInfo.range = m_Size;
+
+			vkSet->Write((uint32_t)i, element.Binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, element.Count, bufferInfo);
+		}
+	}
+
+	void VulkanStorageBuffer::Release(Ref<CommandBuffer> commandBuffer, Queue from, Queue to)
+	{
+		APP_PROFILE_SCOPE("VulkanStorageBuffer::Release");
+		TransferOwnership(commandBuffer, from, to, false);
+	}
+
+	void VulkanStorageBuffer::Acquire(Ref<CommandBuffer> commandBuffer, Queue from, Queue to)
+	{
+		APP_PROFILE_SCOPE("VulkanStorageBuffer::Acquire");
+		TransferOwnership(commandBuffer, from, to, true);
+	}
+
+	void VulkanStorageBuffer::Create(size_t dataSize)
+	{
+		m_Size = dataSize;
+
 		uint32_t framesInFlight = (uint32_t)RendererSpecification::BufferCount;
 		m_Buffers.resize((size_t)framesInFlight);
 		m_Allocations.resize((size_t)framesInFlight);
+		m_MappedData.resize((size_t)framesInFlight);
 
 		VulkanAllocator allocator = {};
 		for (size_t i = 0; i < framesInFlight; i++)
-			m_Allocations[i] = allocator.AllocateBuffer((VkDeviceSize)dataSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU, m_Buffers[i], VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+			m_Allocations[i] = allocator.AllocateMappedBuffer((VkDeviceSize)dataSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU, m_Buffers[i], m_MappedData[i], VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
 	}
 
-	VulkanStorageBuffer::~VulkanStorageBuffer()
+	void VulkanStorageBuffer::Destroy()
 	{
 		auto buffers = m_Buffers;
 		auto allocations = m_Allocations;
@@ -343,41 +396,73 @@ namespace Swift
 		});
 	}
 
-	void VulkanStorageBuffer::SetData(void* data, size_t size, size_t offset)
+	void VulkanStorageBuffer::TransferOwnership(Ref<CommandBuffer> commandBuffer, Queue from, Queue to, bool acquire)
 	{
-		APP_PROFILE_SCOPE("VulkanStorageBuffer::SetData");
+		auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice();
 
-		if (size + offset > m_Size)
-		{
-			APP_ASSERT(false, "Data exceeds buffer size in SetData()");
+		// Note(Jorben): Within a family the semaphore between the submissions already covers it
+		uint32_t srcFamily = device->GetQueueFamily(from);
+		uint32_t dstFamily = device->GetQueueFamily(to);
+		if (srcFamily == dstFamily)
 			return;
-		}
 
-		for (size_t i = 0; i < (size_t)RendererSpecification::BufferCount; i++)
+		VkPipelineStageFlags stage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		if ((acquire ? to : from) == Queue::Graphics)
+			stage = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+		auto vkCmd = RefHelper::RefAs<VulkanCommandBuffer>(commandBuffer);
+		uint32_t frame = Renderer::GetCurrentFrame();
+		VulkanAllocator::TransferBufferOwnership(vkCmd->GetVulkanCommandBuffer(frame), m_Buffers[frame], srcFamily, dstFamily, acquire, stage, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+	}
+
+	static_assert(sizeof(IndexedIndirectCommand) == sizeof(VkDrawIndexedIndirectCommand), "IndexedIndirectCommand doesn't match VkDrawIndexedIndirectCommand.");
+
+	VulkanIndirectBuffer::VulkanIndirectBuffer(uint32_t maxCommands)
+	{
+		Create(maxCommands);
+	}
+
+	VulkanIndirectBuffer::~VulkanIndirectBuffer()
+	{
+		Destroy();
+	}
+
+	void VulkanIndirectBuffer::SetCommands(const IndexedIndirectCommand* commands, uint32_t count, uint32_t first)
+	{
+		APP_PROFILE_SCOPE("VulkanIndirectBuffer::SetCommands");
+
+		if (first + count > m_MaxCommands)
 		{
-			void* mappedMemory = nullptr;
-			VulkanAllocator::MapMemory(m_Allocations[i], mappedMemory);
-			memcpy(static_cast<uint8_t*>(mappedMemory) + offset, data, size);
-			VulkanAllocator::UnMapMemory(m_Allocations[i]);
+			APP_ASSERT(false, "Commands exceed buffer size in SetCommands()");
+			return;
 		}
+
+		uint32_t frame = Renderer::GetCurrentFrame();
+		size_t offset = CommandOffset + sizeof(IndexedIndirectCommand) * first;
+		size_t size = sizeof(IndexedIndirectCommand) * count;
+
+		memcpy(static_cast<uint8_t*>(m_MappedData[frame]) + offset, commands, size);
+		VulkanAllocator::FlushMemory(m_Allocations[frame], (VkDeviceSize)offset, (VkDeviceSize)size);
 	}
 
-	void* VulkanStorageBuffer::StartRetrieval()
+	void VulkanIndirectBuffer::SetCount(uint32_t count)
 	{
-		void* mappedMemory = nullptr;
-		VulkanAllocator::MapMemory(m_Allocations[Renderer::GetCurrentFrame()], mappedMemory);
-
-		return mappedMemory;
+		uint32_t frame = Renderer::GetCurrentFrame();
+		memcpy(m_MappedData[frame], &count, sizeof(uint32_t));
+		VulkanAllocator::FlushMemory(m_Allocations[frame], 0, (VkDeviceSize)sizeof(uint32_t));
 	}
 
-	void VulkanStorageBuffer::EndRetrieval()
+	void VulkanIndirectBuffer::Resize(uint32_t maxCommands)
 	{
-		VulkanAllocator::UnMapMemory(m_Allocations[Renderer::GetCurrentFrame()]);
+		APP_PROFILE_SCOPE("VulkanIndirectBuffer::Resize");
+
+		Destroy();
+		Create(maxCommands);
 	}
 
-	void VulkanStorageBuffer::Upload(Ref<DescriptorSet> set, Descriptor element)
+	void VulkanIndirectBuffer::Upload(Ref<DescriptorSet> set, Descriptor element)
 	{
-		APP_PROFILE_SCOPE("VulkanStorageBuffer::Upload");
+		APP_PROFILE_SCOPE("VulkanIndirectBuffer::Upload");
 
 		auto vkSet = RefHelper::RefAs<VulkanDescriptorSet>(set);
 
@@ -388,17 +473,40 @@ namespace Swift
 			bufferInfo.offset = 0;
 			bufferInfo.range = m_Size;
 
-			VkWriteDescriptorSet descriptorWrite = {};
-			descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			descriptorWrite.dstSet = vkSet->GetVulkanSet((uint32_t)i);
-			descriptorWrite.dstBinding = element.Binding;
-			descriptorWrite.dstArrayElement = 0;
-			descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-			descriptorWrite.descriptorCount = element.Count;
-			descriptorWrite.pBufferInfo = &bufferInfo;
-
-			vkUpdateDescriptorSets(((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice(), 1, &descriptorWrite, 0, nullptr);
+			vkSet->Write((uint32_t)i, element.Binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, element.Count, bufferInfo);
 		}
 	}
 
+	void VulkanIndirectBuffer::Create(uint32_t maxCommands)
+	{
+		m_MaxCommands = maxCommands;
+		m_Size = CommandOffset + sizeof(IndexedIndirectCommand) * maxCommands;
+
+		uint32_t framesInFlight = (uint32_t)RendererSpecification::BufferCount;
+		m_Buffers.resize((size_t)framesInFlight);
+		m_Allocations.resize((size_t)framesInFlight);
+		m_MappedData.resize((size_t)framesInFlight);
+
+		VulkanAllocator allocator = {};
+		for (size_t i = 0; i < framesInFlight; i++)
+			m_Allocations[i] = allocator.AllocateMappedBuffer((VkDeviceSize)m_Size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU, m_Buffers[i], m_MappedData[i]);
+	}
+
+	void VulkanIndirectBuffer::Destroy()
+	{
+		auto buffers = m_Buffers;
+		auto allocations = m_Allocations;
+
+		Renderer::SubmitFree([buffers, allocations]()
+		{
+			for (size_t i = 0; i < (size_t)RendererSpecification::BufferCount; i++)
+			{
+				VulkanAllocator allocator = {};
+
+				if (buffers[i] != VK_NULL_HANDLE)
+					allocator.DestroyBuffer(buffers[i], allocations[i]);
+			}
+		});
+	}
+
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 
 #include "Swift/Renderer/Buffers.hpp"
 #include "Swift/Renderer/Descriptors.hpp"
+#include "Swift/Renderer/UploadManager.hpp"
 
 #include <vulkan/vulkan.h>
 #include <vk_mem_alloc.h>
@@ -17,33 +18,39 @@ namespace Swift
 	class VulkanVertexBuffer : public VertexBuffer
 	{
 	public:
-		VulkanVertexBuffer(void* data, size_t size);
+		VulkanVertexBuffer(void* data, size_t size, bool async);
 		virtual ~VulkanVertexBuffer();
 
 		void Bind(Ref<CommandBuffer> commandBuffer) override;
 
+		bool IsReady() const override;
+
 	private:
 		VkBuffer m_Buffer = VK_NULL_HANDLE;
 		VmaAllocation m_BufferAllocation = VK_NULL_HANDLE;
 
 		size_t m_BufferSize = 0;
+		UploadPoint m_Upload = {};
 	};
 
 	class VulkanIndexBuffer : public IndexBuffer
 	{
 	public:
-		VulkanIndexBuffer(uint32_t* indices, uint32_t count);
+		VulkanIndexBuffer(uint32_t* indices, uint32_t count, bool async);
 		virtual ~VulkanIndexBuffer();
 
 		void Bind(Ref<CommandBuffer> commandBuffer) const;
 
 		inline uint32_t GetCount() const override { return m_Count; }
 
+		bool IsReady() const override;
+
 	private:
 		VkBuffer m_Buffer = VK_NULL_HANDLE;
 		VmaAllocation m_BufferAllocation = VK_NULL_HANDLE;
 
 		uint32_t m_Count = 0;
+		UploadPoint m_Upload = {};
 	};
 
 	class VulkanUniformBuffer : public UniformBuffer
@@ -59,6 +66,7 @@ namespace Swift
 	private:
 		std::vector<VkBuffer> m_Buffers = { };
 		std::vector<VmaAllocation> m_Allocations = { };
+		std::vector<void*> m_MappedData = { };
 
 		size_t m_Size = 0;
 	};
@@ -83,6 +91,7 @@ namespace Swift
 	private:
 		std::vector<VkBuffer> m_Buffers = { };
 		std::vector<VmaAllocation> m_Allocations = { };
+		std::vector<void*> m_MappedData = { };
 
 		uint32_t m_ElementCount = 0;
 		size_t m_SizeOfOneElement = 0;
@@ -99,6 +108,8 @@ namespace Swift
 
 		void SetData(void* data, size_t size, size_t offset) override;
 
+		void Resize(size_t dataSize) override;
+
 		void* StartRetrieval() override;
 		void EndRetrieval() override;
 
@@ -106,11 +117,50 @@ namespace Swift
 
 		void Upload(Ref<DescriptorSet> set, Descriptor element) override;
 
+		void Release(Ref<CommandBuffer> commandBuffer, Queue from, Queue to) override;
+		void Acquire(Ref<CommandBuffer> commandBuffer, Queue from, Queue to) override;
+
+	private:
+		std::vector<VkBuffer> m_Buffers = { };
+		std::vector<VmaAllocation> m_Allocations = { };
+		std::vector<void*> m_MappedData = { };
+
+		size_t m_Size = 0;
+
+	private:
+		void Create(size_t dataSize);
+		void Destroy();
+
+		void TransferOwnership(Ref<CommandBuffer> commandBuffer, Queue from, Queue to, bool acquire);
+	};
+
+	class VulkanIndirectBuffer : public IndirectBuffer
+	{
+	public:
+		VulkanIndirectBuffer(uint32_t maxCommands);
+		virtual ~VulkanIndirectBuffer();
+
+		void SetCommands(const IndexedIndirectCommand* commands, uint32_t count, uint32_t first) override;
+		void SetCount(uint32_t count) override;
+
+		void Resize(uint32_t maxCommands) override;
+		inline uint32_t GetMaxCommands() const override { return m_MaxCommands; }
+
+		void Upload(Ref<DescriptorSet> set, Descriptor element) override;
+
+		inline VkBuffer GetVulkanBuffer(uint32_t frame) const { return m_Buffers[frame]; }
+
 	private:
 		std::vector<VkBuffer> m_Buffers = { };
 		std::vector<VmaAllocation> m_Allocations = { };
+		std::vector<void*> m_MappedData = { };
 
+		uint32_t m_MaxCommands = 0;
 		size_t m_Size = 0;
+
+	private:
+		void Create(uint32_t maxCommands);
+		void Destroy();
 	};
 
 }
\ No newline at end of file
@@ -17,7 +17,7 @@ namespace Swift
 		: m_Specification(specs)
 	{
 		// Check if specs are set properly
-		if (!(m_Specification.Usage & CommandBufferUsage::Sequence) && !(m_Specification.Usage & CommandBufferUsage::Parallel))
+		if (!(m_Specification.Usage & CommandBufferUsage::Sequence) && !(m_Specification.Usage & CommandBufferUsage::Parallel) && !(m_Specification.Usage & CommandBufferUsage::Secondary))
 		{
 			APP_ASSERT(false, "No proper flags set.");
 			return;
@@ -28,67 +28,67 @@ namespace Swift
 		constexpr const uint32_t framesInFlight = (uint32_t)RendererSpecification::BufferCount;
 		m_CommandBuffers.resize(framesInFlight);
 
+		// Note(Jorben): Secondary command buffers come from their thread's pool of every frame and don't need any sync objects
+		if (m_Specification.Usage & CommandBufferUsage::Secondary)
+		{
+			APP_ASSERT((m_Specification.Thread < RendererSpecification::RecordingThreads), "Invalid recording thread selected.");
+
+			for (uint32_t i = 0; i < framesInFlight; i++)
+			{
+				VkCommandBufferAllocateInfo allocInfo = {};
+				allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+				allocInfo.commandPool = renderer->GetSwapChain()->GetThreadCommandPool(i, m_Specification.Thread);
+				allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+				allocInfo.commandBufferCount = 1;
+
+				if (vkAllocateCommandBuffers(device, &allocInfo, &m_CommandBuffers[i]) != VK_SUCCESS)
+					APP_LOG_ERROR("Failed to allocate secondary command buffers!");
+			}
+
+			return;
+		}
+
 		VkCommandBufferAllocateInfo allocInfo = {};
 		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-		allocInfo.commandPool = renderer->GetSwapChain()->GetCommandPool();
+		allocInfo.commandPool = renderer->GetSwapChain()->GetCommandPool(m_Specification.SubmitQueue);
 		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
 		allocInfo.commandBufferCount = (uint32_t)m_CommandBuffers.size();
 
 		if (vkAllocateCommandBuffers(device, &allocInfo, m_CommandBuffers.data()) != VK_SUCCESS)
 			APP_LOG_ERROR("Failed to allocate command buffers!");
 
-		m_RenderFinishedSemaphores.resize(framesInFlight);
-		m_InFlightFences.resize(framesInFlight);
-
-		VkSemaphoreCreateInfo semaphoreInfo = {};
-		semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-
-		VkFenceCreateInfo fenceInfo = {};
-		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-		fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
-		for (size_t i = 0; i < framesInFlight; i++)
-		{
-			if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &m_RenderFinishedSemaphores[i]) != VK_SUCCESS ||
-				vkCreateFence(device, &fenceInfo, nullptr, &m_InFlightFences[i]) != VK_SUCCESS)
-			{
-				APP_LOG_ERROR("Failed to create synchronization objects for a frame!");
-			}
-		}
+		m_Signals.resize(framesInFlight);
 	}
 
 	VulkanCommandBuffer::~VulkanCommandBuffer()
 	{
 		auto commandBuffers = m_CommandBuffers;
-		auto renderFinishedSemaphores = m_RenderFinishedSemaphores;
-		auto inFlightFences = m_InFlightFences;
+		auto specification = m_Specification;
 
-		Renderer::SubmitFree([commandBuffers, renderFinishedSemaphores, inFlightFences]()
+		Renderer::SubmitFree([commandBuffers, specification]()
 		{
 			auto renderer = (VulkanRenderer*)Renderer::GetInstance();
 			auto device = renderer->GetLogicalDevice()->GetVulkanDevice();
 
-			vkDeviceWaitIdle(device);
-
 			constexpr const uint32_t framesInFlight = (uint32_t)RendererSpecification::BufferCount;
-			vkFreeCommandBuffers(device, renderer->GetSwapChain()->GetCommandPool(), framesInFlight, commandBuffers.data());
-
-			for (size_t i = 0; i < (size_t)framesInFlight; i++)
+			if (specification.Usage & CommandBufferUsage::Secondary)
 			{
-				vkDestroySemaphore(device, renderFinishedSemaphores[i], nullptr);
-				vkDestroyFence(device, inFlightFences[i], nullptr);
+				for (uint32_t i = 0; i < framesInFlight; i++)
+					vkFreeCommandBuffers(device, renderer->GetSwapChain()->GetThreadCommandPool(i, specification.Thread), 1, &commandBuffers[i]);
+
+				return;
 			}
+
+			vkFreeCommandBuffers(device, renderer->GetSwapChain()->GetCommandPool(specification.SubmitQueue), framesInFlight, commandBuffers.data());
 		});
 	}
 
 	void VulkanCommandBuffer::Begin()
 	{
-		auto renderer = (VulkanRenderer*)Renderer::GetInstance();
-		auto device = renderer->GetLogicalDevice()->GetVulkanDevice();
-		uint32_t currentFrame = Renderer::GetCurrentFrame();
-		VkCommandBuffer commandBuffer = m_CommandBuffers[currentFrame];
+		APP_ASSERT(!(m_Specification.Usage & CommandBufferUsage::Secondary), "Secondary command buffers have to be started with BeginSecondary.");
 
-		vkResetFences(device, 1, &m_InFlightFences[currentFrame]);
+		// Note(Jorben): The previous submission of this frame index is done, BeginFrame waited on the whole frame
+		VkCommandBuffer commandBuffer = m_CommandBuffers[Renderer::GetCurrentFrame()];
 		vkResetCommandBuffer(commandBuffer, 0);
 
 		VkCommandBufferBeginInfo beginInfo = {};
@@ -98,98 +98,183 @@ namespace Swift
 			if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
 				APP_LOG_ERROR("Failed to begin recording command buffer!");
 		}
+
+		// Note(Jorben): Sequence command buffers on the same queue end up in one batch without a semaphore in between,
+		// the passes order their own inputs with Barrier() so unrelated passes can still overlap
+		m_Recording = true;
+	}
+
+	void VulkanCommandBuffer::Barrier(PipelineAccess written, PipelineAccess read)
+	{
+		APP_ASSERT(m_Recording, "Barrier has to be recorded between Begin() and End().");
+		APP_ASSERT(!(m_Specification.Usage & CommandBufferUsage::Secondary), "Barriers can't be recorded inside a render pass.");
+
+		VkMemoryBarrier barrier = {};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = GetVulkanAccessFromPipelineAccess(written);
+		barrier.dstAccessMask = GetVulkanAccessFromPipelineAccess(read);
+
+		vkCmdPipelineBarrier(m_CommandBuffers[Renderer::GetCurrentFrame()], GetVulkanStagesFromPipelineAccess(written), GetVulkanStagesFromPipelineAccess(read), 0, 1, &barrier, 0, nullptr, 0, nullptr);
+	}
+
+	void VulkanCommandBuffer::BeginSecondary(VkRenderPass renderPass, VkFramebuffer framebuffer, VkExtent2D extent)
+	{
+		APP_ASSERT((m_Specification.Usage & CommandBufferUsage::Secondary), "BeginSecondary called on a primary command buffer.");
+
+		// Note(Jorben): No reset here, the thread's pool is reset as a whole in BeginFrame
+		VkCommandBuffer commandBuffer = m_CommandBuffers[Renderer::GetCurrentFrame()];
+
+		VkCommandBufferInheritanceInfo inheritanceInfo = {};
+		inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritanceInfo.renderPass = renderPass;
+		inheritanceInfo.subpass = 0;
+		inheritanceInfo.framebuffer = framebuffer;
+
+		VkCommandBufferBeginInfo beginInfo = {};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+		if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
+			APP_LOG_ERROR("Failed to begin recording secondary command buffer!");
+
+		// Note(Jorben): Dynamic state isn't inherited from the primary command buffer
+		VkViewport viewport = {};
+		viewport.x = 0.0f;
+		viewport.y = 0.0f;
+		viewport.width = (float)extent.width;
+		viewport.height = (float)extent.height;
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+		VkRect2D scissor = {};
+		scissor.offset = { 0, 0 };
+		scissor.extent = extent;
+		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+		m_Recording = true;
 	}
 
 	void VulkanCommandBuffer::End()
 	{
 		APP_PROFILE_SCOPE("VulkanCommandBuffer::End::End");
+		APP_ASSERT(m_OpenTimings.empty(), "Ended a command buffer with timing scopes still open.");
 
 		if (vkEndCommandBuffer(m_CommandBuffers[Renderer::GetCurrentFrame()]) != VK_SUCCESS)
 			APP_LOG_ERROR("Failed to record command buffer!");
+
+		m_Recording = false;
 	}
 
 	void VulkanCommandBuffer::Submit(Queue queue, const std::vector<Ref<CommandBuffer>>& waitOn)
 	{
-		auto renderer = (VulkanRenderer*)Renderer::GetInstance();
-		VkDevice device = renderer->GetLogicalDevice()->GetVulkanDevice();
+		if (m_Specification.Usage & CommandBufferUsage::Secondary)
+		{
+			APP_LOG_ERROR("Secondary command buffers can't be submitted, they're executed by their render pass.");
+			return;
+		}
+
+		if (queue != Queue::Graphics && queue != Queue::Compute)
+		{
+			APP_LOG_ERROR("Invalid queue selected.");
+			return;
+		}
+		if (queue != m_Specification.SubmitQueue)
+		{
+			APP_LOG_ERROR("Command buffer submitted to another queue than its CommandBufferSpecification::SubmitQueue.");
+			return;
+		}
 
 		uint32_t currentFrame = Renderer::GetCurrentFrame();
-		VkCommandBuffer commandBuffer = m_CommandBuffers[currentFrame];
+		bool sequence = (bool)(m_Specification.Usage & CommandBufferUsage::Sequence);
 
-		VkSubmitInfo submitInfo = {};
-		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		// Note(Jorben): Every dependency and the previous sequence submission
+		APP_ASSERT((waitOn.size() + 1 <= VulkanTaskManager::MaxWaits), "Too many dependencies for a single submission.");
 
-		std::vector<VkSemaphore> semaphores = { };
+		std::array<TimelinePoint, VulkanTaskManager::MaxWaits> waits = { };
+		uint32_t waitCount = 0;
 
-		for (auto& cmd : waitOn)
+		// Only work on another queue needs a semaphore, sequence command buffers already wait on everything before them on their own queue
+		auto addWait = [&](TimelinePoint point)
 		{
-			auto vkCmd = RefHelper::RefAs<VulkanCommandBuffer>(cmd);
-			auto semaphore = vkCmd->GetRenderFinishedSemaphore(currentFrame);
+			if (!point || (sequence && point.Target == queue))
+				return;
 
-			semaphores.push_back(semaphore);
-			if (VulkanTaskManager::HasSemaphore(semaphore))
-				VulkanTaskManager::RemoveSemaphore(semaphore);
-		}
+			waits[waitCount++] = point;
+		};
 
-		if (m_Specification.Usage & CommandBufferUsage::Sequence)
-		{
-			// Check if it's not nullptr
-			if (VulkanTaskManager::GetFirstSempahore())
-				semaphores.push_back(VulkanTaskManager::GetFirstSempahore());
-		}
+		for (auto& cmd : waitOn)
+			addWait(RefHelper::RefAs<VulkanCommandBuffer>(cmd)->GetSignal(currentFrame));
 
-		std::vector<VkPipelineStageFlags> waitStages(semaphores.size(), VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+		if (sequence)
+			addWait(VulkanTaskManager::GetLastSequence());
 
-		submitInfo.waitSemaphoreCount = (uint32_t)semaphores.size();
-		submitInfo.pWaitSemaphores = semaphores.data();
-		submitInfo.pWaitDstStageMask = waitStages.data();
+		TimelinePoint signal = VulkanTaskManager::Enqueue(queue, m_CommandBuffers[currentFrame], waits.data(), waitCount);
 
-		submitInfo.commandBufferCount = 1;
-		submitInfo.pCommandBuffers = &commandBuffer;
-		submitInfo.signalSemaphoreCount = 1;
-		submitInfo.pSignalSemaphores = &m_RenderFinishedSemaphores[currentFrame];
+		m_Signals[currentFrame] = signal;
+		if (sequence)
+			VulkanTaskManager::SetLastSequence(signal);
+	}
 
-		{
-			APP_PROFILE_SCOPE("VulkanCommandBuffer::Submit::Queue");
+	void VulkanCommandBuffer::WaitOnFinish()
+	{
+		if (m_Specification.Usage & CommandBufferUsage::Secondary)
+			return;
 
-			VkResult result = VK_SUCCESS;
-			
-			switch (queue)
-			{
-			case Queue::Graphics:
-				vkQueueSubmit(renderer->GetLogicalDevice()->GetGraphicsQueue(), 1, &submitInfo, m_InFlightFences[currentFrame]);
-				break;
-			case Queue::Compute:
-				vkQueueSubmit(renderer->GetLogicalDevice()->GetComputeQueue(), 1, &submitInfo, m_InFlightFences[currentFrame]);
-				break;
-
-			default:
-				APP_LOG_ERROR("Invalid queue selected.");
-				break;
-			}
-			
-			if (result != VK_SUCCESS)
-				APP_LOG_ERROR("Failed to submit draw command buffer! Error: {0}", VkResultToString(result));
-		}
+		VulkanTaskManager::Wait(m_Signals[Renderer::GetCurrentFrame()]);
+	}
 
-		if (m_Specification.Usage & CommandBufferUsage::Sequence)
-			VulkanTaskManager::AddSemaphore(m_RenderFinishedSemaphores[currentFrame]);
-		if (m_Specification.Usage & CommandBufferUsage::Parallel)
-			VulkanTaskManager::AddFrameSemaphore(m_RenderFinishedSemaphores[currentFrame]);
+	void VulkanCommandBuffer::BeginTiming(const std::string& name, TimingFlags flags)
+	{
+		auto renderer = (VulkanRenderer*)Renderer::GetInstance();
 
-		VulkanTaskManager::AddFence(m_InFlightFences[currentFrame]);
+		uint32_t scope = renderer->GetQueryManager()->Begin(m_CommandBuffers[Renderer::GetCurrentFrame()], m_Specification.SubmitQueue, name, flags, (uint32_t)m_OpenTimings.size());
+		m_OpenTimings.push_back(scope);
 	}
 
-	void VulkanCommandBuffer::WaitOnFinish()
+	void VulkanCommandBuffer::EndTiming()
 	{
+		if (m_OpenTimings.empty())
+		{
+			APP_LOG_ERROR("EndTiming called without a matching BeginTiming.");
+			return;
+		}
+
 		auto renderer = (VulkanRenderer*)Renderer::GetInstance();
-		uint32_t currentFrame = Renderer::GetCurrentFrame();
 
-		if (VulkanTaskManager::HasFence(m_InFlightFences[currentFrame]))
-			VulkanTaskManager::RemoveFence(m_InFlightFences[currentFrame]);
+		renderer->GetQueryManager()->End(m_CommandBuffers[Renderer::GetCurrentFrame()], m_OpenTimings.back());
+		m_OpenTimings.pop_back();
+	}
+
+	VkPipelineStageFlags GetVulkanStagesFromPipelineAccess(PipelineAccess access)
+	{
+		VkPipelineStageFlags stages = 0;
+
+		if ((access & PipelineAccess::ComputeRead) || (access & PipelineAccess::ComputeWrite))
+			stages |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		if (access & PipelineAccess::IndirectRead)
+			stages |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+		if (access & PipelineAccess::VertexRead)
+			stages |= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+		if (access & PipelineAccess::FragmentRead)
+			stages |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+		return (stages ? stages : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+	}
+
+	VkAccessFlags GetVulkanAccessFromPipelineAccess(PipelineAccess access)
+	{
+		VkAccessFlags flags = 0;
+
+		if ((access & PipelineAccess::ComputeRead) || (access & PipelineAccess::VertexRead) || (access & PipelineAccess::FragmentRead))
+			flags |= VK_ACCESS_SHADER_READ_BIT;
+		if (access & PipelineAccess::ComputeWrite)
+			flags |= VK_ACCESS_SHADER_WRITE_BIT;
+		if (access & PipelineAccess::IndirectRead)
+			flags |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
 
-		vkWaitForFences(renderer->GetLogicalDevice()->GetVulkanDevice(), 1, &m_InFlightFences[currentFrame], VK_TRUE, MAX_UINT64);
-		vkResetFences(renderer->GetLogicalDevice()->GetVulkanDevice(), 1, &m_InFlightFences[currentFrame]);
+		return flags;
 	}
 
 }
\ No newline at end of file
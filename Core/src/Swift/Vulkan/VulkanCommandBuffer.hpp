@@ -7,11 +7,17 @@
 
 #include "Swift/Renderer/CommandBuffer.hpp"
 
+#include "Swift/Vulkan/VulkanTaskManager.hpp"
+
 #include <vulkan/vulkan.h>
 
 namespace Swift
 {
 
+	// Every stage & access the flags stand for, TOP_OF_PIPE & no access for PipelineAccess::None
+	VkPipelineStageFlags GetVulkanStagesFromPipelineAccess(PipelineAccess access);
+	VkAccessFlags GetVulkanAccessFromPipelineAccess(PipelineAccess access);
+
 	class VulkanCommandBuffer : public CommandBuffer
 	{
 	public:
@@ -24,8 +30,18 @@ namespace Swift
 
 		void WaitOnFinish() override;
 
-		inline VkSemaphore GetRenderFinishedSemaphore(uint32_t index) { return m_RenderFinishedSemaphores[index]; }
-		inline VkFence GetInFlightFence(uint32_t index) { return m_InFlightFences[index]; }
+		inline bool IsRecording() const override { return m_Recording; }
+
+		void Barrier(PipelineAccess written, PipelineAccess read) override;
+
+		void BeginTiming(const std::string& name, TimingFlags flags) override;
+		void EndTiming() override;
+
+		// Note(Jorben): Begins a secondary command buffer that continues the given render pass, also sets the viewport & scissor
+		void BeginSecondary(VkRenderPass renderPass, VkFramebuffer framebuffer, VkExtent2D extent);
+
+		// Note(Jorben): The point on its queue's timeline the last submission of the given frame index reaches
+		inline TimelinePoint GetSignal(uint32_t index) const { return m_Signals[index]; }
 		inline VkCommandBuffer GetVulkanCommandBuffer(uint32_t index) { return m_CommandBuffers[index]; }
 
 	private:
@@ -33,9 +49,12 @@ namespace Swift
 
 		std::vector<VkCommandBuffer> m_CommandBuffers = { };
 
-		// Sync objects
-		std::vector<VkSemaphore> m_RenderFinishedSemaphores = { };
-		std::vector<VkFence> m_InFlightFences = { };
+		// Sync
+		std::vector<TimelinePoint> m_Signals = { };
+
+		// Scopes opened with BeginTiming in the current recording
+		std::vector<uint32_t> m_OpenTimings = { };
+		bool m_Recording = false;
 	};
 
 }
\ No newline at end of file
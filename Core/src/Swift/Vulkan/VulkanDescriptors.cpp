@@ -19,18 +19,95 @@ namespace Swift
 	VulkanDescriptorSet::VulkanDescriptorSet(Descriptor::SetID setID, const std::vector<VkDescriptorSet>& sets)
 		: m_SetID(setID), m_Sets(sets)
 	{
+		m_Bound.resize(m_Sets.size());
 	}
 
 	void VulkanDescriptorSet::Bind(Ref<Pipeline> pipeline, Ref<CommandBuffer> commandBuffer, PipelineBindPoint bindPoint, const std::vector<uint32_t>& dynamicOffsets)
 	{
 		APP_PROFILE_SCOPE("VulkanDescriptorSet::Bind");
 
+		if (m_DirtyFrames.load() & (1u << Renderer::GetCurrentFrame()))
+			Flush();
+
 		auto vkPipelineLayout = RefHelper::RefAs<VulkanPipeline>(pipeline)->GetVulkanLayout();
 		auto vkCmdBuf = RefHelper::RefAs<VulkanCommandBuffer>(commandBuffer)->GetVulkanCommandBuffer(Renderer::GetCurrentFrame());
 
 		vkCmdBindDescriptorSets(vkCmdBuf, PipelineBindPointToVulkanBindPoint(bindPoint), vkPipelineLayout, m_SetID, 1, &m_Sets[Renderer::GetCurrentFrame()], (uint32_t)dynamicOffsets.size(), dynamicOffsets.data());
 	}
 
+	void VulkanDescriptorSet::Write(uint32_t frame, uint32_t binding, VkDescriptorType type, uint32_t count, const VkDescriptorBufferInfo& bufferInfo)
+	{
+		BoundDescriptor& bound = m_Bound[frame][binding];
+		if (bound.Type == type && bound.Count == count && bound.BufferInfo.buffer == bufferInfo.buffer 
+			&& bound.BufferInfo.offset == bufferInfo.offset && bound.BufferInfo.range == bufferInfo.range)
+			return;
+
+		bound.Type = type;
+		bound.Count = count;
+		bound.BufferInfo = bufferInfo;
+		bound.ImageInfo = {};
+		bound.Dirty = true;
+
+		m_DirtyFrames.fetch_or(1u << frame);
+	}
+
+	void VulkanDescriptorSet::Write(uint32_t frame, uint32_t binding, VkDescriptorType type, uint32_t count, const VkDescriptorImageInfo& imageInfo)
+	{
+		BoundDescriptor& bound = m_Bound[frame][binding];
+		if (bound.Type == type && bound.Count == count && bound.ImageInfo.imageView == imageInfo.imageView 
+			&& bound.ImageInfo.sampler == imageInfo.sampler && bound.ImageInfo.imageLayout == imageInfo.imageLayout)
+			return;
+
+		bound.Type = type;
+		bound.Count = count;
+		bound.BufferInfo = {};
+		bound.ImageInfo = imageInfo;
+		bound.Dirty = true;
+
+		m_DirtyFrames.fetch_or(1u << frame);
+	}
+
+	void VulkanDescriptorSet::Flush()
+	{
+		APP_PROFILE_SCOPE("VulkanDescriptorSet::Flush");
+
+		std::scoped_lock<std::mutex> lock(m_FlushMutex);
+
+		// Note(Jorben): None of the bindings are UPDATE_AFTER_BIND, so only the current frame's set (which the GPU is done with) can be updated
+		uint32_t frame = Renderer::GetCurrentFrame();
+		if (!(m_DirtyFrames.load() & (1u << frame)))
+			return;
+
+		m_DirtyFrames.fetch_and(~(1u << frame));
+
+		std::vector<VkWriteDescriptorSet> writes = { };
+
+		for (auto& [binding, bound] : m_Bound[frame])
+		{
+			if (!bound.Dirty)
+				continue;
+
+			VkWriteDescriptorSet descriptorWrite = {};
+			descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			descriptorWrite.dstSet = m_Sets[frame];
+			descriptorWrite.dstBinding = binding;
+			descriptorWrite.dstArrayElement = 0;
+			descriptorWrite.descriptorType = bound.Type;
+			descriptorWrite.descriptorCount = bound.Count;
+
+			if (bound.Type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER || bound.Type == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE)
+				descriptorWrite.pImageInfo = &bound.ImageInfo;
+			else
+				descriptorWrite.pBufferInfo = &bound.BufferInfo;
+
+			writes.push_back(descriptorWrite);
+			bound.Dirty = false;
+		}
+
+		if (!writes.empty())
+			vkUpdateDescriptorSets(((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice(), (uint32_t)writes.size(), writes.data(), 0, nullptr);
+	}
+
 	Ref<DescriptorSet> VulkanDescriptorSet::Create(Descriptor::SetID setID, const std::vector<VkDescriptorSet>& sets)
 	{
 		return RefHelper::Create<VulkanDescriptorSet>(setID, sets);
@@ -218,6 +295,7 @@ namespace Swift
 		case DescriptorType::Image:						return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 		case DescriptorType::StorageImage:				return VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
 		case DescriptorType::StorageBuffer:				return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		case DescriptorType::DynamicStorageBuffer:		return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
 		}
 
 		return VK_DESCRIPTOR_TYPE_MAX_ENUM;
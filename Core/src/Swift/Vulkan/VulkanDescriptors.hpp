@@ -1,5 +1,8 @@
 #pragma once
 
+#include <mutex>
+#include <atomic>
+
 #include "Swift/Core/Core.hpp"
 #include "Swift/Utils/Utils.hpp"
 
@@ -22,16 +25,42 @@ namespace Swift
 
 		void Bind(Ref<Pipeline> pipeline, Ref<CommandBuffer> commandBuffer, PipelineBindPoint bindPoint, const std::vector<uint32_t>& dynamicOffsets) override;
 
+		// Note(Jorben): Writes are cached per binding, identical writes are skipped and 
+		// changed ones are batched into a single vkUpdateDescriptorSets call on Flush (or Bind).
+		// Only the current frame's set is flushed, the other frames' sets might still be in use by the GPU,
+		// so their writes stay pending until those frames come round.
+		void Write(uint32_t frame, uint32_t binding, VkDescriptorType type, uint32_t count, const VkDescriptorBufferInfo& bufferInfo);
+		void Write(uint32_t frame, uint32_t binding, VkDescriptorType type, uint32_t count, const VkDescriptorImageInfo& imageInfo);
+		void Flush();
+
 		inline Descriptor::SetID GetSetID() const { return m_SetID; }
 		inline VkDescriptorSet GetVulkanSet(uint32_t index) { return m_Sets[index]; }
 	
 		static Ref<DescriptorSet> Create(Descriptor::SetID setID, const std::vector<VkDescriptorSet>& sets);
 
+	private:
+		struct BoundDescriptor
+		{
+		public:
+			VkDescriptorType Type = VK_DESCRIPTOR_TYPE_MAX_ENUM;
+			uint32_t Count = 0;
+
+			VkDescriptorBufferInfo BufferInfo = {};
+			VkDescriptorImageInfo ImageInfo = {};
+
+			bool Dirty = false;
+		};
+
 	private:
 		Descriptor::SetID m_SetID = 0;
 
 		// Note(Jorben): One for every frame in flight
 		std::vector<VkDescriptorSet> m_Sets = { };
+		std::vector<Dict<uint32_t, BoundDescriptor>> m_Bound = { };
+
+		// Note(Jorben): Sets can be bound from multiple recording threads at once, the first one to bind a dirty set flushes it
+		std::atomic<uint32_t> m_DirtyFrames = 0; // Bit per frame in flight
+		std::mutex m_FlushMutex = {};
 	};
 
 	class VulkanDescriptorSets : public DescriptorSets
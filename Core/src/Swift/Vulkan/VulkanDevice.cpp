@@ -11,10 +11,11 @@ namespace Swift
 	VulkanDevice::VulkanDevice(Ref<VulkanPhysicalDevice> physicalDevice)
 		: m_PhysicalDevice(physicalDevice)
 	{
-		QueueFamilyIndices indices = QueueFamilyIndices::Find(m_PhysicalDevice->GetVulkanPhysicalDevice());
+		m_QueueFamilies = QueueFamilyIndices::Find(m_PhysicalDevice->GetVulkanPhysicalDevice());
+		const QueueFamilyIndices& indices = m_QueueFamilies;
 
 		std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-		std::set<uint32_t> uniqueQueueFamilies = { indices.GraphicsFamily.value(), indices.PresentFamily.value() };
+		std::set<uint32_t> uniqueQueueFamilies = { indices.GraphicsFamily.value(), indices.ComputeFamily.value(), indices.PresentFamily.value(), indices.TransferFamily.value() };
 
 		float queuePriority = 1.0f;
 		for (uint32_t queueFamily : uniqueQueueFamilies)
@@ -27,13 +28,45 @@ namespace Swift
 			queueCreateInfos.push_back(queueCreateInfo);
 		}
 
+		// Note(Jorben): Optional features, used by the GPU timings when available
+		VkPhysicalDeviceVulkan12Features supported12 = {};
+		supported12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+		VkPhysicalDeviceFeatures2 supported = {};
+		supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		supported.pNext = &supported12;
+		vkGetPhysicalDeviceFeatures2(m_PhysicalDevice->GetVulkanPhysicalDevice(), &supported);
+
+		m_HostQueryReset = supported12.hostQueryReset;
+		m_PipelineStatistics = supported.features.pipelineStatisticsQuery;
+		// Note(Jorben): Without these indirect draws are issued one command at a time/without a GPU written count
+		m_MultiDrawIndirect = supported.features.multiDrawIndirect;
+		m_DrawIndirectCount = supported12.drawIndirectCount;
+
+		// Note(Jorben): Required, all GPU synchronization goes through the VulkanTaskManager's timelines
+		if (!supported12.timelineSemaphore)
+			APP_LOG_FATAL("Device doesn't support timeline semaphores!");
+		// Note(Jorben): Required, indirect draws index their per instance data through gl_InstanceIndex
+		if (!supported.features.drawIndirectFirstInstance)
+			APP_LOG_FATAL("Device doesn't support drawIndirectFirstInstance!");
+
+		VkPhysicalDeviceVulkan12Features features12 = {};
+		features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		features12.hostQueryReset = m_HostQueryReset;
+		features12.timelineSemaphore = VK_TRUE;
+		features12.drawIndirectCount = m_DrawIndirectCount;
+
 		VkPhysicalDeviceFeatures deviceFeatures = {};
 		deviceFeatures.samplerAnisotropy = VK_TRUE;
 		deviceFeatures.fillModeNonSolid = VK_TRUE;
 		deviceFeatures.wideLines = VK_TRUE;
+		deviceFeatures.pipelineStatisticsQuery = m_PipelineStatistics;
+		deviceFeatures.multiDrawIndirect = m_MultiDrawIndirect;
+		deviceFeatures.drawIndirectFirstInstance = VK_TRUE;
 
 		VkDeviceCreateInfo createInfo = {};
 		createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+		createInfo.pNext = &features12;
 		createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
 		createInfo.pQueueCreateInfos = queueCreateInfos.data();
 		createInfo.pEnabledFeatures = &deviceFeatures;
@@ -53,10 +86,16 @@ namespace Swift
 		if (vkCreateDevice(m_PhysicalDevice->GetVulkanPhysicalDevice(), &createInfo, nullptr, &m_LogicalDevice) != VK_SUCCESS)
 			APP_LOG_ERROR("Failed to create logical device!");
 
-		// Retrieve the graphics/compute/present queue handle
+		// Retrieve the graphics/compute/present/transfer queue handle
 		vkGetDeviceQueue(m_LogicalDevice, indices.GraphicsFamily.value(), 0, &m_GraphicsQueue);
 		vkGetDeviceQueue(m_LogicalDevice, indices.ComputeFamily.value(), 0, &m_ComputeQueue);
 		vkGetDeviceQueue(m_LogicalDevice, indices.PresentFamily.value(), 0, &m_PresentQueue);
+		vkGetDeviceQueue(m_LogicalDevice, indices.TransferFamily.value(), 0, &m_TransferQueue);
+
+		if (indices.HasAsyncCompute())
+			APP_LOG_INFO("Using queue family {0} for async compute.", indices.ComputeFamily.value());
+		if (indices.HasAsyncTransfer())
+			APP_LOG_INFO("Using queue family {0} for uploads.", indices.TransferFamily.value());
 	}
 
 	VulkanDevice::~VulkanDevice()
@@ -64,6 +103,14 @@ namespace Swift
 		vkDestroyDevice(m_LogicalDevice, nullptr);
 	}
 
+	uint32_t VulkanDevice::GetQueueFamily(Queue queue) const
+	{
+		if (queue == Queue::Compute)
+			return m_QueueFamilies.ComputeFamily.value();
+
+		return m_QueueFamilies.GraphicsFamily.value();
+	}
+
 	Ref<VulkanDevice> VulkanDevice::Create(Ref<VulkanPhysicalDevice> physicalDevice)
 	{
 		return RefHelper::Create<VulkanDevice>(physicalDevice);
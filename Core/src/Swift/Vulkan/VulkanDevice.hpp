@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <memory>
 
 #include <vulkan/vulkan.h>
@@ -7,6 +8,8 @@
 #include "Swift/Core/Core.hpp"
 #include "Swift/Utils/Utils.hpp"
 
+#include "Swift/Renderer/CommandBuffer.hpp"
+
 #include "Swift/Vulkan/VulkanPhysicalDevice.hpp"
 
 namespace Swift
@@ -23,9 +26,25 @@ namespace Swift
 		inline VkQueue& GetGraphicsQueue() { return m_GraphicsQueue; }
 		inline VkQueue& GetComputeQueue() { return m_ComputeQueue; }
 		inline VkQueue& GetPresentQueue() { return m_PresentQueue; }
+		inline VkQueue& GetTransferQueue() { return m_TransferQueue; }
+
+		// Note(Jorben): VkQueues have to be externally synchronized, uploads are submitted from whichever thread creates the resource
+		// while the frames are submitted by the thread executing them. Every vkQueueSubmit/vkQueuePresentKHR/vkQueueWaitIdle locks this.
+		inline std::mutex& GetQueueMutex() { return m_QueueMutex; }
+
+		// Note(Jorben): Without a dedicated compute family the compute queue is the graphics queue
+		inline const QueueFamilyIndices& GetQueueFamilies() const { return m_QueueFamilies; }
+		inline bool HasAsyncCompute() const { return m_QueueFamilies.HasAsyncCompute(); }
+		inline bool HasAsyncTransfer() const { return m_QueueFamilies.HasAsyncTransfer(); }
+		uint32_t GetQueueFamily(Queue queue) const;
 
 		inline Ref<VulkanPhysicalDevice> GetPhysicalDevice() const { return m_PhysicalDevice; }
 
+		inline bool HasHostQueryReset() const { return m_HostQueryReset; }
+		inline bool HasPipelineStatistics() const { return m_PipelineStatistics; }
+		inline bool HasMultiDrawIndirect() const { return m_MultiDrawIndirect; }
+		inline bool HasDrawIndirectCount() const { return m_DrawIndirectCount; }
+
 		static Ref<VulkanDevice> Create(Ref<VulkanPhysicalDevice> physicalDevice);
 
 	private:
@@ -35,6 +54,16 @@ namespace Swift
 		VkQueue m_GraphicsQueue = VK_NULL_HANDLE;
 		VkQueue m_ComputeQueue = VK_NULL_HANDLE;
 		VkQueue m_PresentQueue = VK_NULL_HANDLE;
+		VkQueue m_TransferQueue = VK_NULL_HANDLE;
+
+		std::mutex m_QueueMutex = {};
+
+		QueueFamilyIndices m_QueueFamilies = {};
+
+		bool m_HostQueryReset = false;
+		bool m_PipelineStatistics = false;
+		bool m_MultiDrawIndirect = false;
+		bool m_DrawIndirectCount = false;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "swpch.h"
+#include "VulkanFrameUploadRing.hpp"
+
+#include "Swift/Core/Logging.hpp"
+#include "Swift/Utils/Profiler.hpp"
+
+#include "Swift/Renderer/Renderer.hpp"
+
+#include "Swift/Vulkan/VulkanUtils.hpp"
+#include "Swift/Vulkan/VulkanRenderer.hpp"
+#include "Swift/Vulkan/VulkanDescriptors.hpp"
+
+namespace Swift
+{
+
+	VulkanFrameUploadRing::VulkanFrameUploadRing(size_t sizePerFrame)
+		: m_Size(sizePerFrame)
+	{
+		auto& limits = ((VulkanRenderer*)Renderer::GetInstance())->GetPhysicalDevice()->GetProperties().limits;
+		m_Alignment = (size_t)std::max(limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment);
+
+		uint32_t framesInFlight = (uint32_t)RendererSpecification::BufferCount;
+		m_Buffers.resize((size_t)framesInFlight);
+		m_Allocations.resize((size_t)framesInFlight);
+		m_MappedData.resize((size_t)framesInFlight);
+
+		VulkanAllocator allocator = {};
+		for (size_t i = 0; i < framesInFlight; i++)
+			m_Allocations[i] = allocator.AllocateMappedBuffer((VkDeviceSize)m_Size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU, m_Buffers[i], m_MappedData[i]);
+	}
+
+	VulkanFrameUploadRing::~VulkanFrameUploadRing()
+	{
+		auto buffers = m_Buffers;
+		auto allocations = m_Allocations;
+
+		Renderer::SubmitFree([buffers, allocations]()
+		{
+			VulkanAllocator allocator = {};
+
+			for (size_t i = 0; i < buffers.size(); i++)
+			{
+				if (buffers[i] != VK_NULL_HANDLE)
+					allocator.DestroyBuffer(buffers[i], allocations[i]);
+			}
+		});
+	}
+
+	FrameAllocation VulkanFrameUploadRing::Allocate(size_t size)
+	{
+		size_t alignedSize = (size + m_Alignment - 1) & ~(m_Alignment - 1);
+		size_t offset = m_Offset.fetch_add(alignedSize, std::memory_order_relaxed);
+
+		// Note(Jorben): Every descriptor points at the ring, so there's nowhere else to put the data. An empty allocation would be
+		// bound at offset 0 and silently read another allocation's data, so running out is fatal. Increase RendererSpecification::UploadRingSize.
+		if (offset + size > m_Size)
+		{
+			APP_ASSERT(false, "FrameUploadRing is out of memory, tried to allocate {0} bytes with {1}/{2} bytes used.", size, offset, m_Size);
+			return {};
+		}
+
+		FrameAllocation allocation = {};
+		allocation.Data = static_cast<uint8_t*>(m_MappedData[Renderer::GetCurrentFrame()]) + offset;
+		allocation.Offset = offset;
+		allocation.Size = size;
+
+		return allocation;
+	}
+
+	FrameAllocation VulkanFrameUploadRing::Push(const void* data, size_t size)
+	{
+		APP_PROFILE_SCOPE("VulkanFrameUploadRing::Push");
+
+		FrameAllocation allocation = Allocate(size);
+		if (!allocation.Valid())
+			return allocation;
+
+		memcpy(allocation.Data, data, size);
+		VulkanAllocator::FlushMemory(m_Allocations[Renderer::GetCurrentFrame()], (VkDeviceSize)allocation.Offset, (VkDeviceSize)size);
+
+		return allocation;
+	}
+
+	void VulkanFrameUploadRing::Reset()
+	{
+		m_Offset.store(0, std::memory_order_relaxed);
+	}
+
+	void VulkanFrameUploadRing::Upload(Ref<DescriptorSet> set, Descriptor element, size_t range)
+	{
+		APP_PROFILE_SCOPE("VulkanFrameUploadRing::Upload");
+
+		if (element.Type != DescriptorType::DynamicUniformBuffer && element.Type != DescriptorType::DynamicStorageBuffer)
+		{
+			APP_LOG_ERROR("FrameUploadRing can only be uploaded to a DynamicUniformBuffer or DynamicStorageBuffer descriptor, '{0}' is neither.", element.Name);
+			return;
+		}
+
+		auto vkSet = RefHelper::RefAs<VulkanDescriptorSet>(set);
+
+		for (size_t i = 0; i < (size_t)RendererSpecification::BufferCount; i++)
+		{
+			VkDescriptorBufferInfo bufferInfo = {};
+			bufferInfo.buffer = m_Buffers[i];
+			bufferInfo.offset = 0;
+			bufferInfo.range = (VkDeviceSize)range;
+
+			vkSet->Write((uint32_t)i, element.Binding, DescriptorTypeToVulkanDescriptorType(element.Type), element.Count, bufferInfo);
+		}
+	}
+
+}
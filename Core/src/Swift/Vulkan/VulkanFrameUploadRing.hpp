@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "Swift/Core/Core.hpp"
+#include "Swift/Utils/Utils.hpp"
+
+#include "Swift/Renderer/Descriptors.hpp"
+#include "Swift/Renderer/FrameUploadRing.hpp"
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+namespace Swift
+{
+
+	class VulkanFrameUploadRing : public FrameUploadRing
+	{
+	public:
+		VulkanFrameUploadRing(size_t sizePerFrame);
+		virtual ~VulkanFrameUploadRing();
+
+		FrameAllocation Allocate(size_t size) override;
+		FrameAllocation Push(const void* data, size_t size) override;
+
+		void Reset() override;
+
+		inline size_t GetAlignment() const override { return m_Alignment; }
+		inline size_t GetCapacity() const override { return m_Size; }
+		inline size_t GetUsed() const override { return m_Offset.load(std::memory_order_relaxed); }
+
+		void Upload(Ref<DescriptorSet> set, Descriptor element, size_t range) override;
+
+		inline VkBuffer GetVulkanBuffer(uint32_t index) { return m_Buffers[index]; }
+
+	private:
+		std::vector<VkBuffer> m_Buffers = { };
+		std::vector<VmaAllocation> m_Allocations = { };
+		std::vector<void*> m_MappedData = { };
+
+		size_t m_Size = 0;
+		size_t m_Alignment = 0;
+
+		std::atomic<size_t> m_Offset = 0;
+	};
+
+}
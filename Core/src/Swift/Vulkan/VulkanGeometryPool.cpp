@@ -0,0 +1,126 @@
+#include "swpch.h"
+#include "VulkanGeometryPool.hpp"
+
+#include "Swift/Core/Logging.hpp"
+#include "Swift/Utils/Profiler.hpp"
+
+#include "Swift/Renderer/Renderer.hpp"
+
+#include "Swift/Vulkan/VulkanUtils.hpp"
+#include "Swift/Vulkan/VulkanCommandBuffer.hpp"
+#include "Swift/Vulkan/VulkanUploadManager.hpp"
+
+namespace Swift
+{
+
+	VulkanGeometryPool::VulkanGeometryPool(size_t vertexStride, uint32_t vertexCapacity, uint32_t indexCapacity)
+		: m_VertexStride(vertexStride), m_Vertices(RefHelper::Create<FreeList>((uint64_t)vertexCapacity)), m_Indices(RefHelper::Create<FreeList>((uint64_t)indexCapacity))
+	{
+		VulkanAllocator allocator = {};
+
+		m_VertexAllocation = allocator.AllocateBuffer((VkDeviceSize)(m_VertexStride * vertexCapacity), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY, m_VertexBuffer);
+		m_IndexAllocation = allocator.AllocateBuffer((VkDeviceSize)(sizeof(uint32_t) * indexCapacity), VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY, m_IndexBuffer);
+	}
+
+	VulkanGeometryPool::~VulkanGeometryPool()
+	{
+		auto vertexBuffer = m_VertexBuffer;
+		auto vertexAllocation = m_VertexAllocation;
+		auto indexBuffer = m_IndexBuffer;
+		auto indexAllocation = m_IndexAllocation;
+
+		Renderer::SubmitFree([vertexBuffer, vertexAllocation, indexBuffer, indexAllocation]()
+		{
+			VulkanAllocator allocator = {};
+
+			if (vertexBuffer != VK_NULL_HANDLE)
+				allocator.DestroyBuffer(vertexBuffer, vertexAllocation);
+			if (indexBuffer != VK_NULL_HANDLE)
+				allocator.DestroyBuffer(indexBuffer, indexAllocation);
+		});
+	}
+
+	GeometryRange VulkanGeometryPool::Allocate(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount)
+	{
+		APP_PROFILE_SCOPE("VulkanGeometryPool::Allocate");
+
+		if (vertexCount == 0 || indexCount == 0)
+			return {};
+
+		uint64_t vertexOffset = 0;
+		if (!m_Vertices->Allocate((uint64_t)vertexCount, vertexOffset))
+		{
+			APP_LOG_ERROR("GeometryPool is out of vertices, {0} requested and {1} of {2} used.", vertexCount, GetVerticesUsed(), GetVertexCapacity());
+			return {};
+		}
+
+		uint64_t firstIndex = 0;
+		if (!m_Indices->Allocate((uint64_t)indexCount, firstIndex))
+		{
+			APP_LOG_ERROR("GeometryPool is out of indices, {0} requested and {1} of {2} used.", indexCount, GetIndicesUsed(), GetIndexCapacity());
+			m_Vertices->Free(vertexOffset, (uint64_t)vertexCount);
+			return {};
+		}
+
+		GeometryRange range = {};
+		range.VertexOffset = (uint32_t)vertexOffset;
+		range.VertexCount = vertexCount;
+		range.FirstIndex = (uint32_t)firstIndex;
+		range.IndexCount = indexCount;
+
+		auto uploadManager = RefHelper::RefAs<VulkanUploadManager>(Renderer::GetUploadManager());
+		UploadPoint vertexUpload = uploadManager->StageBuffer(m_VertexBuffer, vertices, m_VertexStride * vertexCount, (VkDeviceSize)(m_VertexStride * vertexOffset));
+		UploadPoint indexUpload = uploadManager->StageBuffer(m_IndexBuffer, indices, sizeof(uint32_t) * indexCount, (VkDeviceSize)(sizeof(uint32_t) * firstIndex));
+
+		if (vertexUpload.Failed() || indexUpload.Failed())
+		{
+			APP_LOG_ERROR("Failed to stage the geometry ({0} vertices, {1} indices), the range is given back.", vertexCount, indexCount);
+
+			auto vertexList = m_Vertices;
+			auto indexList = m_Indices;
+
+			// Note(Jorben): The half that did get staged still writes into the range, so it's only given back once that copy is done
+			uploadManager->OnComplete([vertexList, indexList, range]()
+			{
+				vertexList->Free((uint64_t)range.VertexOffset, (uint64_t)range.VertexCount);
+				indexList->Free((uint64_t)range.FirstIndex, (uint64_t)range.IndexCount);
+			}, (vertexUpload.Failed() ? indexUpload : vertexUpload));
+
+			return {};
+		}
+
+		// Note(Jorben): Another thread can flush in between, batches finish in order so the last one covers both
+		range.Upload = { std::max(vertexUpload.Value, indexUpload.Value) };
+		return range;
+	}
+
+	void VulkanGeometryPool::Free(const GeometryRange& range)
+	{
+		if (!range.Valid())
+			return;
+
+		auto vertices = m_Vertices;
+		auto indices = m_Indices;
+
+		// Note(Jorben): The copy can take longer than the frames in flight the free stream waits on,
+		// so the range only goes into the free stream once its upload is done (right away if it already is)
+		Renderer::GetUploadManager()->OnComplete([vertices, indices, range]()
+		{
+			Renderer::SubmitFree([vertices, indices, range]()
+			{
+				vertices->Free((uint64_t)range.VertexOffset, (uint64_t)range.VertexCount);
+				indices->Free((uint64_t)range.FirstIndex, (uint64_t)range.IndexCount);
+			});
+		}, range.Upload);
+	}
+
+	void VulkanGeometryPool::Bind(Ref<CommandBuffer> commandBuffer) const
+	{
+		auto cmdBuf = RefHelper::RefAs<VulkanCommandBuffer>(commandBuffer)->GetVulkanCommandBuffer(Renderer::GetCurrentFrame());
+
+		VkDeviceSize offsets[] = { 0 };
+		vkCmdBindVertexBuffers(cmdBuf, 0, 1, &m_VertexBuffer, offsets);
+		vkCmdBindIndexBuffer(cmdBuf, m_IndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+	}
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Swift/Core/Core.hpp"
+#include "Swift/Utils/Utils.hpp"
+#include "Swift/Utils/FreeList.hpp"
+
+#include "Swift/Renderer/GeometryPool.hpp"
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+namespace Swift
+{
+
+	class VulkanGeometryPool : public GeometryPool
+	{
+	public:
+		VulkanGeometryPool(size_t vertexStride, uint32_t vertexCapacity, uint32_t indexCapacity);
+		virtual ~VulkanGeometryPool();
+
+		GeometryRange Allocate(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) override;
+		void Free(const GeometryRange& range) override;
+
+		void Bind(Ref<CommandBuffer> commandBuffer) const override;
+
+		inline size_t GetVertexStride() const override { return m_VertexStride; }
+		inline uint32_t GetVertexCapacity() const override { return (uint32_t)m_Vertices->GetCapacity(); }
+		inline uint32_t GetVerticesUsed() const override { return (uint32_t)m_Vertices->GetUsed(); }
+		inline uint32_t GetIndexCapacity() const override { return (uint32_t)m_Indices->GetCapacity(); }
+		inline uint32_t GetIndicesUsed() const override { return (uint32_t)m_Indices->GetUsed(); }
+
+		inline VkBuffer GetVertexBuffer() const { return m_VertexBuffer; }
+		inline VkBuffer GetIndexBuffer() const { return m_IndexBuffer; }
+
+	private:
+		VkBuffer m_VertexBuffer = VK_NULL_HANDLE;
+		VmaAllocation m_VertexAllocation = VK_NULL_HANDLE;
+		VkBuffer m_IndexBuffer = VK_NULL_HANDLE;
+		VmaAllocation m_IndexAllocation = VK_NULL_HANDLE;
+
+		size_t m_VertexStride = 0;
+
+		// Note(Jorben): Freed ranges are given back from the free stream, which can run after the pool is gone
+		Ref<FreeList> m_Vertices = nullptr;
+		Ref<FreeList> m_Indices = nullptr;
+	};
+
+}
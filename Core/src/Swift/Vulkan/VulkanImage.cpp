@@ -10,6 +10,8 @@
 #include "Swift/Vulkan/VulkanRenderer.hpp"
 #include "Swift/Vulkan/VulkanPipeline.hpp"
 #include "Swift/Vulkan/VulkanDescriptors.hpp"
+#include "Swift/Vulkan/VulkanCommandBuffer.hpp"
+#include "Swift/Vulkan/VulkanUploadManager.hpp"
 
 #include <stb_image.h>
 
@@ -18,8 +20,9 @@ namespace Swift
 
 	static VkImageUsageFlags GetVulkanImageUsageFromImageUsage(ImageUsageFlags usage);
 	static VkImageAspectFlags GetVulkanImageAspectFromImageUsage(ImageUsageFlags usage);
+	static void GetQueueImageUsage(Queue queue, VkImageLayout layout, VkPipelineStageFlags& stage, VkAccessFlags& access);
 
-	VulkanImage2D::VulkanImage2D(const ImageSpecification& specs)
+	VulkanImage2D::VulkanImage2D(const ImageSpecification& specs, bool async)
 		: m_Specification(specs)
 	{
 		if (!(m_Specification.Flags & ImageUsageFlags::Colour) && !(m_Specification.Flags & ImageUsageFlags::Depth))
@@ -41,6 +44,9 @@ namespace Swift
 			APP_LOG_ERROR("Invalid image usage selected.");
 			break;
 		}
+
+		if (!async && m_Upload)
+			Renderer::GetUploadManager()->Wait(m_Upload);
 	}
 
 	VulkanImage2D::VulkanImage2D(const ImageSpecification& specs, const VulkanImageData& data)
@@ -50,12 +56,15 @@ namespace Swift
 
 	VulkanImage2D::~VulkanImage2D()
 	{
+		// Note(Jorben): The copy can take longer than the frames in flight the free stream waits on
+		if (!IsReady())
+			Renderer::GetUploadManager()->Wait(m_Upload);
+
 		auto data = m_Data;
 
 		Renderer::SubmitFree([data]()
 		{
 			auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice();
-			Renderer::Wait();
 
 			vkDestroySampler(device, data.Sampler, nullptr);
 			vkDestroyImageView(device, data.ImageView, nullptr);
@@ -70,31 +79,8 @@ namespace Swift
 	{
 		APP_PROFILE_SCOPE("VulkanImage2D::SetData");
 
-		VulkanAllocator allocator = {};
-
-		VkBuffer stagingBuffer = VK_NULL_HANDLE;
-		VmaAllocation stagingBufferAllocation = VK_NULL_HANDLE;
-		stagingBufferAllocation = allocator.AllocateBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY, stagingBuffer);
-
-		void* mappedData;
-		VulkanAllocator::MapMemory(stagingBufferAllocation, mappedData);
-		memcpy(mappedData, data, size);
-		VulkanAllocator::UnMapMemory(stagingBufferAllocation);
-
-		VulkanAllocator::TransitionImageLayout(m_Data.Image, GetVulkanFormatFromImageFormat(m_Specification.Format), VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_Miplevels);
-		allocator.CopyBufferToImage(stagingBuffer, m_Data.Image, m_Specification.Width, m_Specification.Height);
-
-		if (m_Specification.Flags & ImageUsageFlags::NoMipMaps)
-		{
-			VulkanAllocator::TransitionImageLayout(m_Data.Image, GetVulkanFormatFromImageFormat(m_Specification.Format), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (VkImageLayout)m_Specification.Layout, m_Miplevels);
-		}
-		else
-		{
-			GenerateMipmaps(m_Data.Image, GetVulkanFormatFromImageFormat(m_Specification.Format), m_Specification.Width, m_Specification.Height, m_Miplevels);
-			VulkanAllocator::TransitionImageLayout(m_Data.Image, GetVulkanFormatFromImageFormat(m_Specification.Format), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, (VkImageLayout)m_Specification.Layout, m_Miplevels);
-		}
-
-		allocator.DestroyBuffer(stagingBuffer, stagingBufferAllocation);
+		m_Upload = Stage(data, size);
+		Renderer::GetUploadManager()->Wait(m_Upload);
 	}
 
 	void VulkanImage2D::Resize(uint32_t width, uint32_t height)
@@ -129,16 +115,7 @@ namespace Swift
 			imageInfo.imageView = m_Data.ImageView;
 			imageInfo.sampler = m_Data.Sampler;
 
-			VkWriteDescriptorSet descriptorWrite = {};
-			descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			descriptorWrite.dstSet = vkSet->GetVulkanSet((uint32_t)i);
-			descriptorWrite.dstBinding = element.Binding;
-			descriptorWrite.dstArrayElement = 0;
-			descriptorWrite.descriptorType = DescriptorTypeToVulkanDescriptorType(element.Type);
-			descriptorWrite.descriptorCount = element.Count;
-			descriptorWrite.pImageInfo = &imageInfo;
-
-			vkUpdateDescriptorSets(((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice(), 1, &descriptorWrite, 0, nullptr);
+			vkSet->Write((uint32_t)i, element.Binding, DescriptorTypeToVulkanDescriptorType(element.Type), element.Count, imageInfo);
 		}
 	}
 
@@ -148,6 +125,47 @@ namespace Swift
 		m_Specification.Layout = final;
 	}
 
+	void VulkanImage2D::Transition(Ref<CommandBuffer> commandBuffer, ImageLayout initial, ImageLayout final)
+	{
+		APP_PROFILE_SCOPE("VulkanImage2D::Transition");
+
+		if (m_Specification.Layout == final)
+			return;
+
+		// Note(Jorben): The barrier has to start from the layout the image is actually in, Undefined is the only other valid one (discards the contents)
+		APP_ASSERT(((initial == m_Specification.Layout) || (initial == ImageLayout::Undefined)), "Transitioning an image from a layout it isn't in.");
+		ImageLayout oldLayout = (initial == ImageLayout::Undefined ? ImageLayout::Undefined : m_Specification.Layout);
+
+		auto vkCmd = RefHelper::RefAs<VulkanCommandBuffer>(commandBuffer);
+		VulkanAllocator::TransitionImageLayout(vkCmd->GetVulkanCommandBuffer(Renderer::GetCurrentFrame()), m_Data.Image, GetVulkanFormatFromImageFormat(m_Specification.Format), (VkImageLayout)oldLayout, (VkImageLayout)final, m_Miplevels);
+		m_Specification.Layout = final;
+	}
+
+	void VulkanImage2D::Release(Ref<CommandBuffer> commandBuffer, Queue from, Queue to, ImageLayout initial, ImageLayout final)
+	{
+		APP_PROFILE_SCOPE("VulkanImage2D::Release");
+
+		auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice();
+		if (device->GetQueueFamily(from) == device->GetQueueFamily(to))
+		{
+			Transition(commandBuffer, initial, final);
+			return;
+		}
+
+		TransferOwnership(commandBuffer, from, to, initial, final, false);
+	}
+
+	void VulkanImage2D::Acquire(Ref<CommandBuffer> commandBuffer, Queue from, Queue to, ImageLayout initial, ImageLayout final)
+	{
+		APP_PROFILE_SCOPE("VulkanImage2D::Acquire");
+
+		auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice();
+		if (device->GetQueueFamily(from) == device->GetQueueFamily(to))
+			return;
+
+		TransferOwnership(commandBuffer, from, to, initial, final, true);
+	}
+
 	void VulkanImage2D::SetImageData(const ImageSpecification& specs, const VulkanImageData& data)
 	{
 		m_Specification = specs;
@@ -159,6 +177,11 @@ namespace Swift
 		return GetVulkanFormatFromImageFormat(m_Specification.Format);
 	}
 
+	bool VulkanImage2D::IsReady() const
+	{
+		return !m_Upload || Renderer::GetUploadManager()->IsComplete(m_Upload);
+	}
+
 	void VulkanImage2D::CreateImage(uint32_t width, uint32_t height)
 	{
 		m_Specification.Width = width;
@@ -199,11 +222,41 @@ namespace Swift
 		m_Data.ImageView = allocator.CreateImageView(m_Data.Image, GetVulkanFormatFromImageFormat(m_Specification.Format), VK_IMAGE_ASPECT_COLOR_BIT, m_Miplevels);
 		m_Data.Sampler = allocator.CreateSampler(m_Miplevels);
 
-		SetData((void*)pixels, imageSize);
+		// Note(Jorben): The pixels are copied into the staging ring, so they can go right away
+		m_Upload = Stage((void*)pixels, imageSize);
 		stbi_image_free((void*)pixels);
 	}
 
-	void VulkanImage2D::GenerateMipmaps(VkImage& image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels)
+	UploadPoint VulkanImage2D::Stage(void* data, size_t size)
+	{
+		APP_PROFILE_SCOPE("VulkanImage2D::Stage");
+
+		VkFormat format = GetVulkanFormatFromImageFormat(m_Specification.Format);
+		VkImageLayout layout = (VkImageLayout)m_Specification.Layout;
+
+		// The mips are blitted on the graphics queue, a copy engine can't
+		auto finish = [this, format, layout](VkCommandBuffer commandBuffer)
+		{
+			if (m_Specification.Flags & ImageUsageFlags::NoMipMaps)
+			{
+				VulkanAllocator::TransitionImageLayout(commandBuffer, m_Data.Image, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, layout, m_Miplevels);
+			}
+			else
+			{
+				GenerateMipmaps(commandBuffer, m_Data.Image, format, m_Specification.Width, m_Specification.Height, m_Miplevels);
+				VulkanAllocator::TransitionImageLayout(commandBuffer, m_Data.Image, format, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, layout, m_Miplevels);
+			}
+		};
+
+		auto uploadManager = RefHelper::RefAs<VulkanUploadManager>(Renderer::GetUploadManager());
+		UploadPoint point = uploadManager->StageImage(m_Data.Image, format, m_Specification.Width, m_Specification.Height, m_Miplevels, data, size, finish);
+		if (point.Failed())
+			APP_LOG_ERROR("Failed to stage the image's data ({0}x{1}), it will never be ready.", m_Specification.Width, m_Specification.Height);
+
+		return point;
+	}
+
+	void VulkanImage2D::GenerateMipmaps(VkCommandBuffer commandBuffer, VkImage& image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels)
 	{
 		// Check if image format supports linear blitting
 		VkFormatProperties formatProperties;
@@ -212,8 +265,6 @@ namespace Swift
 		if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
 			APP_LOG_ERROR("Texture image format does not support linear blitting!");
 
-		VulkanCommand command = VulkanCommand(true);
-
 		VkImageMemoryBarrier barrier = {};
 		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
 		barrier.image = image;
@@ -235,7 +286,7 @@ namespace Swift
 			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
 			barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
 
-			vkCmdPipelineBarrier(command.GetVulkanCommandBuffer(),
+			vkCmdPipelineBarrier(commandBuffer,
 				VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
 				0, nullptr,
 				0, nullptr,
@@ -255,7 +306,7 @@ namespace Swift
 			blit.dstSubresource.baseArrayLayer = 0;
 			blit.dstSubresource.layerCount = 1;
 
-			vkCmdBlitImage(command.GetVulkanCommandBuffer(),
+			vkCmdBlitImage(commandBuffer,
 				image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
 				image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 				1, &blit,
@@ -266,7 +317,7 @@ namespace Swift
 			barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
 			barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
 
-			vkCmdPipelineBarrier(command.GetVulkanCommandBuffer(),
+			vkCmdPipelineBarrier(commandBuffer,
 				VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
 				0, nullptr,
 				0, nullptr,
@@ -282,13 +333,29 @@ namespace Swift
 		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
 		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
 
-		vkCmdPipelineBarrier(command.GetVulkanCommandBuffer(),
+		vkCmdPipelineBarrier(commandBuffer,
 			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
 			0, nullptr,
 			0, nullptr,
 			1, &barrier);
+	}
+
+	void VulkanImage2D::TransferOwnership(Ref<CommandBuffer> commandBuffer, Queue from, Queue to, ImageLayout initial, ImageLayout final, bool acquire)
+	{
+		auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice();
+		auto vkCmd = RefHelper::RefAs<VulkanCommandBuffer>(commandBuffer);
+
+		VkImageAspectFlags aspect = GetVulkanImageAspectFromImageUsage(m_Specification.Flags);
+		if ((aspect & VK_IMAGE_ASPECT_DEPTH_BIT) && VulkanAllocator::HasStencilComponent(GetFormat()))
+			aspect |= VK_IMAGE_ASPECT_STENCIL_BIT;
 
-		command.EndAndSubmit();
+		// Note(Jorben): The release synchronizes with how the image was used in the initial layout, the acquire with how it's going to be used in the final one
+		VkPipelineStageFlags stage = 0;
+		VkAccessFlags access = 0;
+		GetQueueImageUsage(acquire ? to : from, (VkImageLayout)(acquire ? final : initial), stage, access);
+
+		VulkanAllocator::TransferImageOwnership(vkCmd->GetVulkanCommandBuffer(Renderer::GetCurrentFrame()), m_Data.Image, aspect, (VkImageLayout)initial, (VkImageLayout)final, m_Miplevels, device->GetQueueFamily(from), device->GetQueueFamily(to), acquire, stage, access);
+		m_Specification.Layout = final;
 	}
 
 	VkFormat GetVulkanFormatFromImageFormat(ImageFormat format)
@@ -373,6 +440,35 @@ namespace Swift
 		return flags;
 	}
 
+	static void GetQueueImageUsage(Queue queue, VkImageLayout layout, VkPipelineStageFlags& stage, VkAccessFlags& access)
+	{
+		// Note(Jorben): Compute queues only touch images from their shaders
+		if (queue == Queue::Compute)
+		{
+			stage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+			access = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+			return;
+		}
+
+		switch (layout)
+		{
+		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+			stage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+			access = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
+			break;
+		case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+			stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			access = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+			break;
+
+		default:
+			stage = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+			access = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+			break;
+		}
+	}
+
 
 
 	VulkanImageData::VulkanImageData(VkImage image, VkImageView view, VkSampler sampler)
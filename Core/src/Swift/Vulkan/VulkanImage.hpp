@@ -6,6 +6,7 @@
 #include "Swift/Renderer/Image.hpp"
 #include "Swift/Renderer/Pipeline.hpp"
 #include "Swift/Renderer/Descriptors.hpp"
+#include "Swift/Renderer/UploadManager.hpp"
 
 #include <vulkan/vulkan.h>
 #include <vk_mem_alloc.h>
@@ -34,7 +35,7 @@ namespace Swift
 	class VulkanImage2D : public Image2D
 	{
 	public:
-		VulkanImage2D(const ImageSpecification& specs);
+		VulkanImage2D(const ImageSpecification& specs, bool async);
 		VulkanImage2D(const ImageSpecification& specs, const VulkanImageData& data);
 		virtual ~VulkanImage2D();
 
@@ -44,6 +45,10 @@ namespace Swift
 
 		void Upload(Ref<DescriptorSet> set, Descriptor element) override;
 		void Transition(ImageLayout initial, ImageLayout final) override;
+		void Transition(Ref<CommandBuffer> commandBuffer, ImageLayout initial, ImageLayout final) override;
+
+		void Release(Ref<CommandBuffer> commandBuffer, Queue from, Queue to, ImageLayout initial, ImageLayout final) override;
+		void Acquire(Ref<CommandBuffer> commandBuffer, Queue from, Queue to, ImageLayout initial, ImageLayout final) override;
 
 		// Helper function for swapchain
 		void SetImageData(const ImageSpecification& specs, const VulkanImageData& data);
@@ -52,6 +57,8 @@ namespace Swift
 		inline uint32_t GetWidth() const override { return m_Specification.Width; }
 		inline uint32_t GetHeight() const override { return m_Specification.Height; }
 
+		bool IsReady() const override;
+
 		VkFormat GetFormat() const;
 
 		inline VkImage GetVulkanImage() { return m_Data.Image; }
@@ -65,7 +72,11 @@ namespace Swift
 		void CreateImage(uint32_t width, uint32_t height);
 		void CreateImage(const std::filesystem::path& path);
 
-		void GenerateMipmaps(VkImage& image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels);
+		// Records the copy into the UploadManager's open batch, the image ends up in the specification's layout
+		UploadPoint Stage(void* data, size_t size);
+
+		void GenerateMipmaps(VkCommandBuffer commandBuffer, VkImage& image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels);
+		void TransferOwnership(Ref<CommandBuffer> commandBuffer, Queue from, Queue to, ImageLayout initial, ImageLayout final, bool acquire);
 
 	private:
 		ImageSpecification m_Specification = {};
@@ -73,6 +84,7 @@ namespace Swift
 		VulkanImageData m_Data = {};
 
 		uint32_t m_Miplevels = 1;
+		UploadPoint m_Upload = {};
 	};
 
 }
\ No newline at end of file
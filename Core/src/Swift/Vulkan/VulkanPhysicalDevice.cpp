@@ -55,28 +55,59 @@ namespace Swift
 		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
 		vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies.data());
 
-		int32_t i = 0;
+		// Note(Jorben): Every family has to be looked at, a dedicated compute family can come after the graphics one
+		std::optional<uint32_t> dedicatedCompute = {};
+		std::optional<uint32_t> anyCompute = {};
+		std::optional<uint32_t> dedicatedTransfer = {};
+
+		uint32_t i = 0;
 		for (const auto& queueFamily : queueFamilies)
 		{
-			// Early exit check
-			if (indices.IsComplete())
-				break;
+			bool graphics = queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT;
+			bool compute = queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT;
 
-			if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)
+			if (graphics && !indices.GraphicsFamily.has_value())
 				indices.GraphicsFamily = i;
 
-			if (queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT)
-				indices.ComputeFamily = i;
+			if (compute && !graphics && !dedicatedCompute.has_value())
+				dedicatedCompute = i;
+			if (compute && !anyCompute.has_value())
+				anyCompute = i;
 
+			// Note(Jorben): Only a family that can copy to any texel is used for uploads, image copies on others have to be aligned to its granularity
+			VkExtent3D granularity = queueFamily.minImageTransferGranularity;
+			bool transfer = (queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT) && granularity.width == 1 && granularity.height == 1 && granularity.depth == 1;
+			if (transfer && !graphics && !compute && !dedicatedTransfer.has_value())
+				dedicatedTransfer = i;
+
+			// Note(Jorben): Without a surface nothing gets presented, so the graphics queue takes the present queue's place
 			VkBool32 presentSupport = false;
 			VkSurfaceKHR& surface = ((VulkanRenderer*)Renderer::GetInstance())->GetVulkanSurface();
-			vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
-			if (presentSupport)
+			if (surface)
+				vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+			else
+				presentSupport = graphics ? VK_TRUE : VK_FALSE;
+
+			// Presenting from the graphics family is preferred, it saves an ownership transfer of the swapchain images
+			if (presentSupport && (!indices.PresentFamily.has_value() || indices.GraphicsFamily == i))
 				indices.PresentFamily = i;
 
 			i++;
 		}
 
+		// Note(Jorben): A compute family without graphics maps to the GPU's async compute engine(s), so its work can run alongside
+		// the graphics queue. Otherwise compute shares the graphics family (and VkQueue).
+		if (dedicatedCompute.has_value())
+			indices.ComputeFamily = dedicatedCompute;
+		else if (indices.GraphicsFamily.has_value() && (queueFamilies[indices.GraphicsFamily.value()].queueFlags & VK_QUEUE_COMPUTE_BIT))
+			indices.ComputeFamily = indices.GraphicsFamily;
+		else
+			indices.ComputeFamily = anyCompute;
+
+		// A transfer only family maps to the GPU's copy engine(s), uploads on it don't take time away from rendering.
+		// Otherwise uploads go through the graphics family, which every resource ends up on anyway.
+		indices.TransferFamily = (dedicatedTransfer.has_value() ? dedicatedTransfer : indices.GraphicsFamily);
+
 		return indices;
 	}
 
@@ -119,7 +150,11 @@ namespace Swift
 		bool extensionsSupported = ExtensionsSupported(device);
 		bool swapChainAdequate = false;
 
-		if (extensionsSupported)
+		if (((VulkanRenderer*)Renderer::GetInstance())->IsHeadless())
+		{
+			swapChainAdequate = true;
+		}
+		else if (extensionsSupported)
 		{
 			SwapChainSupportDetails swapChainSupport = SwapChainSupportDetails::Query(device);
 			swapChainAdequate = !swapChainSupport.Formats.empty() && !swapChainSupport.PresentModes.empty();
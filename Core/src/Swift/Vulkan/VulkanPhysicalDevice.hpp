@@ -17,11 +17,14 @@ namespace Swift
 		std::optional<uint32_t> GraphicsFamily;
 		std::optional<uint32_t> ComputeFamily;
 		std::optional<uint32_t> PresentFamily;
+		std::optional<uint32_t> TransferFamily;
 
 		static QueueFamilyIndices Find(const VkPhysicalDevice& device);
 
 	public:
 		inline bool IsComplete() const { return GraphicsFamily.has_value() && ComputeFamily.has_value() && PresentFamily.has_value(); }
+		inline bool HasAsyncCompute() const { return ComputeFamily != GraphicsFamily; }
+		inline bool HasAsyncTransfer() const { return TransferFamily != GraphicsFamily; }
 	};
 
 	struct SwapChainSupportDetails
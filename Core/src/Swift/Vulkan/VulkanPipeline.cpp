@@ -140,9 +140,9 @@ namespace Swift
 
 		VkPipelineDepthStencilStateCreateInfo depthStencil = {};
 		depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-		depthStencil.depthTestEnable = VK_TRUE;
-		depthStencil.depthWriteEnable = VK_TRUE;
-		depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
+		depthStencil.depthTestEnable = m_Specification.DepthTest ? VK_TRUE : VK_FALSE;
+		depthStencil.depthWriteEnable = m_Specification.DepthWrite ? VK_TRUE : VK_FALSE;
+		depthStencil.depthCompareOp = (VkCompareOp)m_Specification.DepthCompareOp;
 		depthStencil.depthBoundsTestEnable = VK_FALSE;
 		depthStencil.minDepthBounds = 0.0f; // Optional
 		depthStencil.maxDepthBounds = 1.0f; // Optional
@@ -166,8 +166,9 @@ namespace Swift
 		std::vector<VkDescriptorSetLayout> descriptorLayouts = { };
 		descriptorLayouts.reserve(vkDescriptorSets->m_DescriptorLayouts.size());
 
-		for (auto& pair : vkDescriptorSets->m_DescriptorLayouts)
-			descriptorLayouts.push_back(pair.second);
+		// Note(Jorben): The layouts have to be in order of their set ID, Dict doesn't guarantee any order
+		for (Descriptor::SetID setID = 0; setID < (Descriptor::SetID)vkDescriptorSets->m_DescriptorLayouts.size(); setID++)
+			descriptorLayouts.push_back(vkDescriptorSets->m_DescriptorLayouts[setID]);
 
 		VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
 		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
@@ -218,8 +219,9 @@ namespace Swift
 		std::vector<VkDescriptorSetLayout> descriptorLayouts;
 		descriptorLayouts.reserve(vkDescriptorSets->m_DescriptorLayouts.size());
 
-		for (auto& pair : vkDescriptorSets->m_DescriptorLayouts)
-			descriptorLayouts.push_back(pair.second);
+		// Note(Jorben): The layouts have to be in order of their set ID, Dict doesn't guarantee any order
+		for (Descriptor::SetID setID = 0; setID < (Descriptor::SetID)vkDescriptorSets->m_DescriptorLayouts.size(); setID++)
+			descriptorLayouts.push_back(vkDescriptorSets->m_DescriptorLayouts[setID]);
 
 		VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
 		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
@@ -0,0 +1,388 @@
+#include "swpch.h"
+#include "VulkanQueryManager.hpp"
+
+#include "Swift/Core/Logging.hpp"
+#include "Swift/Utils/Profiler.hpp"
+
+#include "Swift/Renderer/Renderer.hpp"
+
+#include "Swift/Vulkan/VulkanRenderer.hpp"
+#include "Swift/Vulkan/VulkanTaskManager.hpp"
+
+namespace Swift
+{
+
+	VulkanQueryManager::VulkanQueryManager()
+	{
+		auto renderer = (VulkanRenderer*)Renderer::GetInstance();
+		auto device = renderer->GetLogicalDevice();
+		auto physicalDevice = renderer->GetPhysicalDevice();
+
+		// Note(Jorben): Timestamps are written from the graphics & compute queues, which can be of different families
+		const QueueFamilyIndices& indices = device->GetQueueFamilies();
+
+		uint32_t queueFamilyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice->GetVulkanPhysicalDevice(), &queueFamilyCount, nullptr);
+		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice->GetVulkanPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+		uint32_t validBits = std::min(queueFamilies[indices.GraphicsFamily.value()].timestampValidBits, queueFamilies[indices.ComputeFamily.value()].timestampValidBits);
+		const VkPhysicalDeviceLimits& limits = physicalDevice->GetProperties().limits;
+
+		m_Supported = validBits > 0 && limits.timestampComputeAndGraphics;
+		m_StatisticsSupported = m_Supported && device->HasPipelineStatistics();
+		m_HostQueryReset = device->HasHostQueryReset();
+		m_AsyncCompute = device->HasAsyncCompute();
+
+		if (!m_Supported)
+		{
+			APP_LOG_WARN("GPU timings are not supported on this device.");
+			return;
+		}
+
+		m_TimestampPeriod = limits.timestampPeriod;
+		m_TimestampMask = (validBits >= 64 ? MAX_UINT64 : ((1ull << validBits) - 1ull));
+
+		m_Frames.resize((size_t)RendererSpecification::BufferCount);
+		for (auto& frame : m_Frames)
+		{
+			VkQueryPoolCreateInfo timestampInfo = {};
+			timestampInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+			timestampInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+			timestampInfo.queryCount = MaxScopes * 2;
+
+			if (vkCreateQueryPool(device->GetVulkanDevice(), &timestampInfo, nullptr, &frame.Timestamps) != VK_SUCCESS)
+				APP_LOG_ERROR("Failed to create timestamp query pool!");
+			if (m_HostQueryReset)
+				vkResetQueryPool(device->GetVulkanDevice(), frame.Timestamps, 0, timestampInfo.queryCount);
+
+			if (m_StatisticsSupported)
+			{
+				VkQueryPoolCreateInfo statisticsInfo = {};
+				statisticsInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+				statisticsInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+				statisticsInfo.queryCount = MaxScopes;
+				statisticsInfo.pipelineStatistics = VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT | VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT | VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+
+				if (vkCreateQueryPool(device->GetVulkanDevice(), &statisticsInfo, nullptr, &frame.Statistics) != VK_SUCCESS)
+					APP_LOG_ERROR("Failed to create pipeline statistics query pool!");
+				if (m_HostQueryReset)
+					vkResetQueryPool(device->GetVulkanDevice(), frame.Statistics, 0, statisticsInfo.queryCount);
+			}
+		}
+
+		if (!m_HostQueryReset || APP_GPU_PROFILING)
+		{
+			m_CollectCommandBuffers.resize((size_t)RendererSpecification::BufferCount);
+
+			VkCommandBufferAllocateInfo allocInfo = {};
+			allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			allocInfo.commandPool = renderer->GetSwapChain()->GetCommandPool();
+			allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			allocInfo.commandBufferCount = (uint32_t)m_CollectCommandBuffers.size();
+
+			if (vkAllocateCommandBuffers(device->GetVulkanDevice(), &allocInfo, m_CollectCommandBuffers.data()) != VK_SUCCESS)
+				APP_LOG_ERROR("Failed to allocate query command buffers!");
+		}
+
+	#if APP_GPU_PROFILING
+		// Note(Jorben): Creating the context submits the command buffer once and waits for the queue to be idle
+		m_TracyContext = TracyVkContext(physicalDevice->GetVulkanPhysicalDevice(), device->GetVulkanDevice(), device->GetGraphicsQueue(), m_CollectCommandBuffers[0]);
+		vkResetCommandBuffer(m_CollectCommandBuffers[0], 0);
+
+		const char contextName[] = "Graphics";
+		TracyVkContextName(m_TracyContext, contextName, (uint16_t)(sizeof(contextName) - 1));
+
+		if (m_AsyncCompute)
+		{
+			m_ComputeCollectCommandBuffers.resize((size_t)RendererSpecification::BufferCount);
+
+			VkCommandBufferAllocateInfo computeAllocInfo = {};
+			computeAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			computeAllocInfo.commandPool = renderer->GetSwapChain()->GetCommandPool(Queue::Compute);
+			computeAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			computeAllocInfo.commandBufferCount = (uint32_t)m_ComputeCollectCommandBuffers.size();
+
+			if (vkAllocateCommandBuffers(device->GetVulkanDevice(), &computeAllocInfo, m_ComputeCollectCommandBuffers.data()) != VK_SUCCESS)
+				APP_LOG_ERROR("Failed to allocate compute profiler command buffers!");
+
+			m_ComputeTracyContext = TracyVkContext(physicalDevice->GetVulkanPhysicalDevice(), device->GetVulkanDevice(), device->GetComputeQueue(), m_ComputeCollectCommandBuffers[0]);
+			vkResetCommandBuffer(m_ComputeCollectCommandBuffers[0], 0);
+
+			const char computeContextName[] = "Compute";
+			TracyVkContextName(m_ComputeTracyContext, computeContextName, (uint16_t)(sizeof(computeContextName) - 1));
+		}
+	#endif
+	}
+
+	VulkanQueryManager::~VulkanQueryManager()
+	{
+		auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice();
+
+		for (auto& frame : m_Frames)
+		{
+			vkDestroyQueryPool(device, frame.Timestamps, nullptr);
+			if (frame.Statistics)
+				vkDestroyQueryPool(device, frame.Statistics, nullptr);
+		}
+
+	#if APP_GPU_PROFILING
+		if (m_TracyContext)
+			TracyVkDestroy(m_TracyContext);
+		if (m_ComputeTracyContext)
+			TracyVkDestroy(m_ComputeTracyContext);
+
+		if (!m_ComputeCollectCommandBuffers.empty())
+			vkFreeCommandBuffers(device, ((VulkanRenderer*)Renderer::GetInstance())->GetSwapChain()->GetCommandPool(Queue::Compute), (uint32_t)m_ComputeCollectCommandBuffers.size(), m_ComputeCollectCommandBuffers.data());
+	#endif
+
+		if (!m_CollectCommandBuffers.empty())
+			vkFreeCommandBuffers(device, ((VulkanRenderer*)Renderer::GetInstance())->GetSwapChain()->GetCommandPool(), (uint32_t)m_CollectCommandBuffers.size(), m_CollectCommandBuffers.data());
+	}
+
+	uint32_t VulkanQueryManager::Begin(VkCommandBuffer commandBuffer, Queue queue, const std::string& name, TimingFlags flags, uint32_t depth)
+	{
+		if (!m_Supported)
+			return MAX_UINT32;
+
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+		Frame& frame = m_Frames[Renderer::GetCurrentFrame()];
+
+		if (frame.Scopes.size() >= MaxScopes)
+		{
+			APP_LOG_WARN("Exceeded the maximum amount of GPU timing scopes ({0}) in a frame, '{1}' won't be timed.", MaxScopes, name);
+			return MAX_UINT32;
+		}
+
+		uint32_t index = (uint32_t)frame.Scopes.size();
+		Scope& scope = frame.Scopes.emplace_back();
+		scope.Name = name;
+		scope.Depth = depth;
+		scope.Target = queue;
+
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.Timestamps, index * 2);
+
+	#if APP_GPU_PROFILING
+		TracyVkCtx context = ((queue == Queue::Compute && m_ComputeTracyContext) ? m_ComputeTracyContext : m_TracyContext);
+		if (context)
+			scope.Zone = std::make_unique<tracy::VkCtxScope>(context, (uint32_t)__LINE__, __FILE__, sizeof(__FILE__) - 1, __func__, sizeof(__func__) - 1, name.c_str(), name.size(), commandBuffer, true);
+	#endif
+
+		// Note(Jorben): The statistics pool also counts graphics invocations, which a compute only queue family can't query
+		bool statistics = m_StatisticsSupported && !(queue == Queue::Compute && m_AsyncCompute);
+		if ((flags & TimingFlags::PipelineStatistics) && statistics)
+		{
+			scope.StatisticsQuery = frame.StatisticsCount++;
+			vkCmdBeginQuery(commandBuffer, frame.Statistics, scope.StatisticsQuery, 0);
+		}
+
+		return index;
+	}
+
+	void VulkanQueryManager::End(VkCommandBuffer commandBuffer, uint32_t scope)
+	{
+		if (scope == MAX_UINT32)
+			return;
+
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+		Frame& frame = m_Frames[Renderer::GetCurrentFrame()];
+		Scope& entry = frame.Scopes[scope];
+
+		if (entry.StatisticsQuery != MAX_UINT32)
+			vkCmdEndQuery(commandBuffer, frame.Statistics, entry.StatisticsQuery);
+
+	#if APP_GPU_PROFILING
+		entry.Zone.reset(); // Writes the zone's end timestamp
+	#endif
+
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame.Timestamps, scope * 2 + 1);
+		entry.Ended = true;
+	}
+
+	void VulkanQueryManager::Resolve(uint32_t frameIndex)
+	{
+		APP_PROFILE_SCOPE("VulkanQueryManager::Resolve");
+
+		if (!m_Supported)
+			return;
+
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+		Frame& frame = m_Frames[frameIndex];
+
+		if (frame.Scopes.empty())
+			return;
+
+		VkDevice device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice();
+		const VkQueryResultFlags resultFlags = VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT;
+
+		// Note(Jorben): Every query is followed by its availability, so we never have to wait on the results
+		const uint32_t timestampCount = (uint32_t)frame.Scopes.size() * 2;
+		std::vector<uint64_t> timestamps((size_t)timestampCount * 2, 0);
+		vkGetQueryPoolResults(device, frame.Timestamps, 0, timestampCount, timestamps.size() * sizeof(uint64_t), timestamps.data(), sizeof(uint64_t) * 2, resultFlags);
+
+		// Vertex, Fragment, Compute & availability
+		std::vector<uint64_t> statistics((size_t)frame.StatisticsCount * 4, 0);
+		if (frame.StatisticsCount)
+			vkGetQueryPoolResults(device, frame.Statistics, 0, frame.StatisticsCount, statistics.size() * sizeof(uint64_t), statistics.data(), sizeof(uint64_t) * 4, resultFlags);
+
+		// Note(Jorben): Scopes with the same name are summed up
+		std::map<std::string, std::pair<float, PipelineStatistics>> results = { };
+		float total = 0.0f;
+
+		// Top level scopes as [begin, end] ticks per queue, for the async compute overlap
+		std::vector<std::pair<uint64_t, uint64_t>> graphicsIntervals = { };
+		std::vector<std::pair<uint64_t, uint64_t>> computeIntervals = { };
+
+		for (uint32_t i = 0; i < (uint32_t)frame.Scopes.size(); i++)
+		{
+			const Scope& scope = frame.Scopes[i];
+
+			const uint64_t* begin = &timestamps[(size_t)i * 4];
+			const uint64_t* end = &timestamps[(size_t)i * 4 + 2];
+			if (!scope.Ended || !begin[1] || !end[1])
+				continue;
+
+			uint64_t ticks = ((end[0] & m_TimestampMask) - (begin[0] & m_TimestampMask)) & m_TimestampMask;
+			float time = (float)((double)ticks * (double)m_TimestampPeriod / 1000000.0);
+
+			auto& result = results[scope.Name];
+			result.first += time;
+
+			if (scope.StatisticsQuery != MAX_UINT32 && statistics[(size_t)scope.StatisticsQuery * 4 + 3])
+			{
+				result.second.VertexInvocations += statistics[(size_t)scope.StatisticsQuery * 4 + 0];
+				result.second.FragmentInvocations += statistics[(size_t)scope.StatisticsQuery * 4 + 1];
+				result.second.ComputeInvocations += statistics[(size_t)scope.StatisticsQuery * 4 + 2];
+			}
+
+			if (scope.Depth == 0)
+			{
+				total += time;
+
+				auto& intervals = (scope.Target == Queue::Compute ? computeIntervals : graphicsIntervals);
+				intervals.emplace_back(begin[0] & m_TimestampMask, end[0] & m_TimestampMask);
+			}
+		}
+
+		RenderData& data = Renderer::GetRenderData();
+		for (auto& [name, result] : results)
+		{
+			GPUTiming& timing = data.Timings[name];
+			timing.AddSample(result.first);
+			timing.Statistics = result.second;
+		}
+		data.GPUTime = total;
+
+		data.AsyncComputeOverlap = (m_AsyncCompute ? (float)((double)GetOverlap(graphicsIntervals, computeIntervals) * (double)m_TimestampPeriod / 1000000.0) : 0.0f);
+		APP_PROFILE_PLOT("Async compute overlap (ms)", data.AsyncComputeOverlap);
+
+		if (m_HostQueryReset)
+		{
+			vkResetQueryPool(device, frame.Timestamps, 0, timestampCount);
+			if (frame.StatisticsCount)
+				vkResetQueryPool(device, frame.Statistics, 0, frame.StatisticsCount);
+		}
+
+		frame.Scopes.clear();
+		frame.StatisticsCount = 0;
+	}
+
+	void VulkanQueryManager::Collect(uint32_t frame)
+	{
+		APP_PROFILE_SCOPE("VulkanQueryManager::Collect");
+
+		bool reset = m_Supported && !m_HostQueryReset;
+		bool collect = false;
+	#if APP_GPU_PROFILING
+		collect = (m_TracyContext != nullptr);
+	#endif
+
+		if (!reset && !collect)
+			return;
+
+		VkCommandBuffer commandBuffer = m_CollectCommandBuffers[frame];
+
+		// Note(Jorben): The previous submission of this frame's command buffer has finished, since its timeline value was waited on in BeginFrame
+		vkResetCommandBuffer(commandBuffer, 0);
+
+		VkCommandBufferBeginInfo beginInfo = {};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+		vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+		if (reset)
+		{
+			// Note(Jorben): Resets the whole pools, the results of the last use were read back in Resolve
+			vkCmdResetQueryPool(commandBuffer, m_Frames[frame].Timestamps, 0, MaxScopes * 2);
+			if (m_Frames[frame].Statistics)
+				vkCmdResetQueryPool(commandBuffer, m_Frames[frame].Statistics, 0, MaxScopes);
+		}
+
+	#if APP_GPU_PROFILING
+		if (collect)
+			TracyVkCollect(m_TracyContext, commandBuffer);
+	#endif
+
+		vkEndCommandBuffer(commandBuffer);
+
+		// Note(Jorben): Goes out with the rest of the frame's graphics work. Every sequence command buffer
+		// (on any queue) waits on it when the pools are reset here, so no timestamp is written before the reset.
+		TimelinePoint point = VulkanTaskManager::Enqueue(Queue::Graphics, commandBuffer);
+		if (reset)
+			VulkanTaskManager::SetLastSequence(point);
+
+	#if APP_GPU_PROFILING
+		if (m_ComputeTracyContext)
+		{
+			VkCommandBuffer computeCommandBuffer = m_ComputeCollectCommandBuffers[frame];
+			vkResetCommandBuffer(computeCommandBuffer, 0);
+
+			vkBeginCommandBuffer(computeCommandBuffer, &beginInfo);
+			TracyVkCollect(m_ComputeTracyContext, computeCommandBuffer);
+			vkEndCommandBuffer(computeCommandBuffer);
+
+			VulkanTaskManager::Enqueue(Queue::Compute, computeCommandBuffer);
+		}
+	#endif
+	}
+
+	uint64_t VulkanQueryManager::GetOverlap(std::vector<std::pair<uint64_t, uint64_t>>& graphics, const std::vector<std::pair<uint64_t, uint64_t>>& compute)
+	{
+		if (graphics.empty() || compute.empty())
+			return 0;
+
+		// Note(Jorben): Graphics scopes are merged first, so compute work isn't counted twice under overlapping graphics scopes
+		std::sort(graphics.begin(), graphics.end());
+
+		size_t merged = 0;
+		for (size_t i = 1; i < graphics.size(); i++)
+		{
+			if (graphics[i].first <= graphics[merged].second)
+				graphics[merged].second = std::max(graphics[merged].second, graphics[i].second);
+			else
+				graphics[++merged] = graphics[i];
+		}
+		graphics.resize(merged + 1);
+
+		uint64_t overlap = 0;
+		for (auto& [computeBegin, computeEnd] : compute)
+		{
+			for (auto& [graphicsBegin, graphicsEnd] : graphics)
+			{
+				uint64_t begin = std::max(computeBegin, graphicsBegin);
+				uint64_t end = std::min(computeEnd, graphicsEnd);
+				if (end > begin)
+					overlap += end - begin;
+			}
+		}
+
+		return overlap;
+	}
+
+	Ref<VulkanQueryManager> VulkanQueryManager::Create()
+	{
+		return RefHelper::Create<VulkanQueryManager>();
+	}
+
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Swift/Core/Core.hpp"
+#include "Swift/Utils/Utils.hpp"
+
+#include "Swift/Utils/Profiler.hpp"
+
+#include "Swift/Renderer/CommandBuffer.hpp"
+
+#include <vulkan/vulkan.h>
+
+#if APP_GPU_PROFILING
+#include <tracy/TracyVulkan.hpp>
+#endif
+
+namespace Swift
+{
+
+	// Owns a timestamp (and optionally a pipeline statistics) query pool per frame in flight.
+	// Results are read back without waiting, right after the frame's timeline values have been waited on in BeginFrame.
+	// Without hostQueryReset the pools are reset on the GPU, at the start of the frame's first graphics command buffer.
+	// Note(Jorben): Timestamps of every queue come from the same device clock, which is what the async compute overlap relies on.
+	// When profiling is enabled every scope is also emitted as a Tracy GPU zone, in the context of the queue it was recorded for.
+	class VulkanQueryManager
+	{
+	public:
+		inline static constexpr const uint32_t MaxScopes = 64;
+
+		VulkanQueryManager();
+		virtual ~VulkanQueryManager();
+
+		// Returns the scope's index in the current frame, or MAX_UINT32 if it can't be timed
+		uint32_t Begin(VkCommandBuffer commandBuffer, Queue queue, const std::string& name, TimingFlags flags, uint32_t depth);
+		void End(VkCommandBuffer commandBuffer, uint32_t scope);
+
+		// Note(Jorben): Only call this once the frame's timeline values have been reached
+		void Resolve(uint32_t frame);
+		// Resets the frame's query pools on the GPU (without hostQueryReset) and hands finished Tracy GPU zones to the profiler.
+		// Note(Jorben): Has to be called right after Resolve, before anything else of the frame is submitted
+		void Collect(uint32_t frame);
+
+		inline bool IsSupported() const { return m_Supported; }
+
+		static Ref<VulkanQueryManager> Create();
+
+	private:
+		struct Scope
+		{
+		public:
+			std::string Name = {};
+			uint32_t Depth = 0;
+			Queue Target = Queue::Graphics;
+			uint32_t StatisticsQuery = MAX_UINT32;
+			bool Ended = false;
+
+		#if APP_GPU_PROFILING
+			std::unique_ptr<tracy::VkCtxScope> Zone = nullptr;
+		#endif
+		};
+
+		struct Frame
+		{
+		public:
+			VkQueryPool Timestamps = VK_NULL_HANDLE;
+			VkQueryPool Statistics = VK_NULL_HANDLE;
+
+			std::vector<Scope> Scopes = { };
+			uint32_t StatisticsCount = 0;
+		};
+
+	private:
+		// Ticks in which compute scopes ran while a graphics scope was running as well
+		static uint64_t GetOverlap(std::vector<std::pair<uint64_t, uint64_t>>& graphics, const std::vector<std::pair<uint64_t, uint64_t>>& compute);
+
+	private:
+		std::mutex m_Mutex = {};
+		std::vector<Frame> m_Frames = { };
+
+		bool m_Supported = false;
+		bool m_StatisticsSupported = false;
+		bool m_HostQueryReset = false;
+		bool m_AsyncCompute = false;
+
+		float m_TimestampPeriod = 1.0f; // Nanoseconds per tick
+		uint64_t m_TimestampMask = MAX_UINT64;
+
+		// Note(Jorben): Tracy & the pool resets (without hostQueryReset) need a command buffer, so we submit a tiny one per frame
+		std::vector<VkCommandBuffer> m_CollectCommandBuffers = { };
+
+	#if APP_GPU_PROFILING
+		TracyVkCtx m_TracyContext = nullptr;
+
+		// Note(Jorben): Only with a compute queue family of its own, every context is calibrated against its own queue
+		TracyVkCtx m_ComputeTracyContext = nullptr;
+		std::vector<VkCommandBuffer> m_ComputeCollectCommandBuffers = { };
+	#endif
+	};
+
+}
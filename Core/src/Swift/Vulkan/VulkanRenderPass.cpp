@@ -3,6 +3,8 @@
 
 #include "Swift/Core/Logging.hpp"
 #include "Swift/Core/Application.hpp"
+#include "Swift/Utils/Profiler.hpp"
+#include "Swift/Utils/JobSystem.hpp"
 
 #include "Swift/Renderer/Renderer.hpp"
 
@@ -31,9 +33,12 @@ namespace Swift
         Destroy();
     }
 
-    void VulkanRenderPass::Begin()
+    void VulkanRenderPass::Begin(RenderPassContents contents)
     {
-        m_CommandBuffer->Begin();
+        m_Contents = contents;
+        m_OwnsRecording = !m_CommandBuffer->IsRecording();
+        if (m_OwnsRecording)
+            m_CommandBuffer->Begin();
 
         auto renderer = (VulkanRenderer*)Renderer::GetInstance();
         VkExtent2D extent = { Application::Get().GetWindow().GetWidth(), Application::Get().GetWindow().GetHeight() };
@@ -60,6 +65,13 @@ namespace Swift
         renderPassInfo.clearValueCount = (uint32_t)clearValues.size();
         renderPassInfo.pClearValues = clearValues.data();
 
+        if (m_Contents == RenderPassContents::Secondary)
+        {
+            // Note(Jorben): Nothing but vkCmdExecuteCommands may be recorded into the primary, the secondaries set their own viewport & scissor
+            vkCmdBeginRenderPass(m_CommandBuffer->GetVulkanCommandBuffer(Renderer::GetCurrentFrame()), &renderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+            return;
+        }
+
         vkCmdBeginRenderPass(m_CommandBuffer->GetVulkanCommandBuffer(Renderer::GetCurrentFrame()), &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 
         VkViewport viewport = {};
@@ -82,7 +94,67 @@ namespace Swift
         auto renderer = (VulkanRenderer*)Renderer::GetInstance();
         vkCmdEndRenderPass(m_CommandBuffer->GetVulkanCommandBuffer(Renderer::GetCurrentFrame()));
 
-        m_CommandBuffer->End();
+        // Note(Jorben): The renderpass transitions the attachments itself, so we keep track of it for later barriers
+        for (auto& attachment : m_Specification.ColourAttachment)
+            attachment->GetSpecification().Layout = m_Specification.FinalColourImageLayout;
+        if (m_Specification.DepthAttachment)
+            m_Specification.DepthAttachment->GetSpecification().Layout = m_Specification.FinalDepthImageLayout;
+
+        if (m_OwnsRecording)
+            m_CommandBuffer->End();
+    }
+
+    void VulkanRenderPass::RecordParallel(uint32_t count, RecordFunction function)
+    {
+        APP_PROFILE_SCOPE("VulkanRenderPass::RecordParallel");
+
+        if (m_Contents != RenderPassContents::Secondary)
+        {
+            APP_LOG_ERROR("RecordParallel can only be used after Begin(RenderPassContents::Secondary).");
+            return;
+        }
+        if (count == 0)
+            return;
+
+        auto renderer = (VulkanRenderer*)Renderer::GetInstance();
+        VkFramebuffer framebuffer = m_Framebuffers[renderer->GetSwapChain()->GetAquiredImage()];
+        VkExtent2D extent = { Application::Get().GetWindow().GetWidth(), Application::Get().GetWindow().GetHeight() };
+
+        // Note(Jorben): Every batch is one contiguous range, so executing the secondaries in order keeps the draw order
+        uint32_t batches = std::min(RendererSpecification::RecordingThreads, (count + RendererSpecification::MinRecordBatch - 1) / RendererSpecification::MinRecordBatch);
+        uint32_t batchSize = (count + batches - 1) / batches;
+
+        // Note(Jorben): Secondaries are only allocated once a pass records in parallel, and only as many as it has used batches
+        for (uint32_t i = (uint32_t)m_SecondaryCommandBuffers.size(); i < batches; i++)
+        {
+            CommandBufferSpecification secondarySpecs = {};
+            secondarySpecs.Usage = CommandBufferUsage::Secondary;
+            secondarySpecs.Thread = i;
+
+            m_SecondaryCommandBuffers.push_back(RefHelper::Create<VulkanCommandBuffer>(secondarySpecs));
+        }
+
+        std::vector<VkCommandBuffer> secondaries(batches);
+        for (uint32_t i = 0; i < batches; i++)
+            secondaries[i] = m_SecondaryCommandBuffers[i]->GetVulkanCommandBuffer(Renderer::GetCurrentFrame());
+
+        // Note(Jorben): Every batch owns secondary command buffer (and thread pool) i, no matter which worker records it
+        JobHandle recording = JobSystem::ParallelFor(batches, 1, [this, framebuffer, extent, count, batchSize, &function](uint32_t batch, uint32_t)
+        {
+            APP_PROFILE_SCOPE("VulkanRenderPass::RecordParallel::Record");
+
+            uint32_t first = batch * batchSize;
+            uint32_t amount = (first < count) ? std::min(batchSize, count - first) : 0;
+
+            Ref<VulkanCommandBuffer> secondary = m_SecondaryCommandBuffers[batch];
+            secondary->BeginSecondary(m_RenderPass, framebuffer, extent);
+            if (amount)
+                function(secondary, first, amount);
+            secondary->End();
+        });
+        JobSystem::Wait(recording);
+
+        vkCmdExecuteCommands(m_CommandBuffer->GetVulkanCommandBuffer(Renderer::GetCurrentFrame()), (uint32_t)secondaries.size(), secondaries.data());
     }
 
     void VulkanRenderPass::Submit(const std::vector<Ref<CommandBuffer>>& waitOn)
@@ -207,9 +279,10 @@ namespace Swift
         std::array<VkSubpassDependency, 2> dependencies = { };
         dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
         dependencies[0].dstSubpass = 0;
-        dependencies[0].srcStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        // Note(Jorben): Waits on the colour writes of the previous pass on the same image (the acquire semaphore waits at this stage as well)
+        dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
         dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-        dependencies[0].srcAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+        dependencies[0].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
         dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
         dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
 
@@ -221,6 +294,25 @@ namespace Swift
         dependencies[1].dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
         dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
 
+        // Note(Jorben): When the depth gets loaded (after a pre-pass) the fragment tests have to wait on previous depth writes/reads.
+        // The read only depth layout is also sampled from shaders (light culling), those reads have to finish before the layout changes back.
+        // Compute isn't framebuffer local, so this dependency can't be by region.
+        if (m_Specification.DepthAttachment)
+        {
+            dependencies[0].srcStageMask |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+            dependencies[0].srcAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            dependencies[0].dstStageMask |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            dependencies[0].dstAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            dependencies[0].dependencyFlags = 0;
+
+            // Note(Jorben): A read only final layout gets sampled afterwards (the heatmap), so those reads wait on the transition
+            dependencies[1].srcStageMask |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            dependencies[1].srcAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            dependencies[1].dstStageMask |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+            dependencies[1].dstAccessMask |= VK_ACCESS_SHADER_READ_BIT;
+            dependencies[1].dependencyFlags = 0;
+        }
+
         VkRenderPassCreateInfo renderPassInfo = {};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
         renderPassInfo.attachmentCount = (uint32_t)attachments.size();
@@ -21,10 +21,12 @@ namespace Swift
 		VulkanRenderPass(RenderPassSpecification specs, Ref<CommandBuffer> commandBuffer);
 		virtual ~VulkanRenderPass();
 
-		void Begin() override;
+		void Begin(RenderPassContents contents = RenderPassContents::Inline) override;
 		void End() override;
 		void Submit(const std::vector<Ref<CommandBuffer>>& waitOn) override;
 
+		void RecordParallel(uint32_t count, RecordFunction function) override;
+
 		void Resize(uint32_t width, uint32_t height) override;
 
 		inline RenderPassSpecification& GetSpecification() override { return m_Specification; }
@@ -41,6 +43,10 @@ namespace Swift
 		RenderPassSpecification m_Specification = {};
 
 		Ref<VulkanCommandBuffer> m_CommandBuffer = VK_NULL_HANDLE;
+		std::vector<Ref<VulkanCommandBuffer>> m_SecondaryCommandBuffers = { }; // One per recording thread, allocated by RecordParallel
+
+		RenderPassContents m_Contents = RenderPassContents::Inline;
+		bool m_OwnsRecording = false; // Whether Begin() also began the command buffer
 
 		VkRenderPass m_RenderPass = VK_NULL_HANDLE;
 		std::vector<VkFramebuffer> m_Framebuffers = { };
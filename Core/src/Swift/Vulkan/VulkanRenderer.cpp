@@ -2,6 +2,7 @@
 #include "VulkanRenderer.hpp"
 
 #include "Swift/Core/Application.hpp"
+#include "Swift/Utils/Mesh.hpp"
 #include "Swift/Utils/Profiler.hpp"
 
 #include "Swift/Renderer/Renderer.hpp"
@@ -61,11 +62,36 @@ namespace Swift
 	{
 		Wait();
 
+		// Note(Jorben): Unexecuted commands can hold the last reference to resources, which free themselves through the free stream
+		m_Pipeline.Clear();
+
 		m_SwapChain->GetSwapChainImages().clear(); // TODO: Find a better way to do this
 		m_SwapChain->GetDepthImage().reset(); // TODO: Find a better way to do this
-		m_ResourceFreeQueue.Execute();
+		m_UploadRing.reset();
+		m_QueryManager.reset();
+		m_GeometryPool.reset();
+
+		// Note(Jorben): Runs the last callbacks, which can release resources into the free streams
+		m_UploadManager->Wait();
+		m_UploadManager.reset();
+
+		// Note(Jorben): The device is idle, so everything can go. Freeing a resource can release others, which might end up in any of the streams.
+		bool pending = true;
+		while (pending)
+		{
+			pending = false;
+			for (auto& stream : m_ResourceFreeStreams)
+			{
+				if (stream.Empty())
+					continue;
+
+				stream.Execute();
+				pending = true;
+			}
+		}
 		
 		m_SwapChain.reset();
+		VulkanTaskManager::Destroy();
 		VulkanAllocator::Destroy(); 
 
 		m_Device.reset();
@@ -73,12 +99,15 @@ namespace Swift
 		if constexpr (s_Validation)
 			DestroyDebugUtilsMessengerEXT(m_VulkanInstance, m_DebugMessenger, nullptr);
 
-		vkDestroySurfaceKHR(m_VulkanInstance, m_Surface, nullptr);
+		if (m_Surface)
+			vkDestroySurfaceKHR(m_VulkanInstance, m_Surface, nullptr);
 		vkDestroyInstance(m_VulkanInstance, nullptr);
 	}
 
 	void VulkanRenderer::Init()
 	{
+		m_Headless = Application::Get().GetWindow().IsHeadless();
+
 		/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 		// Instance Creation
 		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -96,7 +125,12 @@ namespace Swift
 			#define VK_KHR_WIN32_SURFACE_EXTENSION_NAME "VK_KHR_xcb_surface"
 		#endif
 
-		std::vector<const char*> instanceExtensions = { VK_KHR_SURFACE_EXTENSION_NAME, VK_KHR_WIN32_SURFACE_EXTENSION_NAME };
+		std::vector<const char*> instanceExtensions = { };
+		if (!m_Headless)
+		{
+			instanceExtensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+			instanceExtensions.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
+		}
 		if constexpr (s_Validation)
 		{
 			instanceExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME); // Very little performance hit, can be used in Release.
@@ -158,9 +192,13 @@ namespace Swift
 		/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 		// Surface Creation
 		/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-		GLFWwindow* handle = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
-		if (glfwCreateWindowSurface(m_VulkanInstance, handle, nullptr, &m_Surface) != VK_SUCCESS)
-			APP_LOG_ERROR("Failed to create window surface!");
+		// Note(Jorben): When headless there is no surface, the swapchain renders into offscreen images instead
+		if (!m_Headless)
+		{
+			GLFWwindow* handle = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
+			if (glfwCreateWindowSurface(m_VulkanInstance, handle, nullptr, &m_Surface) != VK_SUCCESS)
+				APP_LOG_ERROR("Failed to create window surface!");
+		}
 
 		/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 		// Other
@@ -170,8 +208,14 @@ namespace Swift
 
 		VulkanAllocator::Init();
 		auto& window = Application::Get().GetWindow();
+		VulkanTaskManager::Init();
+		m_UploadManager = UploadManager::Create(RendererSpecification::StagingRingSize);
+		m_GeometryPool = GeometryPool::Create(sizeof(MeshVertex), RendererSpecification::GeometryPoolVertices, RendererSpecification::GeometryPoolIndices);
 		m_SwapChain = VulkanSwapChain::Create(m_VulkanInstance, m_Device);
 		m_SwapChain->Init(window.GetWidth(), window.GetHeight(), window.IsVSync());
+
+		m_UploadRing = FrameUploadRing::Create(RendererSpecification::UploadRingSize);
+		m_QueryManager = VulkanQueryManager::Create();
 	}
 
 	void VulkanRenderer::BeginFrame()
@@ -180,74 +224,136 @@ namespace Swift
 			return;
 
 		Renderer::GetRenderData().Reset();
-		m_ResourceFreeQueue.Execute();
 
-		auto& fences = VulkanTaskManager::GetFences();
-		if (!fences.empty())
+		// Note(Jorben): A single wait on the last value every queue signalled when this frame index was last used
+		VulkanTaskManager::WaitForFrame(GetCurrentFrame());
+
+		// Note(Jorben): Everything released while this frame index was last in use can only have been used by that frame
+		// (or earlier ones), which is done now. Resources released from here on are kept until this index comes around again.
 		{
-			vkWaitForFences(m_Device->GetVulkanDevice(), (uint32_t)fences.size(), fences.data(), VK_TRUE, MAX_UINT64);
-			vkResetFences(m_Device->GetVulkanDevice(), (uint32_t)fences.size(), fences.data());
+			APP_PROFILE_SCOPE("ResourceFreeStream");
+			m_ResourceFreeStreams[GetCurrentFrame()].Execute();
+			m_FreeFrame.store(GetCurrentFrame(), std::memory_order_release);
 		}
-		VulkanTaskManager::AddSemaphore(m_SwapChain->GetCurrentImageAvailableSemaphore());
+
+		// Note(Jorben): Submits what was staged since the last frame and hands out the uploads that finished
+		m_UploadManager->Poll();
+
+		// Note(Jorben): The GPU is done with this frame's copy, so everything can be thrown away
+		m_UploadRing->Reset();
+		m_SwapChain->ResetThreadCommandPools(GetCurrentFrame());
+		m_QueryManager->Resolve(GetCurrentFrame());
+		m_QueryManager->Collect(GetCurrentFrame());
+
+		if (!m_Headless)
+			VulkanTaskManager::SetImageAvailable(m_SwapChain->GetCurrentImageAvailableSemaphore());
 
 		m_SwapChain->BeginFrame();
 	}
 
 	void VulkanRenderer::EndFrame() // A.k.a Display/Present
 	{
+		// Note(Jorben): A minimized frame is never executed, keeping its commands around would replay them all at once later
 		if (Application::Get().IsMinimized())
+		{
+			m_Pipeline.GetRenderStream().Clear();
+			m_Pipeline.GetUIStream().Clear();
 			return;
+		}
 
 		{
-			APP_PROFILE_SCOPE("RenderQueue");
-			m_RenderQueue.Execute();
+			APP_PROFILE_SCOPE("RenderStream");
+			m_Pipeline.GetRenderStream().Execute();
 		}
 		{
-			APP_PROFILE_SCOPE("UIQueue");
-			BaseImGuiLayer::Get()->Begin();
-			m_UIQueue.Execute();
-			BaseImGuiLayer::Get()->End();
+			APP_PROFILE_SCOPE("UIStream");
+			if (BaseImGuiLayer::Get())
+			{
+				BaseImGuiLayer::Get()->Begin();
+				m_Pipeline.GetUIStream().Execute();
+				BaseImGuiLayer::Get()->End();
+			}
+			else
+			{
+				m_Pipeline.GetUIStream().Clear();
+			}
 		}
 
 		m_SwapChain->EndFrame();
 	}
 
-	void VulkanRenderer::Submit(RenderFunction function)
+	void VulkanRenderer::Wait()
 	{
-		m_RenderQueue.Add(function);
+		std::scoped_lock<std::mutex> lock(m_Device->GetQueueMutex());
+		vkDeviceWaitIdle(m_Device->GetVulkanDevice());
 	}
 
-	void VulkanRenderer::SubmitFree(FreeFunction function)
+	void VulkanRenderer::Draw(Ref<CommandBuffer> commandBuffer, uint32_t verticeCount)
 	{
-		m_ResourceFreeQueue.Add(function);
+		APP_PROFILE_SCOPE("VulkanRenderer::Draw");
+		Renderer::GetRenderData().DrawCalls++;
+
+		auto cmdBuf = RefHelper::RefAs<VulkanCommandBuffer>(commandBuffer);
+		vkCmdDraw(cmdBuf->GetVulkanCommandBuffer(m_SwapChain->GetCurrentFrame()), verticeCount, 1, 0, 0);
 	}
 
-	void VulkanRenderer::SubmitUI(UIFunction function)
+	void VulkanRenderer::DrawIndexed(Ref<CommandBuffer> commandBuffer, Ref<IndexBuffer> indexBuffer, uint32_t instanceCount, uint32_t firstInstance)
 	{
-		m_UIQueue.Add(function);
+		APP_PROFILE_SCOPE("VulkanRenderer::DrawIndexed");
+		Renderer::GetRenderData().DrawCalls++;
+
+		auto cmdBuf = RefHelper::RefAs<VulkanCommandBuffer>(commandBuffer);
+		vkCmdDrawIndexed(cmdBuf->GetVulkanCommandBuffer(m_SwapChain->GetCurrentFrame()), indexBuffer->GetCount(), instanceCount, 0, 0, firstInstance);
 	}
 
-	void VulkanRenderer::Wait()
+	void VulkanRenderer::DrawIndexed(Ref<CommandBuffer> commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
 	{
-		vkDeviceWaitIdle(m_Device->GetVulkanDevice());
+		APP_PROFILE_SCOPE("VulkanRenderer::DrawIndexed");
+		Renderer::GetRenderData().DrawCalls++;
+
+		auto cmdBuf = RefHelper::RefAs<VulkanCommandBuffer>(commandBuffer);
+		vkCmdDrawIndexed(cmdBuf->GetVulkanCommandBuffer(m_SwapChain->GetCurrentFrame()), indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 	}
 
-	void VulkanRenderer::Draw(Ref<CommandBuffer> commandBuffer, uint32_t verticeCount)
+	void VulkanRenderer::DrawIndexedIndirect(Ref<CommandBuffer> commandBuffer, Ref<IndirectBuffer> buffer, uint32_t drawCount, uint32_t firstDraw)
 	{
-		APP_PROFILE_SCOPE("VulkanRenderer::Draw");
+		APP_PROFILE_SCOPE("VulkanRenderer::DrawIndexedIndirect");
 		Renderer::GetRenderData().DrawCalls++;
 
-		auto cmdBuf = RefHelper::RefAs<VulkanCommandBuffer>(commandBuffer);
-		vkCmdDraw(cmdBuf->GetVulkanCommandBuffer(m_SwapChain->GetCurrentFrame()), verticeCount, 1, 0, 0);
+		uint32_t frame = m_SwapChain->GetCurrentFrame();
+		VkCommandBuffer cmdBuf = RefHelper::RefAs<VulkanCommandBuffer>(commandBuffer)->GetVulkanCommandBuffer(frame);
+		VkBuffer vkBuffer = RefHelper::RefAs<VulkanIndirectBuffer>(buffer)->GetVulkanBuffer(frame);
+
+		const uint32_t stride = (uint32_t)sizeof(VkDrawIndexedIndirectCommand);
+		VkDeviceSize offset = (VkDeviceSize)(IndirectBuffer::CommandOffset + (size_t)stride * firstDraw);
+
+		if (m_Device->HasMultiDrawIndirect())
+		{
+			vkCmdDrawIndexedIndirect(cmdBuf, vkBuffer, offset, drawCount, stride);
+			return;
+		}
+
+		// Note(Jorben): Without multiDrawIndirect the drawCount has to be 0 or 1
+		for (uint32_t i = 0; i < drawCount; i++)
+			vkCmdDrawIndexedIndirect(cmdBuf, vkBuffer, offset + (VkDeviceSize)stride * i, 1, stride);
 	}
 
-	void VulkanRenderer::DrawIndexed(Ref<CommandBuffer> commandBuffer, Ref<IndexBuffer> indexBuffer)
+	void VulkanRenderer::DrawIndexedIndirectCount(Ref<CommandBuffer> commandBuffer, Ref<IndirectBuffer> buffer, uint32_t maxDrawCount)
 	{
-		APP_PROFILE_SCOPE("VulkanRenderer::DrawIndexed");
+		if (!m_Device->HasDrawIndirectCount())
+		{
+			DrawIndexedIndirect(commandBuffer, buffer, maxDrawCount, 0);
+			return;
+		}
+
+		APP_PROFILE_SCOPE("VulkanRenderer::DrawIndexedIndirectCount");
 		Renderer::GetRenderData().DrawCalls++;
 
-		auto cmdBuf = RefHelper::RefAs<VulkanCommandBuffer>(commandBuffer);
-		vkCmdDrawIndexed(cmdBuf->GetVulkanCommandBuffer(m_SwapChain->GetCurrentFrame()), indexBuffer->GetCount(), 1, 0, 0, 0);
+		uint32_t frame = m_SwapChain->GetCurrentFrame();
+		VkCommandBuffer cmdBuf = RefHelper::RefAs<VulkanCommandBuffer>(commandBuffer)->GetVulkanCommandBuffer(frame);
+		VkBuffer vkBuffer = RefHelper::RefAs<VulkanIndirectBuffer>(buffer)->GetVulkanBuffer(frame);
+
+		vkCmdDrawIndexedIndirectCount(cmdBuf, vkBuffer, (VkDeviceSize)IndirectBuffer::CommandOffset, vkBuffer, 0, maxDrawCount, (uint32_t)sizeof(VkDrawIndexedIndirectCommand));
 	}
 
 	void VulkanRenderer::OnResize(uint32_t width, uint32_t height)
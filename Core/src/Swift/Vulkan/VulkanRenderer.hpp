@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <mutex>
+#include <atomic>
 #include <vector>
 
 #include <vulkan/vulkan.h>
@@ -9,10 +11,15 @@
 #include "Swift/Utils/Utils.hpp"
 
 #include "Swift/Renderer/RenderInstance.hpp"
+#include "Swift/Renderer/FramePipeline.hpp"
+#include "Swift/Renderer/FrameUploadRing.hpp"
+#include "Swift/Renderer/UploadManager.hpp"
+#include "Swift/Renderer/GeometryPool.hpp"
 
 #include "Swift/Vulkan/VulkanDevice.hpp"
 #include "Swift/Vulkan/VulkanPhysicalDevice.hpp"
 #include "Swift/Vulkan/VulkanSwapChain.hpp"
+#include "Swift/Vulkan/VulkanQueryManager.hpp"
 
 namespace Swift
 {
@@ -37,45 +44,58 @@ namespace Swift
 		void BeginFrame() override;
 		void EndFrame() override;
 
-		void Submit(RenderFunction function) override;
-		void SubmitFree(FreeFunction function) override;
-		void SubmitUI(UIFunction function) override;
-
 		void Wait() override;
 
 		void Draw(Ref<CommandBuffer> commandBuffer, uint32_t verticeCount) override;
-		void DrawIndexed(Ref<CommandBuffer> commandBuffer, Ref<IndexBuffer> indexBuffer) override;
+		void DrawIndexed(Ref<CommandBuffer> commandBuffer, Ref<IndexBuffer> indexBuffer, uint32_t instanceCount, uint32_t firstInstance) override;
+		void DrawIndexed(Ref<CommandBuffer> commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) override;
+		void DrawIndexedIndirect(Ref<CommandBuffer> commandBuffer, Ref<IndirectBuffer> buffer, uint32_t drawCount, uint32_t firstDraw) override;
+		void DrawIndexedIndirectCount(Ref<CommandBuffer> commandBuffer, Ref<IndirectBuffer> buffer, uint32_t maxDrawCount) override;
 
 		void OnResize(uint32_t width, uint32_t height) override;
 
-		inline Utils::Queue<RenderFunction>& GetRenderQueue() override { return m_RenderQueue; }
-		inline Utils::Queue<FreeFunction>& GetFreeQueue() override { return m_ResourceFreeQueue; }
+		inline FramePipeline& GetPipeline() override { return m_Pipeline; }
+		inline CommandStream& GetFreeStream() override { return m_ResourceFreeStreams[m_FreeFrame.load(std::memory_order_acquire)]; }
 
 		inline uint32_t GetCurrentFrame() const override { return m_SwapChain->GetCurrentFrame(); }
 		inline std::vector<Ref<Image2D>>& GetSwapChainImages() { return m_SwapChain->GetSwapChainImages(); }
 		inline Ref<Image2D> GetDepthImage() { return m_SwapChain->GetDepthImage(); }
+		inline Ref<FrameUploadRing> GetUploadRing() override { return m_UploadRing; }
+		inline Ref<UploadManager> GetUploadManager() override { return m_UploadManager; }
+		inline Ref<GeometryPool> GetGeometryPool() override { return m_GeometryPool; }
 
 	public:
 		inline VkInstance& GetVulkanInstance() { return m_VulkanInstance; }
 		inline VkSurfaceKHR& GetVulkanSurface() { return m_Surface; }
+		inline bool IsHeadless() const { return m_Headless; }
 
 		inline Ref<VulkanDevice> GetLogicalDevice() { return m_Device; }
 		inline Ref<VulkanPhysicalDevice> GetPhysicalDevice() { return m_PhysicalDevice; }
 		inline Ref<VulkanSwapChain> GetSwapChain() { return m_SwapChain; }
+		inline Ref<VulkanQueryManager> GetQueryManager() { return m_QueryManager; }
 
 	private:
 		VkInstance m_VulkanInstance = VK_NULL_HANDLE;
 		VkDebugUtilsMessengerEXT m_DebugMessenger = VK_NULL_HANDLE;
 		VkSurfaceKHR m_Surface = VK_NULL_HANDLE;
+		bool m_Headless = false;
 
 		Ref<VulkanPhysicalDevice> m_PhysicalDevice = VK_NULL_HANDLE;
 		Ref<VulkanDevice> m_Device = VK_NULL_HANDLE;
 		Ref<VulkanSwapChain> m_SwapChain = VK_NULL_HANDLE;
 
+		Ref<FrameUploadRing> m_UploadRing = nullptr;
+		Ref<UploadManager> m_UploadManager = nullptr;
+		Ref<GeometryPool> m_GeometryPool = nullptr;
+		Ref<VulkanQueryManager> m_QueryManager = nullptr;
+
 	private:
-		Utils::Queue<RenderFunction> m_RenderQueue = { };
-		Utils::Queue<FreeFunction> m_ResourceFreeQueue = { };
-		Utils::Queue<UIFunction> m_UIQueue = { };
+		FramePipeline m_Pipeline = {};
+
+		// Note(Jorben): One per frame in flight, resources released while a frame index was in use
+		// are destroyed once that index's timeline values have been reached again (RendererSpecification::BufferCount frames later).
+		std::array<CommandStream, (size_t)RendererSpecification::BufferCount> m_ResourceFreeStreams = { };
+		std::atomic<uint32_t> m_FreeFrame = 0;
 	};
 
 }
\ No newline at end of file
@@ -33,13 +33,59 @@ namespace Swift
 		return shaderc_glsl_vertex_shader;
 	}
 
-	std::vector<char> VulkanShaderCompiler::Compile(const std::string& code, ShaderStage stage)
+	// Resolves `#include "..."` relative to the including file
+	class VulkanShaderIncluder : public shaderc::CompileOptions::IncluderInterface
+	{
+	public:
+		shaderc_include_result* GetInclude(const char* requestedSource, shaderc_include_type type, const char* requestingSource, size_t includeDepth) override
+		{
+			IncludeData* data = new IncludeData();
+
+			std::filesystem::path path = std::filesystem::path(requestingSource).parent_path() / requestedSource;
+			if (std::filesystem::exists(path))
+			{
+				data->Name = path.string();
+				data->Content = ShaderSpecification::ReadGLSLFile(path);
+			}
+			else
+			{
+				// Note(Jorben): An empty name tells shaderc the include failed, the content is the error message
+				data->Content = "Failed to find include '" + std::string(requestedSource) + "' requested by '" + std::string(requestingSource) + "'";
+			}
+
+			data->Result.source_name = data->Name.c_str();
+			data->Result.source_name_length = data->Name.size();
+			data->Result.content = data->Content.c_str();
+			data->Result.content_length = data->Content.size();
+			data->Result.user_data = data;
+
+			return &data->Result;
+		}
+
+		void ReleaseInclude(shaderc_include_result* data) override
+		{
+			delete (IncludeData*)data->user_data;
+		}
+
+	private:
+		struct IncludeData
+		{
+		public:
+			std::string Name = {};
+			std::string Content = {};
+
+			shaderc_include_result Result = {};
+		};
+	};
+
+	std::vector<char> VulkanShaderCompiler::Compile(const std::string& code, ShaderStage stage, const std::filesystem::path& path)
 	{
 		shaderc::Compiler compiler = {};
 		shaderc::CompileOptions options = {};
 		options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_2);
+		options.SetIncluder(std::make_unique<VulkanShaderIncluder>());
 
-		shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(code, ShaderStageToShaderCType(stage), "", options);
+		shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(code, ShaderStageToShaderCType(stage), path.string().c_str(), options);
 
 		if (module.GetCompilationStatus() != shaderc_compilation_status_success)
 			APP_ASSERT(false, "Error compiling shader: {0}", module.GetErrorMessage());
@@ -13,7 +13,7 @@ namespace Swift
 		VulkanShaderCompiler() = default;
 		virtual ~VulkanShaderCompiler() = default;
 
-		std::vector<char> Compile(const std::string& code, ShaderStage stage);
+		std::vector<char> Compile(const std::string& code, ShaderStage stage, const std::filesystem::path& path = {});
 		ShaderSpecification Compile(const std::string& fragment, const std::string& vertex);
 	};
 
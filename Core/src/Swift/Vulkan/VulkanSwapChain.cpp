@@ -17,14 +17,14 @@ namespace Swift
 {
 
 	VulkanSwapChain::VulkanSwapChain(VkInstance vkInstance, Ref<VulkanDevice> vkDevice)
-		: m_Instance(vkInstance), m_Device(vkDevice)
+		: m_Instance(vkInstance), m_Device(vkDevice), m_Headless(((VulkanRenderer*)Renderer::GetInstance())->IsHeadless())
 	{
 		FindImageFormatAndColorSpace();
 	}
 
 	VulkanSwapChain::~VulkanSwapChain()
 	{
-		Renderer::Wait();
+		// Note(Jorben): Only destroyed by the renderer, which already waited on the device
 		auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice();
 
 		if (m_SwapChain)
@@ -34,24 +34,55 @@ namespace Swift
 		m_DepthStencil.reset();
 
 		vkDestroyCommandPool(device, m_CommandPool, nullptr);
+		if (m_ComputeCommandPool)
+			vkDestroyCommandPool(device, m_ComputeCommandPool, nullptr);
+		for (auto& pools : m_ThreadCommandPools)
+		{
+			for (auto& pool : pools)
+				vkDestroyCommandPool(device, pool, nullptr);
+		}
+
+		for (auto& semaphore : m_ImageAvailableSemaphores)
+			vkDestroySemaphore(device, semaphore, nullptr);
+		for (auto& semaphore : m_RenderFinishedSemaphores)
+			vkDestroySemaphore(device, semaphore, nullptr);
+	}
 
-		for (size_t i = 0; i < (size_t)RendererSpecification::BufferCount; i++)
-			vkDestroySemaphore(device, m_ImageAvailableSemaphores[i], nullptr);
+	void VulkanSwapChain::ResetThreadCommandPools(uint32_t frame)
+	{
+		for (auto& pool : m_ThreadCommandPools[frame])
+			vkResetCommandPool(m_Device->GetVulkanDevice(), pool, 0);
 	}
 
 	void VulkanSwapChain::BeginFrame()
 	{
+		// Note(Jorben): Offscreen images are owned by us, so there is nothing to acquire
+		if (m_Headless)
+		{
+			m_AquiredImage = m_CurrentFrame;
+			return;
+		}
+
 		m_AquiredImage = AcquireNextImage();
 	}
 
 	void VulkanSwapChain::EndFrame()
 	{
-		auto& semaphores = VulkanTaskManager::GetSemaphores();
+		// Note(Jorben): Submits the whole frame, the last graphics batch waits on the frame's work on the other queues and
+		// (when presenting) signals the binary semaphore the presentation engine waits on, since that can't wait on a timeline.
+		VulkanTaskManager::EndFrame(m_Headless ? VK_NULL_HANDLE : m_RenderFinishedSemaphores[m_CurrentFrame]);
+
+		// Note(Jorben): Offscreen images are owned by us, so there is nothing to present
+		if (m_Headless)
+		{
+			m_CurrentFrame = (m_CurrentFrame + 1) % (uint32_t)RendererSpecification::BufferCount;
+			return;
+		}
 
 		VkPresentInfoKHR presentInfo = {};
 		presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-		presentInfo.waitSemaphoreCount = (uint32_t)semaphores.size();
-		presentInfo.pWaitSemaphores = semaphores.data();
+		presentInfo.waitSemaphoreCount = 1;
+		presentInfo.pWaitSemaphores = &m_RenderFinishedSemaphores[m_CurrentFrame];
 		presentInfo.swapchainCount = 1;
 		presentInfo.pSwapchains = &m_SwapChain;
 		presentInfo.pImageIndices = &m_AquiredImage;
@@ -60,6 +91,7 @@ namespace Swift
 		VkResult result = VK_SUCCESS;
 		{
 			APP_PROFILE_SCOPE("QueuePresent");
+			std::scoped_lock<std::mutex> lock(m_Device->GetQueueMutex());
 
 			// Note(Jorben): Without these 2 lines there is a memory leak when validation layers are enabled.
 			if constexpr (s_Validation)
@@ -103,7 +135,7 @@ namespace Swift
 		uint32_t framesInFlight = (uint32_t)RendererSpecification::BufferCount;
 		if (!m_CommandPool)
 		{
-			QueueFamilyIndices queueFamilyIndices = QueueFamilyIndices::Find(m_Device->GetPhysicalDevice()->GetVulkanPhysicalDevice());
+			const QueueFamilyIndices& queueFamilyIndices = m_Device->GetQueueFamilies();
 
 			VkCommandPoolCreateInfo poolInfo = {};
 			poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
@@ -112,6 +144,38 @@ namespace Swift
 
 			if (vkCreateCommandPool(m_Device->GetVulkanDevice(), &poolInfo, nullptr, &m_CommandPool) != VK_SUCCESS)
 				APP_LOG_ERROR("Failed to create command pool!");
+
+			// Note(Jorben): Command buffers can only be submitted to queues of the family their pool was created for
+			if (queueFamilyIndices.HasAsyncCompute())
+			{
+				poolInfo.queueFamilyIndex = queueFamilyIndices.ComputeFamily.value();
+				if (vkCreateCommandPool(m_Device->GetVulkanDevice(), &poolInfo, nullptr, &m_ComputeCommandPool) != VK_SUCCESS)
+					APP_LOG_ERROR("Failed to create compute command pool!");
+			}
+
+			// Note(Jorben): Command pools can't be used from multiple threads at once, so every recording thread gets its own.
+			// Its buffers are re-recorded every frame, so the whole pool is reset instead of the individual buffers.
+			VkCommandPoolCreateInfo threadPoolInfo = {};
+			threadPoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+			threadPoolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+			threadPoolInfo.queueFamilyIndex = queueFamilyIndices.GraphicsFamily.value();
+
+			m_ThreadCommandPools.resize((size_t)framesInFlight);
+			for (auto& pools : m_ThreadCommandPools)
+			{
+				pools.resize((size_t)RendererSpecification::RecordingThreads);
+				for (auto& pool : pools)
+				{
+					if (vkCreateCommandPool(m_Device->GetVulkanDevice(), &threadPoolInfo, nullptr, &pool) != VK_SUCCESS)
+						APP_LOG_ERROR("Failed to create thread command pool!");
+				}
+			}
+		}
+
+		if (m_Headless)
+		{
+			InitOffscreen(width, height);
+			return;
 		}
 
 		/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -229,10 +293,9 @@ namespace Swift
 		auto oldSwapchain = m_SwapChain;
 		vkCreateSwapchainKHR(device, &swapchainCI, nullptr, &m_SwapChain);
 
-		if (oldSwapchain)
-			vkDestroySwapchainKHR(device, oldSwapchain, nullptr); // Destroys Images?
-
 		// Destroy old swapchain image(view)s
+		// Note(Jorben): Frames in flight can still be presenting the old images, so the old swapchain
+		// (which owns the images) is destroyed together with the views once those frames are done.
 		if (Renderer::Initialized())
 		{
 			std::vector<VulkanImageData> images = { };
@@ -242,12 +305,19 @@ namespace Swift
 				images.push_back(vkImage->GetImageData());
 			}
 
-			Renderer::SubmitFree([device, images]()
+			Renderer::SubmitFree([device, images, oldSwapchain]()
 			{
 				for (auto& image : images)
 					vkDestroyImageView(device, image.ImageView, nullptr);
+
+				if (oldSwapchain)
+					vkDestroySwapchainKHR(device, oldSwapchain, nullptr);
 			});
 		}
+		else if (oldSwapchain)
+		{
+			vkDestroySwapchainKHR(device, oldSwapchain, nullptr);
+		}
 
 		// Get the swap chain images
 		uint32_t imageCount = 0;
@@ -299,20 +369,7 @@ namespace Swift
 			else RefHelper::RefAs<VulkanImage2D>(m_Images[i])->SetImageData(specs, data);
 		}
 
-		if (!m_DepthStencil)
-		{
-			ImageSpecification specs = {};
-			specs.Usage = ImageUsage::Size;
-			specs.Format = GetImageFormatFromVulkanFormat(VulkanAllocator::FindDepthFormat());
-			specs.Flags = ImageUsageFlags::Depth | ImageUsageFlags::Sampled /*| ImageUsageFlags::Storage*/ | ImageUsageFlags::NoMipMaps;
-			specs.Width = width;
-			specs.Height = height;
-			specs.Layout = ImageLayout::Depth;
-
-			m_DepthStencil = Image2D::Create(specs);
-		}
-		else
-			m_DepthStencil->Resize(width, height);
+		InitDepth(width, height);
 
 		/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 		// Synchronization Objects
@@ -320,17 +377,15 @@ namespace Swift
 		if (m_ImageAvailableSemaphores.empty())
 		{
 			m_ImageAvailableSemaphores.resize(framesInFlight);
+			m_RenderFinishedSemaphores.resize(framesInFlight);
 
 			VkSemaphoreCreateInfo semaphoreInfo = {};
 			semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-			VkFenceCreateInfo fenceInfo = {};
-			fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-			fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
 			for (size_t i = 0; i < framesInFlight; i++)
 			{
-				if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &m_ImageAvailableSemaphores[i]) != VK_SUCCESS)
+				if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &m_ImageAvailableSemaphores[i]) != VK_SUCCESS ||
+					vkCreateSemaphore(device, &semaphoreInfo, nullptr, &m_RenderFinishedSemaphores[i]) != VK_SUCCESS)
 				{
 					APP_LOG_ERROR("Failed to create synchronization objects for a frame!");
 				}
@@ -338,6 +393,62 @@ namespace Swift
 		}
 	}
 
+	void VulkanSwapChain::InitOffscreen(uint32_t width, uint32_t height)
+	{
+		if (width == 0 || height == 0)
+			return;
+
+		uint32_t framesInFlight = (uint32_t)RendererSpecification::BufferCount;
+
+		/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		// Images
+		/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		// Note(Jorben): One colour target per frame in flight, they stay in the presentation layout so renderpasses
+		// targeting the swapchain don't have to know the difference
+		if (m_Images.empty())
+		{
+			m_Images.resize((size_t)framesInFlight);
+
+			for (auto& image : m_Images)
+			{
+				ImageSpecification specs = {};
+				specs.Usage = ImageUsage::Size;
+				specs.Format = GetImageFormatFromVulkanFormat(m_ColourFormat);
+				specs.Flags = ImageUsageFlags::Colour | ImageUsageFlags::NoMipMaps;
+				specs.Width = width;
+				specs.Height = height;
+				specs.Layout = ImageLayout::Presentation;
+
+				image = Image2D::Create(specs);
+			}
+		}
+		else
+		{
+			for (auto& image : m_Images)
+				image->Resize(width, height);
+		}
+
+		InitDepth(width, height);
+	}
+
+	void VulkanSwapChain::InitDepth(uint32_t width, uint32_t height)
+	{
+		if (!m_DepthStencil)
+		{
+			ImageSpecification specs = {};
+			specs.Usage = ImageUsage::Size;
+			specs.Format = GetImageFormatFromVulkanFormat(VulkanAllocator::FindDepthFormat());
+			specs.Flags = ImageUsageFlags::Depth | ImageUsageFlags::Sampled /*| ImageUsageFlags::Storage*/ | ImageUsageFlags::NoMipMaps;
+			specs.Width = width;
+			specs.Height = height;
+			specs.Layout = ImageLayout::Depth;
+
+			m_DepthStencil = Image2D::Create(specs);
+		}
+		else
+			m_DepthStencil->Resize(width, height);
+	}
+
 	uint32_t VulkanSwapChain::AcquireNextImage()
 	{
 		APP_PROFILE_SCOPE("AquireNextImage");
@@ -359,6 +470,14 @@ namespace Swift
 
 	void VulkanSwapChain::FindImageFormatAndColorSpace()
 	{
+		// Note(Jorben): Offscreen images can be whatever we like
+		if (m_Headless)
+		{
+			m_ColourFormat = VK_FORMAT_B8G8R8A8_UNORM;
+			m_ColourSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+			return;
+		}
+
 		VkPhysicalDevice physicalDevice = m_Device->GetPhysicalDevice()->GetVulkanPhysicalDevice();
 		VkSurfaceKHR& surface = ((VulkanRenderer*)Renderer::GetInstance())->GetVulkanSurface();
 
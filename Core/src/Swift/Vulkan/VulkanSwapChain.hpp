@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <array>
 #include <memory>
 
 #include <vulkan/vulkan.h>
@@ -33,19 +34,28 @@ namespace Swift
 
 		inline uint32_t GetCurrentFrame() const { return m_CurrentFrame; }
 		inline uint32_t GetAquiredImage() const { return m_AquiredImage; }
+		inline bool IsHeadless() const { return m_Headless; }
 
 		inline std::vector<Ref<Image2D>>& GetSwapChainImages() { return m_Images; }
 		inline Ref<Image2D>& GetDepthImage() { return m_DepthStencil; }
 
-		// Note(Jorben): This function is used by VulkanRenderCommandBuffers to wait for the image to be available
+		// Note(Jorben): Handed to the VulkanTaskManager, the first graphics submission of the frame waits on it
 		inline VkSemaphore& GetCurrentImageAvailableSemaphore() { return m_ImageAvailableSemaphores[m_CurrentFrame]; }
 		inline VkSemaphore& GetImageAvailableSemaphore(uint32_t index) { return m_ImageAvailableSemaphores[index]; }
 
 		inline VkCommandPool& GetCommandPool() { return m_CommandPool; }
+		inline VkCommandPool& GetCommandPool(Queue queue) { return (queue == Queue::Compute && m_ComputeCommandPool) ? m_ComputeCommandPool : m_CommandPool; }
+		inline VkCommandPool GetThreadCommandPool(uint32_t frame, uint32_t thread) { return m_ThreadCommandPools[frame][thread]; }
+
+		// Note(Jorben): Resets every secondary command buffer of the frame at once, only call this once the frame's timeline values have been reached
+		void ResetThreadCommandPools(uint32_t frame);
 
 		static Ref<VulkanSwapChain> Create(VkInstance vkInstance, Ref<VulkanDevice> vkDevice);
 
 	private:
+		void InitOffscreen(uint32_t width, uint32_t height);
+		void InitDepth(uint32_t width, uint32_t height);
+
 		uint32_t AcquireNextImage();
 		void FindImageFormatAndColorSpace();
 
@@ -58,8 +68,14 @@ namespace Swift
 		Ref<Image2D> m_DepthStencil = VK_NULL_HANDLE;
 
 		VkCommandPool m_CommandPool = VK_NULL_HANDLE;
+		VkCommandPool m_ComputeCommandPool = VK_NULL_HANDLE; // Note(Jorben): Only created for a dedicated compute family
+		std::vector<std::vector<VkCommandPool>> m_ThreadCommandPools = { }; // [frame][thread]
 
+		// Note(Jorben): Binary semaphores for acquiring & presenting, only used when not headless
 		std::vector<VkSemaphore> m_ImageAvailableSemaphores = { };
+		std::vector<VkSemaphore> m_RenderFinishedSemaphores = { };
+
+		bool m_Headless = false;
 
 		VkFormat m_ColourFormat = VK_FORMAT_UNDEFINED;
 		VkColorSpaceKHR m_ColourSpace = VK_COLOR_SPACE_MAX_ENUM_KHR;
@@ -2,176 +2,398 @@
 #include "VulkanTaskManager.hpp"
 
 #include "Swift/Core/Logging.hpp"
+#include "Swift/Utils/Profiler.hpp"
 
 #include "Swift/Renderer/Renderer.hpp"
 
+#include "Swift/Vulkan/VulkanUtils.hpp"
 #include "Swift/Vulkan/VulkanRenderer.hpp"
 
 namespace Swift
 {
 
-	std::mutex									VulkanTaskManager::s_SemaphoreMutex;
-	Dict<uint32_t, LinkedList<VkSemaphore>>		VulkanTaskManager::s_Semaphores;
-	std::mutex									VulkanTaskManager::s_FrameSemaphoreMutex;
-	Dict<uint32_t, LinkedList<VkSemaphore>>		VulkanTaskManager::s_FrameSemaphores;
+	std::array<VkSemaphore, VulkanTaskManager::QueueCount>									VulkanTaskManager::s_Timelines = { };
+	std::array<std::atomic<uint64_t>, VulkanTaskManager::QueueCount>						VulkanTaskManager::s_NextValues = { };
+	std::array<VulkanTaskManager::FrameRecord, (size_t)RendererSpecification::BufferCount>	VulkanTaskManager::s_Frames = { };
 
-	std::mutex									VulkanTaskManager::s_FenceMutex;
-	Dict<uint32_t, LinkedList<VkFence>>			VulkanTaskManager::s_Fences;
+	std::vector<VulkanTaskManager::Submission>												VulkanTaskManager::s_Pending = { };
+	std::array<uint64_t, VulkanTaskManager::QueueCount>										VulkanTaskManager::s_FlushedValues = { };
+	VulkanTaskManager::FlushStorage															VulkanTaskManager::s_FlushStorage = {};
 
 
 
-	void VulkanTaskManager::AddSemaphore(VkSemaphore semaphore)
+	void VulkanTaskManager::Init()
 	{
-		std::scoped_lock<std::mutex> lock(s_SemaphoreMutex);
+		auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice();
 
-		s_Semaphores[Renderer::GetCurrentFrame()].Push(semaphore);
+		VkSemaphoreTypeCreateInfo typeInfo = {};
+		typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+		typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+		typeInfo.initialValue = 0;
+
+		VkSemaphoreCreateInfo semaphoreInfo = {};
+		semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		semaphoreInfo.pNext = &typeInfo;
+
+		for (size_t i = 0; i < QueueCount; i++)
+		{
+			if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &s_Timelines[i]) != VK_SUCCESS)
+				APP_LOG_ERROR("Failed to create timeline semaphore!");
+
+			s_NextValues[i] = 0;
+			s_FlushedValues[i] = 0;
+		}
+		s_Pending.clear();
+
+		for (auto& frame : s_Frames)
+		{
+			for (auto& value : frame.Values)
+				value = 0;
+
+			frame.LastSequence = 0;
+			frame.ImageAvailable = VK_NULL_HANDLE;
+		}
 	}
 
-	void VulkanTaskManager::AddFrameSemaphore(VkSemaphore semaphore)
+	void VulkanTaskManager::Destroy()
 	{
-		std::scoped_lock<std::mutex> lock(s_FrameSemaphoreMutex);
+		// Note(Jorben): Only called by the renderer, which already waited on the device
+		auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice();
 
-		s_FrameSemaphores[Renderer::GetCurrentFrame()].Push(semaphore);
+		for (auto& timeline : s_Timelines)
+		{
+			vkDestroySemaphore(device, timeline, nullptr);
+			timeline = VK_NULL_HANDLE;
+		}
 	}
 
-	void VulkanTaskManager::AddFence(VkFence fence)
+	TimelinePoint VulkanTaskManager::Signal(Queue queue)
 	{
-		std::scoped_lock<std::mutex> lock(s_FenceMutex);
+		size_t index = GetQueueIndex(queue);
+		uint64_t value = s_NextValues[index].fetch_add(1, std::memory_order_relaxed) + 1;
 
-		s_Fences[Renderer::GetCurrentFrame()].Push(fence);
+		s_Frames[Renderer::GetCurrentFrame()].Values[index].store(value, std::memory_order_release);
+
+		return { queue, value };
 	}
 
-	VkSemaphore& VulkanTaskManager::GetFirstSempahore()
+	TimelinePoint VulkanTaskManager::Enqueue(Queue queue, VkCommandBuffer commandBuffer, const TimelinePoint* waits, uint32_t waitCount)
 	{
-		std::scoped_lock<std::mutex> lock(s_SemaphoreMutex);
-
-		static VkSemaphore semaphore = VK_NULL_HANDLE;
+		APP_ASSERT((waitCount <= MaxWaits), "Too many dependencies for a single submission.");
 
-		uint32_t frame = Renderer::GetCurrentFrame();
+		Submission& submission = s_Pending.emplace_back();
+		submission.Target = queue;
+		submission.CommandBuffer = commandBuffer;
 
-		if (!s_Semaphores[frame].Empty())
+		for (uint32_t i = 0; i < waitCount; i++)
 		{
-			semaphore = std::move(s_Semaphores[frame].Front());
-			s_Semaphores[frame].Pop();
+			if (waits[i])
+				submission.Waits[submission.WaitCount++] = waits[i];
 		}
 
-		return semaphore;
+		// Note(Jorben): Reserved last, so everything waited on has a lower value (which keeps the batches free of cycles)
+		submission.Value = Signal(queue).Value;
+		return { queue, submission.Value };
 	}
 
-	VkFence& VulkanTaskManager::GetFirstFence()
+	void VulkanTaskManager::Flush(VkSemaphore binarySignal)
 	{
-		std::scoped_lock<std::mutex> lock(s_FenceMutex);
+		APP_PROFILE_SCOPE("VulkanTaskManager::Flush");
 
-		static VkFence fence = VK_NULL_HANDLE;
+		// Note(Jorben): Timelines allow waiting on values that haven't been submitted yet, as long as the signal ends up on another
+		// VkQueue. Every queue is flushed before the list is cleared, since the batch boundaries depend on what the others wait on.
+		VkQueue graphics = GetVulkanQueue(Queue::Graphics);
+		VkQueue compute = GetVulkanQueue(Queue::Compute);
 
-		uint32_t frame = Renderer::GetCurrentFrame();
-
-		if (!s_Fences[frame].Empty())
+		if (graphics == compute)
+		{
+			FlushQueue(graphics, true, true, binarySignal);
+		}
+		else
 		{
-			fence = std::move(s_Fences[frame].Front());
-			s_Fences[frame].Pop();
+			FlushQueue(compute, false, true, VK_NULL_HANDLE);
+			FlushQueue(graphics, true, false, binarySignal);
 		}
 
-		return fence;
+		for (auto& submission : s_Pending)
+			s_FlushedValues[GetQueueIndex(submission.Target)] = submission.Value;
+
+		s_Pending.clear();
 	}
 
-	std::vector<VkSemaphore>& VulkanTaskManager::GetSemaphores()
+	void VulkanTaskManager::EndFrame(VkSemaphore binarySignal)
 	{
-		std::scoped_lock<std::mutex> lock(s_SemaphoreMutex);
+		TimelinePoint compute = GetFramePoint(Renderer::GetCurrentFrame(), Queue::Compute);
+		Enqueue(Queue::Graphics, VK_NULL_HANDLE, &compute, 1);
 
-		static std::vector<VkSemaphore> semaphores = { };
-		semaphores.clear();
+		Flush(binarySignal);
+	}
 
-		uint32_t frame = Renderer::GetCurrentFrame();
-		semaphores = s_Semaphores[frame].AsVector();
-		semaphores.insert(semaphores.end(), s_FrameSemaphores[frame].AsVector().begin(), s_FrameSemaphores[frame].AsVector().end());
+	void VulkanTaskManager::SetLastSequence(TimelinePoint point)
+	{
+		s_Frames[Renderer::GetCurrentFrame()].LastSequence.store((point.Value << 2) | (uint64_t)point.Target, std::memory_order_release);
+	}
 
-		s_Semaphores[frame].Clear();
-		s_FrameSemaphores[frame].Clear();
+	TimelinePoint VulkanTaskManager::GetLastSequence()
+	{
+		uint64_t packed = s_Frames[Renderer::GetCurrentFrame()].LastSequence.load(std::memory_order_acquire);
+		return { (Queue)(packed & 0b11), packed >> 2 };
+	}
 
-		return semaphores;
+	void VulkanTaskManager::SetImageAvailable(VkSemaphore semaphore)
+	{
+		s_Frames[Renderer::GetCurrentFrame()].ImageAvailable.store(semaphore, std::memory_order_release);
 	}
 
-	std::vector<VkFence>& VulkanTaskManager::GetFences()
+	VkSemaphore VulkanTaskManager::ConsumeImageAvailable()
 	{
-		std::scoped_lock<std::mutex> lock(s_FenceMutex);
+		return s_Frames[Renderer::GetCurrentFrame()].ImageAvailable.exchange(VK_NULL_HANDLE, std::memory_order_acq_rel);
+	}
 
-		static std::vector<VkFence> fences = { };
-		fences.clear();
+	void VulkanTaskManager::WaitForFrame(uint32_t frame)
+	{
+		APP_PROFILE_SCOPE("VulkanTaskManager::WaitForFrame");
 
-		uint32_t frame = Renderer::GetCurrentFrame();
-		fences = s_Fences[frame].AsVector();
+		std::array<VkSemaphore, QueueCount> semaphores = { };
+		std::array<uint64_t, QueueCount> values = { };
+		uint32_t count = 0;
 
-		s_Fences[frame].Clear();
+		for (size_t i = 0; i < QueueCount; i++)
+		{
+			uint64_t value = s_Frames[frame].Values[i].load(std::memory_order_acquire);
+			if (value == 0)
+				continue;
 
-		return fences;
-	}
+			semaphores[count] = s_Timelines[i];
+			values[count] = value;
+			count++;
+		}
 
-	bool VulkanTaskManager::HasSemaphore(VkSemaphore semaphore)
-	{
-		std::scoped_lock<std::mutex> lock(s_SemaphoreMutex);
-		std::scoped_lock<std::mutex> lock2(s_FrameSemaphoreMutex);
+		// Note(Jorben): The frame is done (once we've waited), a new one starts with a clean slate
+		for (auto& value : s_Frames[frame].Values)
+			value.store(0, std::memory_order_release);
+		s_Frames[frame].LastSequence.store(0, std::memory_order_release);
 
-		uint32_t frame = Renderer::GetCurrentFrame();
+		if (count == 0)
+			return;
+
+		VkSemaphoreWaitInfo waitInfo = {};
+		waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+		waitInfo.semaphoreCount = count;
+		waitInfo.pSemaphores = semaphores.data();
+		waitInfo.pValues = values.data();
 
-		return s_Semaphores[frame].HasItem(semaphore) || s_FrameSemaphores[frame].HasItem(semaphore);
+		auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice();
+		if (vkWaitSemaphores(device, &waitInfo, MAX_UINT64) != VK_SUCCESS)
+			APP_LOG_ERROR("Failed to wait on the frame's timeline semaphores!");
 	}
 
-	void VulkanTaskManager::RemoveSemaphore(VkSemaphore semaphore)
+	void VulkanTaskManager::Wait(TimelinePoint point)
 	{
-		std::scoped_lock<std::mutex> lock(s_SemaphoreMutex);
-		std::scoped_lock<std::mutex> lock2(s_FrameSemaphoreMutex);
+		if (!point)
+			return;
 
-		uint32_t frame = Renderer::GetCurrentFrame();
+		APP_PROFILE_SCOPE("VulkanTaskManager::Wait");
 
-		if (s_Semaphores[frame].HasItem(semaphore))
-			s_Semaphores[frame].Remove(semaphore);
-		else if (s_FrameSemaphores[frame].HasItem(semaphore))
-			s_FrameSemaphores[frame].Remove(semaphore);
-		else
-		{
-			APP_ASSERT(false, "Semaphore by value {0} doesn't exist.", (void*)semaphore)
-			return;
-		}
+		// Note(Jorben): Waiting on something that's still queued would never return
+		if (point.Value > s_FlushedValues[GetQueueIndex(point.Target)])
+			Flush();
+
+		VkSemaphore semaphore = GetTimeline(point.Target);
+
+		VkSemaphoreWaitInfo waitInfo = {};
+		waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+		waitInfo.semaphoreCount = 1;
+		waitInfo.pSemaphores = &semaphore;
+		waitInfo.pValues = &point.Value;
+
+		auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice();
+		if (vkWaitSemaphores(device, &waitInfo, MAX_UINT64) != VK_SUCCESS)
+			APP_LOG_ERROR("Failed to wait on timeline semaphore!");
 	}
 
-	bool VulkanTaskManager::HasFence(VkFence fence)
+	TimelinePoint VulkanTaskManager::GetFramePoint(uint32_t frame, Queue queue)
 	{
-		std::scoped_lock<std::mutex> lock(s_FenceMutex);
-
-		uint32_t frame = Renderer::GetCurrentFrame();
+		return { queue, s_Frames[frame].Values[GetQueueIndex(queue)].load(std::memory_order_acquire) };
+	}
 
-		return s_Fences[frame].HasItem(fence);
+	VkSemaphore VulkanTaskManager::GetTimeline(Queue queue)
+	{
+		return s_Timelines[GetQueueIndex(queue)];
 	}
 
-	void VulkanTaskManager::RemoveFence(VkFence fence)
+	VkPipelineStageFlags VulkanTaskManager::GetWaitStage(Queue waiting, Queue signalled)
 	{
-		std::scoped_lock<std::mutex> lock(s_FenceMutex);
+		// Note(Jorben): Compute work only ever reads what came before from its shaders
+		if (waiting == Queue::Compute)
+			return VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+		// Buffers written by compute are consumed as draw/vertex input or read from shaders, the depth attachment
+		// is handed back (and acquired) before it's tested against again
+		if (signalled == Queue::Compute)
+			return VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+				| VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+
+		// Earlier graphics work produced attachments, which get tested against, sampled or blended onto
+		return VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	}
 
-		uint32_t frame = Renderer::GetCurrentFrame();
+	void VulkanTaskManager::FlushQueue(VkQueue vkQueue, bool graphics, bool compute, VkSemaphore binarySignal)
+	{
+		FlushStorage& storage = s_FlushStorage;
 
-		if (s_Fences[frame].HasItem(fence))
-			s_Fences[frame].Remove(fence);
-		else
+		storage.Indices.clear();
+		for (uint32_t i = 0; i < (uint32_t)s_Pending.size(); i++)
 		{
-			APP_ASSERT(false, "Fence by value {0} doesn't exist.", (void*)fence)
+			Queue target = s_Pending[i].Target;
+			if ((target == Queue::Graphics && graphics) || (target == Queue::Compute && compute))
+				storage.Indices.push_back(i);
+		}
+
+		if (storage.Indices.empty())
 			return;
+
+		VkSemaphore imageAvailable = (graphics ? ConsumeImageAvailable() : VK_NULL_HANDLE);
+
+		// Note(Jorben): Worst case every submission is its own batch
+		size_t count = storage.Indices.size();
+		storage.Submits.resize(count);
+		storage.TimelineInfos.resize(count);
+		storage.CommandBuffers.resize(count);
+		storage.WaitSemaphores.resize(count * MaxWaits + 1);
+		storage.WaitValues.resize(count * MaxWaits + 1);
+		storage.WaitStages.resize(count * MaxWaits + 1);
+		storage.SignalSemaphores.resize(count + 1);
+		storage.SignalValues.resize(count + 1);
+
+		uint32_t batchCount = 0, bufferCount = 0, waitCount = 0, signalCount = 0;
+		bool open = false;
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const Submission& submission = s_Pending[storage.Indices[i]];
+
+			// Waits only happen at the start of a batch and a batch only signals a single timeline
+			if (!open || submission.WaitCount > 0)
+			{
+				VkSubmitInfo& info = storage.Submits[batchCount];
+				VkTimelineSemaphoreSubmitInfo& timelineInfo = storage.TimelineInfos[batchCount];
+				batchCount++;
+
+				info = {};
+				info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+				info.pNext = &timelineInfo;
+				info.pWaitSemaphores = &storage.WaitSemaphores[waitCount];
+				info.pWaitDstStageMask = &storage.WaitStages[waitCount];
+				info.pCommandBuffers = &storage.CommandBuffers[bufferCount];
+
+				timelineInfo = {};
+				timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+				timelineInfo.pWaitSemaphoreValues = &storage.WaitValues[waitCount];
+
+				for (uint32_t j = 0; j < submission.WaitCount; j++)
+				{
+					const TimelinePoint& wait = submission.Waits[j];
+
+					storage.WaitSemaphores[waitCount] = GetTimeline(wait.Target);
+					storage.WaitValues[waitCount] = wait.Value;
+					storage.WaitStages[waitCount] = GetWaitStage(submission.Target, wait.Target);
+					waitCount++;
+					info.waitSemaphoreCount++;
+				}
+
+				// Note(Jorben): Binary, so it's waited on exactly once. Later batches depend on this one through the timeline.
+				if (imageAvailable && submission.Target == Queue::Graphics)
+				{
+					storage.WaitSemaphores[waitCount] = imageAvailable;
+					storage.WaitValues[waitCount] = 0; // Ignored for binary semaphores
+					storage.WaitStages[waitCount] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+					waitCount++;
+					info.waitSemaphoreCount++;
+
+					imageAvailable = VK_NULL_HANDLE;
+				}
+
+				timelineInfo.waitSemaphoreValueCount = info.waitSemaphoreCount;
+				open = true;
+			}
+
+			VkSubmitInfo& info = storage.Submits[batchCount - 1];
+			VkTimelineSemaphoreSubmitInfo& timelineInfo = storage.TimelineInfos[batchCount - 1];
+
+			if (submission.CommandBuffer)
+			{
+				storage.CommandBuffers[bufferCount++] = submission.CommandBuffer;
+				info.commandBufferCount++;
+			}
+
+			// A batch signals once all of its work is done, so anything that's waited on has to end one
+			bool last = (i == count - 1);
+			if (!last)
+			{
+				const Submission& next = s_Pending[storage.Indices[i + 1]];
+				if (next.WaitCount == 0 && next.Target == submission.Target && !IsWaitedOn({ submission.Target, submission.Value }))
+					continue;
+			}
+
+			info.pSignalSemaphores = &storage.SignalSemaphores[signalCount];
+			timelineInfo.pSignalSemaphoreValues = &storage.SignalValues[signalCount];
+
+			storage.SignalSemaphores[signalCount] = GetTimeline(submission.Target);
+			storage.SignalValues[signalCount] = submission.Value;
+			signalCount++;
+			info.signalSemaphoreCount++;
+
+			if (last && binarySignal)
+			{
+				storage.SignalSemaphores[signalCount] = binarySignal;
+				storage.SignalValues[signalCount] = 0; // Ignored for binary semaphores
+				signalCount++;
+				info.signalSemaphoreCount++;
+			}
+
+			timelineInfo.signalSemaphoreValueCount = info.signalSemaphoreCount;
+			open = false;
+		}
+
+		{
+			APP_PROFILE_SCOPE("VulkanTaskManager::Flush::QueueSubmit");
+
+			std::scoped_lock<std::mutex> lock(((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetQueueMutex());
+			VkResult result = vkQueueSubmit(vkQueue, batchCount, storage.Submits.data(), VK_NULL_HANDLE);
+			if (result != VK_SUCCESS)
+				APP_LOG_ERROR("Failed to submit command buffers! Error: {0}", VkResultToString(result));
 		}
 	}
 
-	void VulkanTaskManager::Reset()
+	bool VulkanTaskManager::IsWaitedOn(TimelinePoint point)
 	{
-		std::scoped_lock<std::mutex> lock(s_SemaphoreMutex);
-		std::scoped_lock<std::mutex> lock2(s_FrameSemaphoreMutex);
-		std::scoped_lock<std::mutex> lock3(s_FenceMutex);
-
-		constexpr const uint32_t framesInFlight = (uint32_t)RendererSpecification::BufferCount;
-		for (uint32_t i = 0; i < framesInFlight; i++)
+		for (auto& submission : s_Pending)
 		{
-			s_Semaphores[i].Clear();
-			s_FrameSemaphores[i].Clear();
-			s_Fences[i].Clear();
+			for (uint32_t i = 0; i < submission.WaitCount; i++)
+			{
+				if (submission.Waits[i].Target == point.Target && submission.Waits[i].Value == point.Value)
+					return true;
+			}
 		}
+
+		return false;
+	}
+
+	VkQueue VulkanTaskManager::GetVulkanQueue(Queue queue)
+	{
+		auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice();
+
+		if (queue == Queue::Compute)
+			return device->GetComputeQueue();
+
+		return device->GetGraphicsQueue();
+	}
+
+	size_t VulkanTaskManager::GetQueueIndex(Queue queue)
+	{
+		APP_ASSERT((queue == Queue::Graphics || queue == Queue::Compute), "Invalid queue selected.");
+		return (size_t)queue - 1;
 	}
 
-}
\ No newline at end of file
+}
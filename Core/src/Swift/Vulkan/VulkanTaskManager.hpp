@@ -1,48 +1,131 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <vector>
-#include <queue>
-#include <mutex>
 
 #include "Swift/Core/Core.hpp"
 #include "Swift/Utils/Utils.hpp"
 
+#include "Swift/Renderer/RendererConfig.hpp"
+#include "Swift/Renderer/CommandBuffer.hpp"
+
 #include <vulkan/vulkan.h>
 
 namespace Swift
 {
 
-	// A threadsafe class for keeping track of things to wait on
+	// A point on a queue's timeline, the work is done once the queue's timeline semaphore reached the value
+	struct TimelinePoint
+	{
+	public:
+		Queue Target = Queue::None;
+		uint64_t Value = 0;
+
+		inline operator bool() const { return Target != Queue::None && Value != 0; }
+	};
+
+	// Keeps track of the GPU's progress with one timeline semaphore per queue.
+	// Every submission gets the next value of its queue, the last value of every queue per frame in flight is
+	// remembered so BeginFrame can wait on the whole frame at once.
+	// Command buffers aren't submitted right away, they're collected per queue and flushed at the end of the frame
+	// with one vkQueueSubmit per queue. Work on the same queue is batched without semaphores in between, a new batch
+	// only starts where work waits on a timeline (in practice, where it crosses queues).
+	// Note(Jorben): Values are handed out in submission order, so all submissions have to come from a single thread (the one executing the frame).
 	class VulkanTaskManager
 	{
 	public:
-		static void AddSemaphore(VkSemaphore semaphore);
-		static void AddFrameSemaphore(VkSemaphore semaphore);
-		static void AddFence(VkFence fence);
+		inline static constexpr const size_t QueueCount = 2; // Graphics & Compute
+		inline static constexpr const size_t MaxWaits = 8;
 
-		// Every function below either clears the item from the list or the entire list
-		static VkSemaphore& GetFirstSempahore();
-		static VkFence& GetFirstFence();
+		static void Init();
+		static void Destroy();
 
-		static std::vector<VkSemaphore>& GetSemaphores();
-		static std::vector<VkFence>& GetFences();
+		// Queues the command buffer for the next flush, the returned point is reached once it has executed.
+		// Note(Jorben): A null command buffer just signals once everything before it (and everything waited on) is done.
+		static TimelinePoint Enqueue(Queue queue, VkCommandBuffer commandBuffer, const TimelinePoint* waits = nullptr, uint32_t waitCount = 0);
 
-		static bool HasSemaphore(VkSemaphore semaphore);
-		static void RemoveSemaphore(VkSemaphore semaphore);
+		// Submits everything that's queued, one vkQueueSubmit per VkQueue. The binary semaphore is signalled by the last graphics batch.
+		static void Flush(VkSemaphore binarySignal = VK_NULL_HANDLE);
+		// Queues a final graphics signal which waits on the frame's work on every other queue and flushes
+		static void EndFrame(VkSemaphore binarySignal);
 
-		static bool HasFence(VkFence fence);
-		static void RemoveFence(VkFence fence);
+		// Note(Jorben): Sequence command buffers wait on the previous sequence submission of the frame
+		static void SetLastSequence(TimelinePoint point);
+		static TimelinePoint GetLastSequence();
+
+		// The swapchain's (binary) image available semaphore, waited on by the first graphics batch of the frame
+		static void SetImageAvailable(VkSemaphore semaphore);
+
+		// Waits until every queue reached the last value that was signalled during the given frame index
+		static void WaitForFrame(uint32_t frame);
+		static void Wait(TimelinePoint point);
+
+		static TimelinePoint GetFramePoint(uint32_t frame, Queue queue);
+		static VkSemaphore GetTimeline(Queue queue);
+
+		// The stages of the waiting queue that depend on work from the signalling queue
+		static VkPipelineStageFlags GetWaitStage(Queue waiting, Queue signalled);
 
-		static void Reset();
-		
 	private:
-		static std::mutex s_SemaphoreMutex;
-		static Dict<uint32_t, LinkedList<VkSemaphore>> s_Semaphores;
-		static std::mutex s_FrameSemaphoreMutex;
-		static Dict<uint32_t, LinkedList<VkSemaphore>> s_FrameSemaphores;
+		struct Submission
+		{
+		public:
+			Queue Target = Queue::None;
+			VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+			uint64_t Value = 0;
+
+			std::array<TimelinePoint, MaxWaits> Waits = { };
+			uint32_t WaitCount = 0;
+		};
+
+		struct FrameRecord
+		{
+		public:
+			std::array<std::atomic<uint64_t>, QueueCount> Values = { };
+
+			std::atomic<uint64_t> LastSequence = 0; // Note(Jorben): Packed as (value << 2) | queue, so it can be swapped in one go
+			std::atomic<VkSemaphore> ImageAvailable = VK_NULL_HANDLE;
+		};
+
+		struct FlushStorage
+		{
+		public:
+			std::vector<uint32_t> Indices = { }; // Pending submissions of the queue being flushed
+
+			std::vector<VkSubmitInfo> Submits = { };
+			std::vector<VkTimelineSemaphoreSubmitInfo> TimelineInfos = { };
+			std::vector<VkCommandBuffer> CommandBuffers = { };
+
+			std::vector<VkSemaphore> WaitSemaphores = { };
+			std::vector<uint64_t> WaitValues = { };
+			std::vector<VkPipelineStageFlags> WaitStages = { };
+
+			std::vector<VkSemaphore> SignalSemaphores = { };
+			std::vector<uint64_t> SignalValues = { };
+		};
+
+		// Reserves the next value on the queue's timeline and records it as the current frame's last work on the queue
+		static TimelinePoint Signal(Queue queue);
+		static VkSemaphore ConsumeImageAvailable();
+
+		static size_t GetQueueIndex(Queue queue);
+		static VkQueue GetVulkanQueue(Queue queue);
+		static bool IsWaitedOn(TimelinePoint point);
+
+		// Note(Jorben): Queues can share a VkQueue, their work is then submitted together in submission order
+		static void FlushQueue(VkQueue vkQueue, bool graphics, bool compute, VkSemaphore binarySignal);
+
+	private:
+		static std::array<VkSemaphore, QueueCount> s_Timelines;
+		static std::array<std::atomic<uint64_t>, QueueCount> s_NextValues;
+
+		static std::array<FrameRecord, (size_t)RendererSpecification::BufferCount> s_Frames;
 
-		static std::mutex s_FenceMutex;
-		static Dict<uint32_t, LinkedList<VkFence>> s_Fences;
+		// Note(Jorben): Only touched by the executing thread, they keep their capacity so a flush doesn't allocate
+		static std::vector<Submission> s_Pending; // In submission order
+		static std::array<uint64_t, QueueCount> s_FlushedValues;
+		static FlushStorage s_FlushStorage;
 	};
 
-}
\ No newline at end of file
+}
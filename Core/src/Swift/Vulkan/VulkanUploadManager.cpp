@@ -0,0 +1,511 @@
+#include "swpch.h"
+#include "VulkanUploadManager.hpp"
+
+#include "Swift/Core/Logging.hpp"
+#include "Swift/Utils/Profiler.hpp"
+
+#include "Swift/Renderer/Renderer.hpp"
+
+#include "Swift/Vulkan/VulkanUtils.hpp"
+#include "Swift/Vulkan/VulkanRenderer.hpp"
+
+namespace Swift
+{
+
+	VulkanUploadManager::VulkanUploadManager(size_t stagingSize)
+		: m_Size(stagingSize)
+	{
+		auto renderer = (VulkanRenderer*)Renderer::GetInstance();
+		auto device = renderer->GetLogicalDevice();
+
+		// Note(Jorben): Image copies need offsets that are a multiple of the texel size, 16 covers every format we have
+		auto& limits = renderer->GetPhysicalDevice()->GetProperties().limits;
+		m_Alignment = (size_t)std::max(limits.optimalBufferCopyOffsetAlignment, (VkDeviceSize)16);
+
+		VulkanAllocator allocator = {};
+		m_Allocation = allocator.AllocateMappedBuffer((VkDeviceSize)m_Size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY, m_Buffer, m_MappedData);
+
+		VkSemaphoreTypeCreateInfo typeInfo = {};
+		typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+		typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+		typeInfo.initialValue = 0;
+
+		VkSemaphoreCreateInfo semaphoreInfo = {};
+		semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		semaphoreInfo.pNext = &typeInfo;
+
+		const QueueFamilyIndices& families = device->GetQueueFamilies();
+		m_AsyncTransfer = families.HasAsyncTransfer();
+		m_TransferFamily = families.TransferFamily.value();
+		m_GraphicsFamily = families.GraphicsFamily.value();
+
+		if (vkCreateSemaphore(device->GetVulkanDevice(), &semaphoreInfo, nullptr, &m_Timeline) != VK_SUCCESS)
+			APP_LOG_ERROR("Failed to create upload timeline semaphore!");
+		if (m_AsyncTransfer && vkCreateSemaphore(device->GetVulkanDevice(), &semaphoreInfo, nullptr, &m_TransferTimeline) != VK_SUCCESS)
+			APP_LOG_ERROR("Failed to create upload timeline semaphore!");
+
+		VkCommandPoolCreateInfo poolInfo = {};
+		poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+		poolInfo.queueFamilyIndex = m_TransferFamily;
+
+		if (vkCreateCommandPool(device->GetVulkanDevice(), &poolInfo, nullptr, &m_TransferCommandPool) != VK_SUCCESS)
+			APP_LOG_ERROR("Failed to create upload command pool!");
+
+		if (m_AsyncTransfer)
+		{
+			poolInfo.queueFamilyIndex = m_GraphicsFamily;
+			if (vkCreateCommandPool(device->GetVulkanDevice(), &poolInfo, nullptr, &m_GraphicsCommandPool) != VK_SUCCESS)
+				APP_LOG_ERROR("Failed to create upload command pool!");
+		}
+	}
+
+	VulkanUploadManager::~VulkanUploadManager()
+	{
+		// Note(Jorben): Only destroyed by the renderer, which already waited on the device
+		auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice();
+		VulkanAllocator allocator = {};
+
+		m_InFlight.push_back(std::move(m_Open));
+		for (auto& batch : m_InFlight)
+		{
+			for (auto& [buffer, allocation] : batch.Dedicated)
+				allocator.DestroyBuffer(buffer, allocation);
+		}
+		m_InFlight.clear();
+
+		// The command buffers go with their pools
+		vkDestroyCommandPool(device, m_TransferCommandPool, nullptr);
+		if (m_GraphicsCommandPool)
+			vkDestroyCommandPool(device, m_GraphicsCommandPool, nullptr);
+
+		vkDestroySemaphore(device, m_Timeline, nullptr);
+		if (m_TransferTimeline)
+			vkDestroySemaphore(device, m_TransferTimeline, nullptr);
+		allocator.DestroyBuffer(m_Buffer, m_Allocation);
+	}
+
+	void VulkanUploadManager::Flush()
+	{
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+		Submit();
+	}
+
+	void VulkanUploadManager::Poll()
+	{
+		APP_PROFILE_SCOPE("VulkanUploadManager::Poll");
+
+		std::vector<std::function<void()>> callbacks = { };
+		{
+			// Note(Jorben): Another thread is staging (or waiting for room in the ring), whatever is done gets picked up next time
+			std::unique_lock<std::mutex> lock(m_Mutex, std::try_to_lock);
+			if (!lock.owns_lock())
+				return;
+
+			Submit();
+			Retire();
+			TakeCallbacks(callbacks);
+
+			APP_PROFILE_PLOT("Staging used (MB)", (float)(m_Head - m_Tail) / (1024.0f * 1024.0f));
+		}
+
+		for (auto& callback : callbacks)
+			callback();
+	}
+
+	void VulkanUploadManager::Wait(UploadPoint point)
+	{
+		APP_PROFILE_SCOPE("VulkanUploadManager::Wait");
+
+		// Note(Jorben): Nothing was staged, so there's nothing that will ever be reached
+		if (point.Failed())
+			return;
+
+		uint64_t value = 0;
+		{
+			std::scoped_lock<std::mutex> lock(m_Mutex);
+
+			value = (point ? point.Value : (m_Recording ? m_Open.Value : m_Submitted));
+			APP_ASSERT((value < m_NextValue), "Waiting on an upload point that was never handed out.");
+
+			if (m_Recording && value >= m_Open.Value)
+				Submit();
+		}
+
+		// Note(Jorben): Not locked, so staging on other threads (and the renderer's Poll) can go on in the meantime
+		if (value > m_Completed.load(std::memory_order_acquire))
+			WaitForValue(value);
+
+		std::vector<std::function<void()>> callbacks = { };
+		{
+			std::scoped_lock<std::mutex> lock(m_Mutex);
+			Retire();
+			TakeCallbacks(callbacks);
+		}
+
+		for (auto& callback : callbacks)
+			callback();
+	}
+
+	bool VulkanUploadManager::IsComplete(UploadPoint point) const
+	{
+		return point.Value <= m_Completed.load(std::memory_order_acquire);
+	}
+
+	UploadPoint VulkanUploadManager::GetPoint() const
+	{
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+		return { (m_Recording ? m_Open.Value : m_Submitted) };
+	}
+
+	void VulkanUploadManager::OnComplete(std::function<void()> callback, UploadPoint point)
+	{
+		if (!point.Failed())
+		{
+			std::scoped_lock<std::mutex> lock(m_Mutex);
+
+			uint64_t value = (point ? point.Value : (m_Recording ? m_Open.Value : m_Submitted));
+			if (value > m_Completed.load(std::memory_order_acquire))
+			{
+				m_Callbacks.emplace_back(value, std::move(callback));
+				return;
+			}
+		}
+
+		callback();
+	}
+
+	size_t VulkanUploadManager::GetUsed() const
+	{
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+		return (size_t)(m_Head - m_Tail);
+	}
+
+	UploadPoint VulkanUploadManager::StageBuffer(VkBuffer buffer, const void* data, size_t size, VkDeviceSize offset)
+	{
+		APP_PROFILE_SCOPE("VulkanUploadManager::StageBuffer");
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+
+		Staging staging = Allocate(size);
+		if (!staging.Buffer)
+			return { UploadPoint::FailedValue };
+
+		memcpy(staging.Data, data, size);
+		VulkanAllocator::FlushMemory(staging.Allocation, staging.Offset, (VkDeviceSize)size);
+
+		Batch& batch = GetOpenBatch();
+		if (staging.Dedicated)
+			batch.Dedicated.emplace_back(staging.Buffer, staging.Allocation);
+
+		VkBufferCopy region = {};
+		region.srcOffset = staging.Offset;
+		region.dstOffset = offset;
+		region.size = (VkDeviceSize)size;
+		vkCmdCopyBuffer(batch.Transfer, staging.Buffer, buffer, 1, &region);
+
+		if (m_AsyncTransfer)
+		{
+			VulkanAllocator::TransferBufferOwnership(batch.Transfer, buffer, m_TransferFamily, m_GraphicsFamily, false, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, offset, (VkDeviceSize)size);
+			VulkanAllocator::TransferBufferOwnership(batch.Graphics, buffer, m_TransferFamily, m_GraphicsFamily, true, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, offset, (VkDeviceSize)size);
+		}
+
+		return { batch.Value };
+	}
+
+	UploadPoint VulkanUploadManager::StageImage(VkImage image, VkFormat format, uint32_t width, uint32_t height, uint32_t mipLevels, const void* data, size_t size, const std::function<void(VkCommandBuffer)>& finish)
+	{
+		APP_PROFILE_SCOPE("VulkanUploadManager::StageImage");
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+
+		Staging staging = Allocate(size);
+		if (!staging.Buffer)
+			return { UploadPoint::FailedValue };
+
+		memcpy(staging.Data, data, size);
+		VulkanAllocator::FlushMemory(staging.Allocation, staging.Offset, (VkDeviceSize)size);
+
+		Batch& batch = GetOpenBatch();
+		if (staging.Dedicated)
+			batch.Dedicated.emplace_back(staging.Buffer, staging.Allocation);
+
+		VulkanAllocator::TransitionImageLayout(batch.Transfer, image, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels);
+
+		VkBufferImageCopy region = {};
+		region.bufferOffset = staging.Offset;
+		region.bufferRowLength = 0;
+		region.bufferImageHeight = 0;
+
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.mipLevel = 0;
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = 1;
+
+		region.imageOffset = { 0, 0, 0 };
+		region.imageExtent = { width, height, 1 };
+
+		vkCmdCopyBufferToImage(batch.Transfer, staging.Buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+		if (m_AsyncTransfer)
+		{
+			VulkanAllocator::TransferImageOwnership(batch.Transfer, image, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels, m_TransferFamily, m_GraphicsFamily, false, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+			VulkanAllocator::TransferImageOwnership(batch.Graphics, image, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels, m_TransferFamily, m_GraphicsFamily, true, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+		}
+
+		if (finish)
+			finish(batch.Graphics);
+
+		return { batch.Value };
+	}
+
+	VulkanUploadManager::Staging VulkanUploadManager::Allocate(size_t size)
+	{
+		Staging staging = {};
+
+		// Note(Jorben): Waiting for the whole ring to drain wouldn't even be enough, so it gets its own buffer (freed with its batch)
+		if (size > m_Size)
+		{
+			VulkanAllocator allocator = {};
+			staging.Allocation = allocator.AllocateMappedBuffer((VkDeviceSize)size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY, staging.Buffer, staging.Data);
+			staging.Dedicated = true;
+
+			return staging;
+		}
+
+		uint64_t start = 0;
+		while (!TryAllocate(size, start))
+		{
+			APP_PROFILE_SCOPE("VulkanUploadManager::WaitForSpace");
+
+			// Space only comes back once the oldest batch is done, if that's the one being staged it has to be submitted first
+			if (m_InFlight.empty())
+				Submit();
+
+			if (m_InFlight.empty())
+			{
+				APP_LOG_ERROR("Staging ring is full without any uploads in flight.");
+				return {};
+			}
+
+			WaitForValue(m_InFlight.front().Value);
+			Retire();
+		}
+
+		staging.Buffer = m_Buffer;
+		staging.Allocation = m_Allocation;
+		staging.Offset = (VkDeviceSize)(start % m_Size);
+		staging.Data = static_cast<uint8_t*>(m_MappedData) + staging.Offset;
+
+		return staging;
+	}
+
+	bool VulkanUploadManager::TryAllocate(size_t size, uint64_t& start)
+	{
+		// Note(Jorben): An empty ring can start anywhere, the start of the buffer leaves the most room
+		if (m_Head == m_Tail)
+			m_Head = m_Tail = ((m_Head + m_Size - 1) / m_Size) * m_Size;
+
+		uint64_t position = ((m_Head + m_Alignment - 1) / m_Alignment) * m_Alignment;
+
+		// Regions don't wrap around, the end of the buffer is skipped instead
+		uint64_t offset = position % m_Size;
+		if (offset + size > m_Size)
+			position += m_Size - offset;
+
+		if (position + size - m_Tail > m_Size)
+			return false;
+
+		m_Head = position + size;
+		start = position;
+
+		return true;
+	}
+
+	VulkanUploadManager::Batch& VulkanUploadManager::GetOpenBatch()
+	{
+		if (m_Recording)
+			return m_Open;
+
+		m_Open = {};
+		m_Open.Value = m_NextValue++;
+
+		if (!m_FreeCommandBuffers.empty())
+		{
+			m_Open.Transfer = m_FreeCommandBuffers.back().first;
+			m_Open.Graphics = m_FreeCommandBuffers.back().second;
+			m_FreeCommandBuffers.pop_back();
+		}
+		else
+		{
+			auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice();
+
+			VkCommandBufferAllocateInfo allocInfo = {};
+			allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			allocInfo.commandPool = m_TransferCommandPool;
+			allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			allocInfo.commandBufferCount = 1;
+
+			if (vkAllocateCommandBuffers(device, &allocInfo, &m_Open.Transfer) != VK_SUCCESS)
+				APP_LOG_ERROR("Failed to allocate upload command buffer!");
+
+			m_Open.Graphics = m_Open.Transfer;
+			if (m_AsyncTransfer)
+			{
+				allocInfo.commandPool = m_GraphicsCommandPool;
+				if (vkAllocateCommandBuffers(device, &allocInfo, &m_Open.Graphics) != VK_SUCCESS)
+					APP_LOG_ERROR("Failed to allocate upload command buffer!");
+			}
+		}
+
+		// Note(Jorben): The pools allow resetting single command buffers, beginning one resets it
+		VkCommandBufferBeginInfo beginInfo = {};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+		if (vkBeginCommandBuffer(m_Open.Transfer, &beginInfo) != VK_SUCCESS)
+			APP_LOG_ERROR("Failed to begin recording upload command buffer!");
+		if (m_AsyncTransfer && vkBeginCommandBuffer(m_Open.Graphics, &beginInfo) != VK_SUCCESS)
+			APP_LOG_ERROR("Failed to begin recording upload command buffer!");
+
+		m_Recording = true;
+		return m_Open;
+	}
+
+	void VulkanUploadManager::Submit()
+	{
+		if (!m_Recording)
+			return;
+
+		APP_PROFILE_SCOPE("VulkanUploadManager::Submit");
+
+		auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice();
+
+		// Note(Jorben): Everything that runs after the batch on the graphics queue sees what it wrote
+		VkMemoryBarrier barrier = {};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+		vkCmdPipelineBarrier(m_Open.Graphics, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+		if (vkEndCommandBuffer(m_Open.Transfer) != VK_SUCCESS)
+			APP_LOG_ERROR("Failed to record upload command buffer!");
+		if (m_AsyncTransfer && vkEndCommandBuffer(m_Open.Graphics) != VK_SUCCESS)
+			APP_LOG_ERROR("Failed to record upload command buffer!");
+
+		// The copies signal the transfer timeline when there's a graphics half waiting on them
+		VkSemaphore transferSignal = (m_AsyncTransfer ? m_TransferTimeline : m_Timeline);
+		VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+		VkTimelineSemaphoreSubmitInfo transferTimeline = {};
+		transferTimeline.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+		transferTimeline.signalSemaphoreValueCount = 1;
+		transferTimeline.pSignalSemaphoreValues = &m_Open.Value;
+
+		VkSubmitInfo transferSubmit = {};
+		transferSubmit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		transferSubmit.pNext = &transferTimeline;
+		transferSubmit.commandBufferCount = 1;
+		transferSubmit.pCommandBuffers = &m_Open.Transfer;
+		transferSubmit.signalSemaphoreCount = 1;
+		transferSubmit.pSignalSemaphores = &transferSignal;
+
+		VkTimelineSemaphoreSubmitInfo graphicsTimeline = {};
+		graphicsTimeline.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+		graphicsTimeline.waitSemaphoreValueCount = 1;
+		graphicsTimeline.pWaitSemaphoreValues = &m_Open.Value;
+		graphicsTimeline.signalSemaphoreValueCount = 1;
+		graphicsTimeline.pSignalSemaphoreValues = &m_Open.Value;
+
+		VkSubmitInfo graphicsSubmit = {};
+		graphicsSubmit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		graphicsSubmit.pNext = &graphicsTimeline;
+		graphicsSubmit.waitSemaphoreCount = 1;
+		graphicsSubmit.pWaitSemaphores = &m_TransferTimeline;
+		graphicsSubmit.pWaitDstStageMask = &waitStage;
+		graphicsSubmit.commandBufferCount = 1;
+		graphicsSubmit.pCommandBuffers = &m_Open.Graphics;
+		graphicsSubmit.signalSemaphoreCount = 1;
+		graphicsSubmit.pSignalSemaphores = &m_Timeline;
+
+		{
+			std::scoped_lock<std::mutex> lock(device->GetQueueMutex());
+
+			VkResult result = vkQueueSubmit(device->GetTransferQueue(), 1, &transferSubmit, VK_NULL_HANDLE);
+			if (result != VK_SUCCESS)
+				APP_LOG_ERROR("Failed to submit uploads! Error: {0}", VkResultToString(result));
+
+			if (m_AsyncTransfer)
+			{
+				result = vkQueueSubmit(device->GetGraphicsQueue(), 1, &graphicsSubmit, VK_NULL_HANDLE);
+				if (result != VK_SUCCESS)
+					APP_LOG_ERROR("Failed to submit uploads! Error: {0}", VkResultToString(result));
+			}
+		}
+
+		m_Open.RingEnd = m_Head;
+		m_Submitted = m_Open.Value;
+
+		m_InFlight.push_back(std::move(m_Open));
+		m_Open = {};
+		m_Recording = false;
+	}
+
+	void VulkanUploadManager::Retire()
+	{
+		if (m_InFlight.empty())
+			return;
+
+		auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice();
+
+		uint64_t value = 0;
+		if (vkGetSemaphoreCounterValue(device, m_Timeline, &value) != VK_SUCCESS)
+			APP_LOG_ERROR("Failed to get the upload timeline's value!");
+
+		VulkanAllocator allocator = {};
+		while (!m_InFlight.empty() && m_InFlight.front().Value <= value)
+		{
+			Batch& batch = m_InFlight.front();
+
+			// Note(Jorben): The ring might have been moved along while it was empty, the tail never goes back
+			m_Tail = std::max(m_Tail, batch.RingEnd);
+
+			for (auto& [buffer, allocation] : batch.Dedicated)
+				allocator.DestroyBuffer(buffer, allocation);
+
+			m_FreeCommandBuffers.emplace_back(batch.Transfer, batch.Graphics);
+			m_Completed.store(batch.Value, std::memory_order_release);
+
+			m_InFlight.pop_front();
+		}
+	}
+
+	void VulkanUploadManager::TakeCallbacks(std::vector<std::function<void()>>& callbacks)
+	{
+		uint64_t completed = m_Completed.load(std::memory_order_acquire);
+
+		for (size_t i = 0; i < m_Callbacks.size();)
+		{
+			if (m_Callbacks[i].first > completed)
+			{
+				i++;
+				continue;
+			}
+
+			callbacks.push_back(std::move(m_Callbacks[i].second));
+			m_Callbacks.erase(m_Callbacks.begin() + i);
+		}
+	}
+
+	void VulkanUploadManager::WaitForValue(uint64_t value) const
+	{
+		VkSemaphoreWaitInfo waitInfo = {};
+		waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+		waitInfo.semaphoreCount = 1;
+		waitInfo.pSemaphores = &m_Timeline;
+		waitInfo.pValues = &value;
+
+		auto device = ((VulkanRenderer*)Renderer::GetInstance())->GetLogicalDevice()->GetVulkanDevice();
+		if (vkWaitSemaphores(device, &waitInfo, MAX_UINT64) != VK_SUCCESS)
+			APP_LOG_ERROR("Failed to wait on the upload timeline semaphore!");
+	}
+
+}
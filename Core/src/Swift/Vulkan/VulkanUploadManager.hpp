@@ -0,0 +1,118 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <functional>
+
+#include "Swift/Core/Core.hpp"
+#include "Swift/Utils/Utils.hpp"
+
+#include "Swift/Renderer/UploadManager.hpp"
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+namespace Swift
+{
+
+	// Every batch is recorded into a command buffer of the transfer family, which copies out of the staging ring. With a transfer
+	// family of its own a second command buffer on the graphics queue acquires everything and does what a copy engine can't (blits).
+	// A batch signals the manager's own timeline semaphore, which is polled to find out what's done.
+	// Note(Jorben): The transfer half signals a timeline of its own, a timeline can't be signalled out of order from two queues.
+	// Note(Jorben): Staging can happen from any thread, everything is guarded by a single mutex.
+	class VulkanUploadManager : public UploadManager
+	{
+	public:
+		VulkanUploadManager(size_t stagingSize);
+		virtual ~VulkanUploadManager();
+
+		void Flush() override;
+		void Poll() override;
+		void Wait(UploadPoint point) override;
+
+		bool IsComplete(UploadPoint point) const override;
+		UploadPoint GetPoint() const override;
+
+		void OnComplete(std::function<void()> callback, UploadPoint point) override;
+
+		inline size_t GetCapacity() const override { return m_Size; }
+		size_t GetUsed() const override;
+
+		// Copies the data into the buffer (created with VK_BUFFER_USAGE_TRANSFER_DST_BIT) at the offset.
+		// Note(Jorben): Once the point is reached the range is owned by the graphics family.
+		UploadPoint StageBuffer(VkBuffer buffer, const void* data, size_t size, VkDeviceSize offset = 0);
+		// Copies the data into the first mip level, finish is recorded on the graphics queue with every level in VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL.
+		// That's where the other levels are generated and the image is transitioned into its final layout.
+		UploadPoint StageImage(VkImage image, VkFormat format, uint32_t width, uint32_t height, uint32_t mipLevels, const void* data, size_t size, const std::function<void(VkCommandBuffer)>& finish);
+
+	private:
+		struct Batch
+		{
+		public:
+			uint64_t Value = 0;
+
+			VkCommandBuffer Transfer = VK_NULL_HANDLE;
+			VkCommandBuffer Graphics = VK_NULL_HANDLE; // Same as Transfer without a transfer family of its own
+
+			uint64_t RingEnd = 0;
+			std::vector<std::pair<VkBuffer, VmaAllocation>> Dedicated = { }; // Staging buffers of uploads that don't fit in the ring
+		};
+
+		struct Staging
+		{
+		public:
+			VkBuffer Buffer = VK_NULL_HANDLE;
+			VmaAllocation Allocation = VK_NULL_HANDLE;
+			VkDeviceSize Offset = 0;
+			void* Data = nullptr;
+
+			bool Dedicated = false;
+		};
+
+		// Note(Jorben): Everything below expects m_Mutex to be locked
+		Staging Allocate(size_t size);
+		bool TryAllocate(size_t size, uint64_t& start);
+
+		Batch& GetOpenBatch();
+		void Submit();
+		void Retire();
+		void TakeCallbacks(std::vector<std::function<void()>>& callbacks);
+
+		void WaitForValue(uint64_t value) const;
+
+	private:
+		// Note(Jorben): Positions only ever grow, where they are in the buffer is the position modulo the size
+		VkBuffer m_Buffer = VK_NULL_HANDLE;
+		VmaAllocation m_Allocation = VK_NULL_HANDLE;
+		void* m_MappedData = nullptr;
+
+		size_t m_Size = 0;
+		size_t m_Alignment = 0;
+		uint64_t m_Head = 0;
+		uint64_t m_Tail = 0;
+
+		VkSemaphore m_Timeline = VK_NULL_HANDLE;
+		VkSemaphore m_TransferTimeline = VK_NULL_HANDLE; // Only with a transfer family of its own
+		uint64_t m_NextValue = 1;
+		uint64_t m_Submitted = 0;
+		std::atomic<uint64_t> m_Completed = 0;
+
+		bool m_AsyncTransfer = false;
+		uint32_t m_TransferFamily = 0;
+		uint32_t m_GraphicsFamily = 0;
+		VkCommandPool m_TransferCommandPool = VK_NULL_HANDLE;
+		VkCommandPool m_GraphicsCommandPool = VK_NULL_HANDLE;
+
+		Batch m_Open = {};
+		bool m_Recording = false;
+		std::deque<Batch> m_InFlight = { };
+		std::vector<std::pair<VkCommandBuffer, VkCommandBuffer>> m_FreeCommandBuffers = { };
+
+		std::vector<std::pair<uint64_t, std::function<void()>>> m_Callbacks = { };
+
+		mutable std::mutex m_Mutex = {};
+	};
+
+}
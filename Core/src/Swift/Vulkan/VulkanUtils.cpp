@@ -63,6 +63,7 @@ namespace Swift
 		submitInfo.commandBufferCount = 1;
 		submitInfo.pCommandBuffers = &m_CommandBuffer;
 
+		std::scoped_lock<std::mutex> lock(renderer->GetLogicalDevice()->GetQueueMutex());
 		vkQueueSubmit(renderer->GetLogicalDevice()->GetGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
 		vkQueueWaitIdle(renderer->GetLogicalDevice()->GetGraphicsQueue());
 	}
@@ -95,6 +96,28 @@ namespace Swift
 		return allocation;
 	}
 
+	VmaAllocation VulkanAllocator::AllocateMappedBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage, VkBuffer& dstBuffer, void*& mappedData, VkMemoryPropertyFlags requiredFlags)
+	{
+		VkBufferCreateInfo bufferInfo = {};
+		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.size = size;
+		bufferInfo.usage = usage;
+		bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		VmaAllocationCreateInfo allocInfo = {};
+		allocInfo.usage = memoryUsage;
+		allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+		allocInfo.requiredFlags = requiredFlags;
+
+		VmaAllocation allocation = VK_NULL_HANDLE;
+		VmaAllocationInfo allocationInfo = {};
+		if (vmaCreateBuffer(s_Allocator, &bufferInfo, &allocInfo, &dstBuffer, &allocation, &allocationInfo) != VK_SUCCESS)
+			APP_LOG_ERROR("Failed to allocate mapped buffer.");
+
+		mappedData = allocationInfo.pMappedData;
+		return allocation;
+	}
+
 	void VulkanAllocator::CopyBuffer(VkBuffer& srcBuffer, VkBuffer& dstBuffer, VkDeviceSize size)
 	{
 		VulkanCommand command = VulkanCommand(true);
@@ -233,6 +256,16 @@ namespace Swift
 		vmaUnmapMemory(s_Allocator, allocation);
 	}
 
+	void VulkanAllocator::FlushMemory(VmaAllocation& allocation, VkDeviceSize offset, VkDeviceSize size)
+	{
+		vmaFlushAllocation(s_Allocator, allocation, offset, size);
+	}
+
+	void VulkanAllocator::InvalidateMemory(VmaAllocation& allocation, VkDeviceSize offset, VkDeviceSize size)
+	{
+		vmaInvalidateAllocation(s_Allocator, allocation, offset, size);
+	}
+
 	uint32_t VulkanAllocator::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties)
 	{
 		VkPhysicalDeviceMemoryProperties memProperties = {};
@@ -281,6 +314,14 @@ namespace Swift
 			return;
 
 		VulkanCommand command = VulkanCommand(true);
+		TransitionImageLayout(command.GetVulkanCommandBuffer(), image, format, oldLayout, newLayout, mipLevels);
+		command.EndAndSubmit();
+	}
+
+	void VulkanAllocator::TransitionImageLayout(VkCommandBuffer commandBuffer, VkImage& image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels)
+	{
+		if (oldLayout == newLayout)
+			return;
 
 		VkImageMemoryBarrier barrier = {};
 		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -352,20 +393,21 @@ namespace Swift
 			sourceStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
 			destinationStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
 		}
+		// Note(Jorben): The read only depth layout is also sampled from compute (light culling), so the compute stage is included.
 		else if (oldLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL)
 		{
 			barrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-			barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+			barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
 
 			sourceStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-			destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+			destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
 		}
 		else if (oldLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL)
 		{
-			barrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
-			barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+			barrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+			barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
-			sourceStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+			sourceStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
 			destinationStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
 		}
 
@@ -507,9 +549,53 @@ namespace Swift
 		else
 			APP_LOG_ERROR("Unsupported layout transition!");
 
-		vkCmdPipelineBarrier(command.GetVulkanCommandBuffer(), sourceStage, destinationStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+		vkCmdPipelineBarrier(commandBuffer, sourceStage, destinationStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+	}
 
-		command.EndAndSubmit();
+	void VulkanAllocator::TransferImageOwnership(VkCommandBuffer commandBuffer, VkImage& image, VkImageAspectFlags aspect, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels, uint32_t srcFamily, uint32_t dstFamily, bool acquire, VkPipelineStageFlags stage, VkAccessFlags access)
+	{
+		VkImageMemoryBarrier barrier = {};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.oldLayout = oldLayout;
+		barrier.newLayout = newLayout;
+		barrier.srcQueueFamilyIndex = srcFamily;
+		barrier.dstQueueFamilyIndex = dstFamily;
+
+		barrier.image = image;
+		barrier.subresourceRange.aspectMask = aspect;
+		barrier.subresourceRange.baseMipLevel = 0;
+		barrier.subresourceRange.levelCount = mipLevels;
+		barrier.subresourceRange.baseArrayLayer = 0;
+		barrier.subresourceRange.layerCount = 1;
+
+		// Note(Jorben): The release makes the source queue's writes available, the acquire makes them visible to the destination queue.
+		// The other half of each barrier is ignored, the semaphore between the two submissions orders them.
+		barrier.srcAccessMask = (acquire ? 0 : access);
+		barrier.dstAccessMask = (acquire ? access : 0);
+
+		VkPipelineStageFlags sourceStage = stage;
+		VkPipelineStageFlags destinationStage = (acquire ? stage : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+
+		vkCmdPipelineBarrier(commandBuffer, sourceStage, destinationStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+	}
+
+	void VulkanAllocator::TransferBufferOwnership(VkCommandBuffer commandBuffer, VkBuffer buffer, uint32_t srcFamily, uint32_t dstFamily, bool acquire, VkPipelineStageFlags stage, VkAccessFlags access, VkDeviceSize offset, VkDeviceSize size)
+	{
+		VkBufferMemoryBarrier barrier = {};
+		barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		barrier.srcQueueFamilyIndex = srcFamily;
+		barrier.dstQueueFamilyIndex = dstFamily;
+		barrier.buffer = buffer;
+		barrier.offset = offset;
+		barrier.size = size;
+
+		barrier.srcAccessMask = (acquire ? 0 : access);
+		barrier.dstAccessMask = (acquire ? access : 0);
+
+		VkPipelineStageFlags sourceStage = stage;
+		VkPipelineStageFlags destinationStage = (acquire ? stage : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+
+		vkCmdPipelineBarrier(commandBuffer, sourceStage, destinationStage, 0, 0, nullptr, 1, &barrier, 0, nullptr);
 	}
 
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -33,6 +33,8 @@ namespace Swift
 		virtual ~VulkanAllocator() = default;
 
 		VmaAllocation AllocateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage, VkBuffer& dstBuffer, VkMemoryPropertyFlags requiredFlags = 0);
+		// Note(Jorben): The memory stays mapped for the lifetime of the allocation, mappedData is valid until DestroyBuffer
+		VmaAllocation AllocateMappedBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage, VkBuffer& dstBuffer, void*& mappedData, VkMemoryPropertyFlags requiredFlags = 0);
 		void CopyBuffer(VkBuffer& srcBuffer, VkBuffer& dstBuffer, VkDeviceSize size);
 		void DestroyBuffer(VkBuffer buffer, VmaAllocation allocation);
 
@@ -46,6 +48,10 @@ namespace Swift
 		static void MapMemory(VmaAllocation& allocation, void*& mapData);
 		static void UnMapMemory(VmaAllocation& allocation);
 
+		// Both are no-ops for host coherent memory
+		static void FlushMemory(VmaAllocation& allocation, VkDeviceSize offset, VkDeviceSize size);
+		static void InvalidateMemory(VmaAllocation& allocation, VkDeviceSize offset, VkDeviceSize size);
+
 		static uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
 		static bool HasStencilComponent(VkFormat format);
 
@@ -53,6 +59,14 @@ namespace Swift
 		static VkFormat FindSupportedFormat(const std::vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features);
 
 		static void TransitionImageLayout(VkImage& image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels);
+		// Records the barrier into an already recording command buffer, no submission or waiting.
+		static void TransitionImageLayout(VkCommandBuffer commandBuffer, VkImage& image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels);
+
+		// Records one half of a queue family ownership transfer, the release on the source family and the acquire (with the same layouts) on the destination family.
+		// Stage & access are how the recording queue used (release) or is going to use (acquire) the resource.
+		static void TransferImageOwnership(VkCommandBuffer commandBuffer, VkImage& image, VkImageAspectFlags aspect, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels, uint32_t srcFamily, uint32_t dstFamily, bool acquire, VkPipelineStageFlags stage, VkAccessFlags access);
+		// Note(Jorben): Ownership of a buffer is per range, the rest of the buffer stays with its current family.
+		static void TransferBufferOwnership(VkCommandBuffer commandBuffer, VkBuffer buffer, uint32_t srcFamily, uint32_t dstFamily, bool acquire, VkPipelineStageFlags stage, VkAccessFlags access, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
 
 	public:
 		static void Init();
@@ -0,0 +1,166 @@
+#version 460 core
+
+#extension GL_GOOGLE_include_directive : require
+
+#include "shared/LightCulling.h"
+
+// Note(Jorben): One workgroup per cluster, dispatched as (clusters.x, clusters.y, CLUSTER_DEPTH_SLICES)
+layout(local_size_x = CLUSTER_THREADS, local_size_y = 1, local_size_z = 1) in;
+
+///////////////////////////////////////////////////////////////////////
+// Structs
+///////////////////////////////////////////////////////////////////////
+// Camera
+struct Camera
+{
+    mat4 View;
+    mat4 Projection;
+	vec2 DepthUnpackConsts;
+	vec2 ClipPlanes; // x = Near, y = Far
+};
+
+// PointLight
+struct PointLight
+{
+    vec3 Position;
+    float Radius;
+
+    vec3 Colour;
+    float Intensity;
+};
+///////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////
+// Inputs
+///////////////////////////////////////////////////////////////////////
+// Set 0
+layout(std140, set = 0, binding = 0) buffer LightsBuffer
+{
+    uint AmountOfPointLights;
+    PointLight PointLights[MAX_POINTLIGHTS];
+} u_Lights;
+
+layout(std430, set = 0, binding = 1) buffer LightVisibilityBuffer
+{
+	uint AmountOfTiles;
+    uvec2 Cells[/*Amount of Tiles*/]; // x = Offset into u_LightIndices, y = Count
+} u_Visibility;
+
+layout(std430, set = 0, binding = 2) buffer LightIndexBuffer
+{
+    uint Counter;
+    uint Indices[];
+} u_LightIndices;
+
+// Set 1
+layout(std140, set = 1, binding = 0) uniform CameraUniform
+{
+    Camera Camera;
+} u_Camera;
+
+layout(std140, set = 1, binding = 1) uniform SceneUniform
+{
+    uvec2 ScreenSize;
+    uint LightAssignment;
+} u_Scene;
+///////////////////////////////////////////////////////////////////////
+
+// Shared values between all the threads in the group
+shared vec3 clusterMin;
+shared vec3 clusterMax;
+
+shared uint visiblePointLightCount;
+shared uint visiblePointLightIndices[MAX_POINTLIGHTS];
+
+// Range of this cluster in the global index pool
+shared uint clusterOffset;
+shared uint clusterCount;
+
+void main()
+{
+    uvec3 clusterID = gl_WorkGroupID;
+    uvec3 clusterNumber = gl_NumWorkGroups;
+    uint index = clusterID.z * clusterNumber.x * clusterNumber.y + clusterID.y * clusterNumber.x + clusterID.x;
+
+    // Step 1: One thread calculates the view space AABB of this cluster
+    if (gl_LocalInvocationIndex == 0)
+    {
+		mat4 inverseProjection = inverse(u_Camera.Camera.Projection);
+
+		vec2 minScreen = vec2(clusterID.xy * CLUSTER_TILE_SIZE);
+		vec2 maxScreen = min(vec2((clusterID.xy + 1) * CLUSTER_TILE_SIZE), vec2(u_Scene.ScreenSize));
+
+		float sliceNear = GetClusterSliceDepth(clusterID.z, u_Camera.Camera.ClipPlanes);
+		float sliceFar = GetClusterSliceDepth(clusterID.z + 1, u_Camera.Camera.ClipPlanes);
+
+		vec3 minimum = vec3(3.402823466e+38);
+		vec3 maximum = vec3(-3.402823466e+38);
+
+		// Intersect the 4 corner rays of the tile with the slice's near and far plane
+		for (uint i = 0; i < 4; i++)
+		{
+		    vec2 screen = vec2((i & 1u) == 0 ? minScreen.x : maxScreen.x, (i & 2u) == 0 ? minScreen.y : maxScreen.y);
+		    vec2 ndc = screen / vec2(u_Scene.ScreenSize) * 2.0 - 1.0;
+
+		    vec4 view = inverseProjection * vec4(ndc, 1.0, 1.0);
+		    vec3 ray = view.xyz / view.w;
+
+		    vec3 nearPoint = ray * (sliceNear / -ray.z);
+		    vec3 farPoint = ray * (sliceFar / -ray.z);
+
+		    minimum = min(minimum, min(nearPoint, farPoint));
+		    maximum = max(maximum, max(nearPoint, farPoint));
+		}
+
+		clusterMin = minimum;
+		clusterMax = maximum;
+		visiblePointLightCount = 0;
+    }
+
+    barrier();
+
+    // Step 2: Cull lights, parallelized over the threads in the group
+    for (uint lightIndex = gl_LocalInvocationIndex; lightIndex < u_Lights.AmountOfPointLights; lightIndex += CLUSTER_THREADS)
+    {
+		vec3 center = (u_Camera.Camera.View * vec4(u_Lights.PointLights[lightIndex].Position, 1.0)).xyz;
+		float radius = u_Lights.PointLights[lightIndex].Radius;
+
+		// Sphere vs AABB
+		vec3 closest = clamp(center, clusterMin, clusterMax);
+		vec3 difference = closest - center;
+		if (dot(difference, difference) <= radius * radius)
+		{
+		    uint offset = atomicAdd(visiblePointLightCount, 1);
+		    visiblePointLightIndices[offset] = lightIndex;
+		}
+    }
+
+    barrier();
+
+    // Step 3: One thread allocates a contiguous range in the global index pool
+    if (gl_LocalInvocationIndex == 0)
+    {
+		uint offset = atomicAdd(u_LightIndices.Counter, GetLightIndexWords(visiblePointLightCount));
+		uint capacity = uint(u_LightIndices.Indices.length());
+
+		// Note(Jorben): If the pool runs out the remaining lights of this cluster are dropped
+		uint available = (offset < capacity) ? (capacity - offset) : 0u;
+
+		clusterOffset = offset;
+		clusterCount = min(visiblePointLightCount, available * LIGHT_INDICES_PER_UINT);
+		u_Visibility.Cells[index] = uvec2(clusterOffset, clusterCount);
+
+		if (index == 0)
+		    u_Visibility.AmountOfTiles = clusterNumber.x * clusterNumber.y * clusterNumber.z;
+    }
+
+    barrier();
+
+    // Step 4: All threads copy the visible indices into the pool in parallel
+    for (uint i = gl_LocalInvocationIndex * LIGHT_INDICES_PER_UINT; i < clusterCount; i += CLUSTER_THREADS * LIGHT_INDICES_PER_UINT)
+    {
+		uint first = visiblePointLightIndices[i];
+		uint second = (i + 1 < clusterCount) ? visiblePointLightIndices[i + 1] : 0u;
+		u_LightIndices.Indices[clusterOffset + (i / LIGHT_INDICES_PER_UINT)] = PackLightIndices(first, second);
+    }
+}
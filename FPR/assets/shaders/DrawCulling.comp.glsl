@@ -0,0 +1,132 @@
+#version 460 core
+
+#extension GL_GOOGLE_include_directive : require
+
+#include "shared/DrawCulling.h"
+
+layout(local_size_x = DRAW_CULLING_THREADS, local_size_y = 1, local_size_z = 1) in;
+
+///////////////////////////////////////////////////////////////////////
+// Structs
+///////////////////////////////////////////////////////////////////////
+// Camera
+struct Camera
+{
+    mat4 View;
+    mat4 Projection;
+	vec2 DepthUnpackConsts;
+	vec2 ClipPlanes; // x = Near, y = Far
+};
+
+// Every instance with the same mesh & albedo
+struct Batch
+{
+    vec4 Bounds; // xyz = Center, w = Radius of the mesh's bounding sphere in local space
+    uint Command; // Index of the batch's command in the draw buffer
+};
+
+// VkDrawIndexedIndirectCommand
+struct DrawCommand
+{
+    uint IndexCount;
+    uint InstanceCount;
+    uint FirstIndex;
+    int VertexOffset;
+    uint FirstInstance;
+};
+///////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////
+// Inputs
+///////////////////////////////////////////////////////////////////////
+// Set 0
+layout(std430, set = 0, binding = 0) readonly buffer BatchBuffer
+{
+    Batch Batches[];
+} u_Batches;
+
+layout(std430, set = 0, binding = 1) readonly buffer InstanceBuffer
+{
+    uint AmountOfInstances;
+    uint Batches[];
+} u_Instances;
+
+layout(std430, set = 0, binding = 2) readonly buffer ModelBuffer
+{
+    mat4 Models[];
+} u_Models;
+
+layout(std430, set = 0, binding = 3) writeonly buffer VisibleBuffer
+{
+    uint Instances[];
+} u_Visible;
+
+layout(std430, set = 0, binding = 4) buffer DrawBuffer
+{
+    uint Count;
+    uint Padding0;
+    uint Padding1;
+    uint Padding2;
+    DrawCommand Commands[];
+} u_Draws;
+
+// Set 1
+layout(std140, set = 1, binding = 0) uniform CameraUniform
+{
+    Camera Camera;
+} u_Camera;
+///////////////////////////////////////////////////////////////////////
+
+// Shared values between all the threads in the group
+shared vec4 frustumPlanes[6];
+
+void main()
+{
+    // Step 1: One thread extracts the world space frustum planes (pointing inwards) out of the view projection matrix
+    if (gl_LocalInvocationIndex == 0)
+    {
+        mat4 viewProjection = u_Camera.Camera.Projection * u_Camera.Camera.View;
+        vec4 row0 = vec4(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+        vec4 row1 = vec4(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+        vec4 row2 = vec4(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+        vec4 row3 = vec4(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+        frustumPlanes[0] = row3 + row0; // Left
+        frustumPlanes[1] = row3 - row0; // Right
+        frustumPlanes[2] = row3 + row1; // Bottom
+        frustumPlanes[3] = row3 - row1; // Top
+        frustumPlanes[4] = row3 + row2; // Near (glm::perspective, -1 to 1 depth)
+        frustumPlanes[5] = row3 - row2; // Far
+
+        for (uint i = 0; i < 6; i++)
+            frustumPlanes[i] /= length(frustumPlanes[i].xyz);
+    }
+
+    barrier();
+
+    uint instance = gl_GlobalInvocationID.x;
+    if (instance >= u_Instances.AmountOfInstances)
+        return;
+
+    // Step 2: Test the instance's bounding sphere against every plane
+    uint batch = u_Instances.Batches[instance];
+    vec4 bounds = u_Batches.Batches[batch].Bounds;
+    uint command = u_Batches.Batches[batch].Command;
+    mat4 model = u_Models.Models[instance];
+
+    vec3 center = (model * vec4(bounds.xyz, 1.0)).xyz;
+    float scale = sqrt(max(max(dot(model[0].xyz, model[0].xyz), dot(model[1].xyz, model[1].xyz)), dot(model[2].xyz, model[2].xyz)));
+    float radius = bounds.w * scale;
+
+    for (uint i = 0; i < 6; i++)
+    {
+        if (dot(frustumPlanes[i].xyz, center) + frustumPlanes[i].w < -radius)
+            return;
+    }
+
+    // Step 3: Append the instance to its batch's draw
+    uint slot = atomicAdd(u_Draws.Commands[command].InstanceCount, 1u);
+    u_Visible.Instances[u_Draws.Commands[command].FirstInstance + slot] = instance;
+
+    atomicMax(u_Draws.Count, command + 1u);
+}
@@ -1,14 +1,23 @@
 #version 460 core
 
-#define TILE_SIZE 16
-#define MAX_POINTLIGHTS 1024
-#define MAX_POINTLIGHTS_PER_TILE 64
+#extension GL_GOOGLE_include_directive : require
+
+#include "shared/LightCulling.h"
 
 layout(local_size_x = TILE_SIZE, local_size_y = TILE_SIZE, local_size_z = 1) in;
 
 ///////////////////////////////////////////////////////////////////////
 // Structs
 ///////////////////////////////////////////////////////////////////////
+// Camera
+struct Camera
+{
+    mat4 View;
+    mat4 Projection;
+	vec2 DepthUnpackConsts;
+	vec2 ClipPlanes; // x = Near, y = Far
+};
+
 // PointLight
 struct PointLight
 {
@@ -18,12 +27,6 @@ struct PointLight
     vec3 Colour;
     float Intensity;
 };
-
-struct PointLightVisibilty
-{
-    uint Count;
-    uint Indices[MAX_POINTLIGHTS_PER_TILE];
-};
 ///////////////////////////////////////////////////////////////////////
 
 ///////////////////////////////////////////////////////////////////////
@@ -32,35 +35,63 @@ struct PointLightVisibilty
 // Set 0
 layout(rgba8, set = 0, binding = 0) uniform writeonly image2D u_Image;
 
-layout(std140, set = 0, binding = 1) buffer LightVisibilityBuffer 
+layout(std430, set = 0, binding = 1) readonly buffer LightVisibilityBuffer
 {
 	uint AmountOfTiles;
-    PointLightVisibilty VisiblePointLights[/*Amount of Tiles*/];
+    uvec2 Cells[/*Amount of Tiles*/]; // x = Offset into u_LightIndices, y = Count
 } u_Visibility;
 
+layout(set = 0, binding = 2) uniform sampler2D u_DepthBuffer;
+
 // Set 1
 layout(std140, set = 1, binding = 0) uniform SceneUniform 
 {
     uvec2 ScreenSize;
+    uint LightAssignment;
 } u_Scene;
+
+layout(std140, set = 1, binding = 1) uniform CameraSettings
+{
+    Camera Camera;
+} u_Camera;
 ///////////////////////////////////////////////////////////////////////
 
+// From XeGTAO
+float ScreenSpaceToViewSpaceDepth(const float screenDepth)
+{
+	float depthLinearizeMul = u_Camera.Camera.DepthUnpackConsts.x;
+	float depthLinearizeAdd = u_Camera.Camera.DepthUnpackConsts.y;
+	return depthLinearizeMul / (depthLinearizeAdd - screenDepth);
+}
+
 void main()
 {
-    ivec2 pixelCoords = ivec2(gl_GlobalInvocationID.xy);
-    
-    // Calculate tile index
-    ivec2 location = ivec2(gl_GlobalInvocationID.xy);
-    ivec2 itemID = ivec2(gl_LocalInvocationID.xy);
-    ivec2 tileID = ivec2(gl_WorkGroupID.xy);
-    ivec2 tileNumber = ivec2(gl_NumWorkGroups.xy);
-    uint tileIndex = tileID.y * tileNumber.x + tileID.x;
-
-    // Access visibility data for the current tile
-    PointLightVisibilty tileVisibility = u_Visibility.VisiblePointLights[tileIndex];
-
-    // Calculate heatmap value based on the number of visible point lights in this tile
-    float heatmapValue = float(tileVisibility.Count)/* / float(MAX_POINTLIGHTS_PER_TILE)*/;
+    // Note(Jorben): One invocation per pixel, the cell is looked up from the pixel (and its depth) the same way Shading.frag does,
+    // so the heatmap shows the tile grid in tiled mode and the cluster grid in clustered mode
+    uvec2 pixelCoords = gl_GlobalInvocationID.xy;
+
+    if (any(greaterThanEqual(pixelCoords, u_Scene.ScreenSize)))
+        return;
+
+    // Access visibility data for the tile this pixel is in, or the cluster its depth falls in
+    uint cellIndex = 0;
+    if (u_Scene.LightAssignment == LIGHT_ASSIGNMENT_CLUSTERED)
+    {
+        vec2 tc = (vec2(pixelCoords) + 0.5) / vec2(u_Scene.ScreenSize);
+        float viewDepth = ScreenSpaceToViewSpaceDepth(textureLod(u_DepthBuffer, tc, 0).r);
+        cellIndex = GetClusterIndex(pixelCoords, viewDepth, u_Scene.ScreenSize, u_Camera.Camera.ClipPlanes);
+    }
+    else
+    {
+        uint tilesX = (u_Scene.ScreenSize.x + TILE_SIZE - 1) / TILE_SIZE;
+        uvec2 tileID = pixelCoords / TILE_SIZE;
+        cellIndex = tileID.y * tilesX + tileID.x;
+    }
+
+    uint lightCount = u_Visibility.Cells[cellIndex].y;
+
+    // Calculate heatmap value based on the number of visible point lights in this tile/cluster
+    float heatmapValue = float(lightCount);
 
     // Write heatmap value to image
     imageStore(u_Image, pixelCoords, vec4(heatmapValue));
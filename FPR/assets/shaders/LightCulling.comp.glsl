@@ -1,8 +1,8 @@
 #version 460 core
 
-#define TILE_SIZE 16
-#define MAX_POINTLIGHTS 1024
-#define MAX_POINTLIGHTS_PER_TILE 64
+#extension GL_GOOGLE_include_directive : require
+
+#include "shared/LightCulling.h"
 
 layout(local_size_x = TILE_SIZE, local_size_y = TILE_SIZE, local_size_z = 1) in;
 
@@ -15,6 +15,7 @@ struct Camera
     mat4 View;
     mat4 Projection;
 	vec2 DepthUnpackConsts;
+	vec2 ClipPlanes; // x = Near, y = Far
 };
 
 // PointLight
@@ -26,12 +27,6 @@ struct PointLight
     vec3 Colour;
     float Intensity;
 };
-
-struct PointLightVisibilty
-{
-    uint Count;
-    uint Indices[MAX_POINTLIGHTS_PER_TILE];
-};
 ///////////////////////////////////////////////////////////////////////
 
 ///////////////////////////////////////////////////////////////////////
@@ -46,12 +41,18 @@ layout(std140, set = 0, binding = 1) buffer LightsBuffer
     PointLight PointLights[MAX_POINTLIGHTS];
 } u_Lights;
 
-layout(std140, set = 0, binding = 2) buffer LightVisibilityBuffer 
+layout(std430, set = 0, binding = 2) buffer LightVisibilityBuffer
 {
 	uint AmountOfTiles;
-    PointLightVisibilty VisiblePointLights[/*Amount of Tiles*/];
+    uvec2 Cells[/*Amount of Tiles*/]; // x = Offset into u_LightIndices, y = Count
 } u_Visibility;
 
+layout(std430, set = 0, binding = 3) buffer LightIndexBuffer
+{
+    uint Counter;
+    uint Indices[];
+} u_LightIndices;
+
 // Set 1
 layout(std140, set = 1, binding = 0) uniform CameraUniform 
 {
@@ -61,6 +62,7 @@ layout(std140, set = 1, binding = 0) uniform CameraUniform
 layout(std140, set = 1, binding = 1) uniform SceneUniform 
 {
     uvec2 ScreenSize;
+    uint LightAssignment;
 } u_Scene;
 ///////////////////////////////////////////////////////////////////////
 
@@ -84,6 +86,10 @@ shared vec4 frustumPlanes[6];
 // Shared local storage for visible indices, will be written out to the global buffer at the end
 shared int visiblePointLightIndices[MAX_POINTLIGHTS];
 
+// Range of this tile in the global index pool
+shared uint tileOffset;
+shared uint tileCount;
+
 void main()
 {
     ivec2 location = ivec2(gl_GlobalInvocationID.xy);
@@ -186,16 +192,29 @@ void main()
 
     barrier();
 
-    // One thread should fill the global light buffer
+    // Step 4: One thread allocates a contiguous range in the global index pool
     if (gl_LocalInvocationIndex == 0)
     {
-		const uint offset = index * MAX_POINTLIGHTS_PER_TILE; // Determine position in global buffer
-		for (uint i = 0; i < visiblePointLightCount; i++) 
-		{
-			u_Visibility.VisiblePointLights[index].Indices[i] = uint(visiblePointLightIndices[i]);
-		}
-		u_Visibility.VisiblePointLights[index].Count = visiblePointLightCount;
+		uint offset = atomicAdd(u_LightIndices.Counter, GetLightIndexWords(visiblePointLightCount));
+		uint capacity = uint(u_LightIndices.Indices.length());
+
+		// Note(Jorben): If the pool runs out the remaining lights of this tile are dropped
+		uint available = (offset < capacity) ? (capacity - offset) : 0u;
+
+		tileOffset = offset;
+		tileCount = min(visiblePointLightCount, available * LIGHT_INDICES_PER_UINT);
+		u_Visibility.Cells[index] = uvec2(tileOffset, tileCount);
 
 		u_Visibility.AmountOfTiles = (u_Scene.ScreenSize.x + TILE_SIZE - 1) / TILE_SIZE * (u_Scene.ScreenSize.y + TILE_SIZE - 1) / TILE_SIZE;
     }
+
+    barrier();
+
+    // Step 5: All threads copy the visible indices into the pool in parallel
+    for (uint i = gl_LocalInvocationIndex * LIGHT_INDICES_PER_UINT; i < tileCount; i += threadCount * LIGHT_INDICES_PER_UINT)
+    {
+		uint first = uint(visiblePointLightIndices[i]);
+		uint second = (i + 1 < tileCount) ? uint(visiblePointLightIndices[i + 1]) : 0u;
+		u_LightIndices.Indices[tileOffset + (i / LIGHT_INDICES_PER_UINT)] = PackLightIndices(first, second);
+    }
 }
\ No newline at end of file
@@ -1,18 +1,27 @@
 #version 460 core
 
+#extension GL_GOOGLE_include_directive : require
+
+#include "shared/LightCulling.h"
+
 layout(location = 0) out vec4 o_Colour;
 
 layout(location = 0) in vec3 v_Position;
 layout(location = 1) in vec2 v_TexCoord;
 layout(location = 2) in vec3 v_Normal;
 
-#define TILE_SIZE 16
-#define MAX_POINTLIGHTS 1024
-#define MAX_POINTLIGHTS_PER_TILE 64
-
 ///////////////////////////////////////////////////////////////////////
 // Structs
 ///////////////////////////////////////////////////////////////////////
+// Camera
+struct Camera
+{
+    mat4 View;
+    mat4 Projection;
+	vec2 DepthUnpackConsts;
+	vec2 ClipPlanes; // x = Near, y = Far
+};
+
 // PointLight
 struct PointLight
 {
@@ -22,39 +31,54 @@ struct PointLight
     vec3 Colour;
     float Intensity;
 };
-
-struct PointLightVisibilty
-{
-    uint Count;
-    uint Indices[MAX_POINTLIGHTS_PER_TILE];
-};
 ///////////////////////////////////////////////////////////////////////
 
 ///////////////////////////////////////////////////////////////////////
 // Inputs
 ///////////////////////////////////////////////////////////////////////
 // Set 0
-layout(set = 0, binding = 1) uniform sampler2D u_Albedo;
-
-layout(std140, set = 0, binding = 2) buffer LightsBuffer
+layout(std140, set = 0, binding = 1) buffer LightsBuffer
 {
     uint AmountOfPointLights;
     PointLight PointLights[MAX_POINTLIGHTS];
 } u_Lights;
 
-layout(std140, set = 0, binding = 3) buffer LightVisibilityBuffer 
+layout(std430, set = 0, binding = 2) readonly buffer LightVisibilityBuffer
 {
 	uint AmountOfTiles;
-    PointLightVisibilty VisiblePointLights[/*Amount of Tiles*/];
+    uvec2 Cells[/*Amount of Tiles*/]; // x = Offset into u_LightIndices, y = Count
 } u_Visibility;
 
+layout(std430, set = 0, binding = 3) readonly buffer LightIndexBuffer
+{
+    uint Counter;
+    uint Indices[];
+} u_LightIndices;
+
 // Set 1
+layout(std140, set = 1, binding = 0) uniform CameraSettings
+{
+    Camera Camera;
+} u_Camera;
+
 layout(std140, set = 1, binding = 1) uniform SceneUniform 
 {
     uvec2 ScreenSize;
+    uint LightAssignment;
 } u_Scene;
+
+// Set 2
+layout(set = 2, binding = 0) uniform sampler2D u_Albedo;
 ///////////////////////////////////////////////////////////////////////
 
+// From XeGTAO
+float ScreenSpaceToViewSpaceDepth(const float screenDepth)
+{
+	float depthLinearizeMul = u_Camera.Camera.DepthUnpackConsts.x;
+	float depthLinearizeAdd = u_Camera.Camera.DepthUnpackConsts.y;
+	return depthLinearizeMul / (depthLinearizeAdd - screenDepth);
+}
+
 vec3 CalculatePointLight(vec3 fragPos, vec3 normal, PointLight light) 
 {
     vec3 lightDir = normalize(light.Position - fragPos);
@@ -78,15 +102,25 @@ void main()
 
     vec3 resultColor = texture(u_Albedo, v_TexCoord).rgb; // base color
 
-    // Calculate tile index
-    ivec2 tileID = ivec2(gl_FragCoord) / ivec2(TILE_SIZE, TILE_SIZE);
-    uint tilesX = (u_Scene.ScreenSize.x + TILE_SIZE - 1) / TILE_SIZE;
-	uint index = tileID.y * tilesX + tileID.x;
+    // Calculate tile/cluster index
+    uint index = 0;
+    if (u_Scene.LightAssignment == LIGHT_ASSIGNMENT_CLUSTERED)
+    {
+        float viewDepth = ScreenSpaceToViewSpaceDepth(gl_FragCoord.z);
+        index = GetClusterIndex(uvec2(gl_FragCoord.xy), viewDepth, u_Scene.ScreenSize, u_Camera.Camera.ClipPlanes);
+    }
+    else
+    {
+        ivec2 tileID = ivec2(gl_FragCoord) / ivec2(TILE_SIZE, TILE_SIZE);
+        uint tilesX = (u_Scene.ScreenSize.x + TILE_SIZE - 1) / TILE_SIZE;
+        index = tileID.y * tilesX + tileID.x;
+    }
 
     // Iterate through visible point lights for this tile
-    for (uint i = 0; i < u_Visibility.VisiblePointLights[index].Count; i++) 
+    uvec2 cell = u_Visibility.Cells[index];
+    for (uint i = 0; i < cell.y; i++) 
     {
-        uint lightIndex = u_Visibility.VisiblePointLights[index].Indices[i];
+        uint lightIndex = UnpackLightIndex(u_LightIndices.Indices[cell.x + (i / LIGHT_INDICES_PER_UINT)], i);
         PointLight light = u_Lights.PointLights[lightIndex];
         
         // Calculate point light contribution
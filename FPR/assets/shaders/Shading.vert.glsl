@@ -4,6 +4,9 @@ layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec2 a_TexCoord;
 layout(location = 2) in vec3 a_Normal;
 
+// Note(Jorben): The shading pass tests against the depth pre-pass with LESS_OR_EQUAL, so both passes need bit-identical positions
+invariant gl_Position;
+
 layout(location = 0) out vec3 v_Position;
 layout(location = 1) out vec2 v_TexCoord;
 layout(location = 2) out vec3 v_Normal;
@@ -16,6 +19,7 @@ struct Camera
     mat4 View;
     mat4 Projection;
 	vec2 DepthUnpackConsts;
+	vec2 ClipPlanes; // x = Near, y = Far
 };
 ///////////////////////////////////////////////////////////////////////
 
@@ -23,10 +27,16 @@ struct Camera
 // Inputs
 ///////////////////////////////////////////////////////////////////////
 // Set 0
-layout(std140, set = 0, binding = 0) uniform ModelSettings
+layout(std430, set = 0, binding = 0) readonly buffer ModelBuffer
+{
+    mat4 Models[];
+} u_Models;
+
+// Note(Jorben): Indexed by gl_InstanceIndex, the draw culling pass wrote the visible instances of every batch from its firstInstance on
+layout(std430, set = 0, binding = 4) readonly buffer VisibleBuffer
 {
-    mat4 Model;
-} u_Model;
+    uint Instances[];
+} u_Visible;
 
 // Set 1
 layout(std140, set = 1, binding = 0) uniform CameraSettings
@@ -37,9 +47,10 @@ layout(std140, set = 1, binding = 0) uniform CameraSettings
 
 void main()
 {
-	gl_Position = u_Camera.Camera.Projection * u_Camera.Camera.View * u_Model.Model * vec4(a_Position, 1.0);
+	mat4 model = u_Models.Models[u_Visible.Instances[gl_InstanceIndex]];
+	gl_Position = u_Camera.Camera.Projection * u_Camera.Camera.View * model * vec4(a_Position, 1.0);
 	
-    v_Position = vec3(u_Model.Model * vec4(a_Position, 1.0));;
+    v_Position = vec3(model * vec4(a_Position, 1.0));
     v_TexCoord = a_TexCoord;
     v_Normal = a_Normal;
 }
\ No newline at end of file
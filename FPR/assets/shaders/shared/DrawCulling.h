@@ -0,0 +1,34 @@
+#ifndef FPR_SHARED_DRAWCULLING_H
+#define FPR_SHARED_DRAWCULLING_H
+
+///////////////////////////////////////////////////////////////////////
+// Note(Jorben): This file is included by both C++ (Resources.hpp) and GLSL,
+// so the culling buffers' layouts can't drift between the two.
+// Keep it to preprocessor definitions outside of the language specific blocks.
+///////////////////////////////////////////////////////////////////////
+// One thread per instance, dispatched as (ceil(instances / DRAW_CULLING_THREADS), 1, 1)
+#define DRAW_CULLING_THREADS 64
+
+// Draw buffer (std430), one command per batch (sorted by albedo, the batch buffer holds every batch's command index), written by the culling pass:
+// uint Count; // Last command with a visible instance + 1, reset to 0 every frame
+// uint Padding[3];
+// DrawCommand Commands[]; // InstanceCount is reset to 0 every frame
+#define DRAW_BUFFER_HEADER_UINTS 4
+
+// Instance buffer (std430), the batch every instance belongs to, only changed instances are written:
+// uint AmountOfInstances;
+// uint Batches[];
+#define INSTANCE_BUFFER_HEADER_UINTS 1
+
+// Visible buffer (std430), indexed by gl_InstanceIndex:
+// uint Instances[]; // Index into the model buffer, a batch's visible instances start at its command's FirstInstance
+
+#if defined(__cplusplus)
+	// Size in bytes of the instance buffer for the specified amount of instances
+	inline constexpr size_t InstanceBufferSize(uint32_t instances)
+	{
+		return sizeof(uint32_t) * (INSTANCE_BUFFER_HEADER_UINTS + (size_t)instances);
+	}
+#endif
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef FPR_SHARED_LIGHTCULLING_H
+#define FPR_SHARED_LIGHTCULLING_H
+
+///////////////////////////////////////////////////////////////////////
+// Note(Jorben): This file is included by both C++ (Resources.hpp) and GLSL,
+// so the light grid & index pool layouts can't drift between the two.
+// Keep it to preprocessor definitions outside of the language specific blocks.
+///////////////////////////////////////////////////////////////////////
+#define TILE_SIZE 16
+#define MAX_POINTLIGHTS 1024
+
+// Average amount of index pool uints reserved per tile/cluster, the pool is shared so a hot tile can use far more
+#define LIGHT_INDEX_POOL_UINTS_PER_CELL 16
+
+// Clustered light assignment, screen tiles of CLUSTER_TILE_SIZE pixels times exponential depth slices
+#define CLUSTER_TILE_SIZE 64
+#define CLUSTER_DEPTH_SLICES 24
+#define CLUSTER_THREADS 64
+
+// Selected through the scene uniform
+#define LIGHT_ASSIGNMENT_TILED 0
+#define LIGHT_ASSIGNMENT_CLUSTERED 1
+
+// 1 = Two 16-bit light indices are packed into every uint (requires MAX_POINTLIGHTS <= 65536)
+// 0 = One 32-bit light index per uint
+#define LIGHT_INDEX_16BIT 1
+
+#if LIGHT_INDEX_16BIT
+	#define LIGHT_INDICES_PER_UINT 2
+#else
+	#define LIGHT_INDICES_PER_UINT 1
+#endif
+
+// Light grid/visibility buffer (std430), one (offset, count) pair per tile or per cluster:
+// uint AmountOfTiles;
+// uvec2 Cells[]; // x = Offset (in uints) into the index pool, y = Amount of lights
+#define LIGHT_GRID_HEADER_UINTS 2 // AmountOfTiles + padding, uvec2 is 8 byte aligned
+#define LIGHT_GRID_CELL_UINTS 2
+
+// Light index pool (std430), cells allocate a contiguous range with an atomic add on Counter:
+// uint Counter; // Reset to 0 every frame
+// uint Indices[];
+#define LIGHT_INDEX_POOL_HEADER_UINTS 1
+
+#if defined(__cplusplus)
+	static_assert(!LIGHT_INDEX_16BIT || MAX_POINTLIGHTS <= 65536, "Light indices don't fit in 16 bits.");
+
+	// Size in bytes of the light grid for the specified amount of tiles/clusters
+	inline constexpr size_t LightGridBufferSize(uint32_t cells)
+	{
+		return sizeof(uint32_t) * (LIGHT_GRID_HEADER_UINTS + (size_t)LIGHT_GRID_CELL_UINTS * cells);
+	}
+
+	// Size in bytes of the light index pool for the specified amount of tiles/clusters
+	inline constexpr size_t LightIndexPoolSize(uint32_t cells)
+	{
+		return sizeof(uint32_t) * (LIGHT_INDEX_POOL_HEADER_UINTS + (size_t)LIGHT_INDEX_POOL_UINTS_PER_CELL * cells);
+	}
+
+	// Amount of visibility entries needed to support both the tiled and clustered assignment at this resolution
+	inline constexpr uint32_t LightGridCellCount(uint32_t width, uint32_t height)
+	{
+		uint32_t tiles = ((width + TILE_SIZE - 1) / TILE_SIZE) * ((height + TILE_SIZE - 1) / TILE_SIZE);
+		uint32_t clusters = ((width + CLUSTER_TILE_SIZE - 1) / CLUSTER_TILE_SIZE) * ((height + CLUSTER_TILE_SIZE - 1) / CLUSTER_TILE_SIZE) * CLUSTER_DEPTH_SLICES;
+		return (tiles > clusters ? tiles : clusters);
+	}
+#else
+	// Returns the i'th light index out of the packed indices
+	uint UnpackLightIndex(uint packed, uint i)
+	{
+	#if LIGHT_INDEX_16BIT
+		return (packed >> ((i & 1u) * 16u)) & 0xFFFFu;
+	#else
+		return packed;
+	#endif
+	}
+
+	// Amount of pool uints needed to store count light indices
+	uint GetLightIndexWords(uint count)
+	{
+		return (count + LIGHT_INDICES_PER_UINT - 1) / LIGHT_INDICES_PER_UINT;
+	}
+
+	// Packs the i'th and (i + 1)'th light index into a single uint (second is ignored for 32-bit indices)
+	uint PackLightIndices(uint first, uint second)
+	{
+	#if LIGHT_INDEX_16BIT
+		return (first & 0xFFFFu) | ((second & 0xFFFFu) << 16u);
+	#else
+		return first;
+	#endif
+	}
+
+	// Exponential depth slicing, slice k starts at Near * (Far / Near)^(k / CLUSTER_DEPTH_SLICES)
+	// Note(Jorben): clipPlanes.x = Near, clipPlanes.y = Far, viewDepth is the positive distance along the view direction
+	float GetClusterSliceDepth(uint slice, vec2 clipPlanes)
+	{
+		return clipPlanes.x * pow(clipPlanes.y / clipPlanes.x, float(slice) / float(CLUSTER_DEPTH_SLICES));
+	}
+
+	uint GetClusterSlice(float viewDepth, vec2 clipPlanes)
+	{
+		float slice = log(viewDepth / clipPlanes.x) / log(clipPlanes.y / clipPlanes.x) * float(CLUSTER_DEPTH_SLICES);
+		return uint(clamp(slice, 0.0, float(CLUSTER_DEPTH_SLICES - 1)));
+	}
+
+	uint GetClusterIndex(uvec2 pixel, float viewDepth, uvec2 screenSize, vec2 clipPlanes)
+	{
+		uvec2 clusters = (screenSize + CLUSTER_TILE_SIZE - 1) / CLUSTER_TILE_SIZE;
+		uvec2 clusterID = pixel / CLUSTER_TILE_SIZE;
+		return GetClusterSlice(viewDepth, clipPlanes) * clusters.x * clusters.y + clusterID.y * clusters.x + clusterID.x;
+	}
+#endif
+
+#endif
@@ -1,3 +1,112 @@
+-- Note(Jorben): Everything in src/FPR is shared with FPRBench, so it's built once as a library
+project "FPRScene"
+	kind "StaticLib"
+	language "C++"
+	cppdialect "C++20"
+	staticruntime "off"
+	
+	architecture "x86_64"
+	
+	targetdir ("%{wks.location}/bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("%{wks.location}/bin-int/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"src/FPR/**.h",
+		"src/FPR/**.hpp",
+		"src/FPR/**.cpp"
+	}
+
+	includedirs
+	{
+		"src",
+		"assets/shaders",
+		"%{wks.location}/vendor",
+
+		"%{wks.location}/Core/src",
+
+		"%{Dependencies.GLFW.IncludeDir}",
+		"%{Dependencies.GLM.IncludeDir}",
+		"%{Dependencies.Spdlog.IncludeDir}",
+		"%{Dependencies.Stb_image.IncludeDir}",
+		"%{Dependencies.Assimp.IncludeDir}",
+		"%{Dependencies.ImGui.IncludeDir}",
+		"%{Dependencies.Tracy.IncludeDir}",
+		"%{Dependencies.VMA.IncludeDir}",
+		"%{Dependencies.EnTT.IncludeDir}"
+	}
+
+	links
+	{
+		"Swift"
+	}
+
+	disablewarnings
+	{
+		"4005",
+		"4996"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+		staticruntime "on"
+
+		defines
+		{
+			"APP_PLATFORM_WINDOWS",
+			"GLFW_INCLUDE_NONE"
+		}
+		
+		includedirs
+		{
+			"%{Dependencies.Vulkan.Windows.IncludeDir}"
+		}
+
+	filter "system:linux"
+		systemversion "latest"
+		staticruntime "on"
+
+		defines
+		{
+			"APP_PLATFORM_LINUX",
+			"GLFW_INCLUDE_NONE"
+		}
+
+		includedirs
+		{
+			"%{Dependencies.Vulkan.Linux.IncludeDir}"
+		}
+
+	filter "configurations:Debug"
+		defines "APP_DEBUG"
+		runtime "Debug"
+		symbols "on"
+		editandcontinue "Off"
+
+		defines
+		{
+			"TRACY_ENABLE",
+			"TRACY_ON_DEMAND",
+			"NOMINMAX"
+		}
+
+	filter "configurations:Release"
+		defines "APP_RELEASE"
+		runtime "Release"
+		optimize "on"
+
+		defines
+		{
+			"TRACY_ENABLE",
+			"TRACY_ON_DEMAND",
+			"NOMINMAX"
+		}
+
+	filter "configurations:Dist"
+		defines "APP_DIST"
+		runtime "Release"
+		optimize "Full"
+
 project "FPR"
 	kind "ConsoleApp"
 	language "C++"
@@ -22,9 +131,15 @@ project "FPR"
 		"vendor/**.cpp"
 	}
 
+	removefiles
+	{
+		"src/FPR/**"
+	}
+
 	includedirs
 	{
 		"src",
+		"assets/shaders",
 		"%{wks.location}/vendor",
 
 		"%{wks.location}/Core/src",
@@ -42,6 +157,7 @@ project "FPR"
 
 	links
 	{
+		"FPRScene",
 		"Swift"
 	}
 
@@ -66,6 +182,27 @@ project "FPR"
 			"%{Dependencies.Vulkan.Windows.IncludeDir}"
 		}
 
+	filter "system:linux"
+		systemversion "latest"
+		staticruntime "on"
+
+		defines
+		{
+			"APP_PLATFORM_LINUX",
+			"GLFW_INCLUDE_NONE"
+		}
+
+		includedirs
+		{
+			"%{Dependencies.Vulkan.Linux.IncludeDir}"
+		}
+
+		links
+		{
+			"pthread",
+			"dl"
+		}
+
 	filter "configurations:Debug"
 		defines "APP_DEBUG"
 		runtime "Debug"
@@ -75,6 +212,7 @@ project "FPR"
 		defines
 		{
 			"TRACY_ENABLE",
+			"TRACY_ON_DEMAND",
 			"NOMINMAX"
 		}
 
@@ -86,6 +224,7 @@ project "FPR"
 		defines
 		{
 			"TRACY_ENABLE",
+			"TRACY_ON_DEMAND",
 			"NOMINMAX"
 		}
 
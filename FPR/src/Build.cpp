@@ -1,6 +1,8 @@
 #include <Swift/Core/Application.hpp>
 #include <Swift/Entrypoint.hpp>
 
+#include <Swift/Utils/Arguments.hpp>
+
 #include "Core.hpp"
 
 class SwiftFPR : public Swift::Application
@@ -26,5 +28,24 @@ Swift::Application* Swift::CreateApplication(int argc, char* argv[])
 	appInfo.WindowSpecs.Height = 720;
 	appInfo.WindowSpecs.VSync = false;
 
+	// Note(Jorben): Usage: FPR [--headless] [--render-thread] [--frames-ahead <count>] [--frames <count>] [--width <pixels>] [--height <pixels>]
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+
+		if (argument == "--headless")
+			appInfo.WindowSpecs.Headless = true;
+		else if (argument == "--render-thread")
+			appInfo.RenderThread = true;
+		else if (argument == "--frames-ahead" && i + 1 < argc)
+			Utils::Arguments::ParseValue(argument, argv[++i], appInfo.FramesAhead);
+		else if (argument == "--frames" && i + 1 < argc)
+			Utils::Arguments::ParseValue(argument, argv[++i], appInfo.MaxFrames);
+		else if (argument == "--width" && i + 1 < argc)
+			Utils::Arguments::ParseValue(argument, argv[++i], appInfo.WindowSpecs.Width);
+		else if (argument == "--height" && i + 1 < argc)
+			Utils::Arguments::ParseValue(argument, argv[++i], appInfo.WindowSpecs.Height);
+	}
+
 	return new SwiftFPR(appInfo);
 }
\ No newline at end of file
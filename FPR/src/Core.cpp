@@ -8,6 +8,7 @@
 void FPRCore::OnAttach()
 {
 	m_Scene = Scene::Create();
+	m_Scene->LoadDemo();
 }
 
 void FPRCore::OnDetach()
@@ -27,7 +28,7 @@ void FPRCore::OnUpdate(float deltaTime)
 	if (timer >= 1.0f)
 	{
 		FPS = (uint32_t)((float)tempFPS / timer);
-		Application::Get().GetWindow().SetTitle(fmt::format("SwiftFPR | FPS: {0} | Frametime: {1:.3f}ms  -  Width: {2} | Height: {3}", FPS, timer / (float)FPS * 1000.0f, Application::Get().GetWindow().GetWidth(), Application::Get().GetWindow().GetHeight()));
+		Application::Get().GetWindow().SetTitle(fmt::format("SwiftFPR | FPS: {0} | Frametime: {1:.3f}ms  -  Width: {2} | Height: {3}  -  Lights: {4} (L)", FPS, timer / (float)FPS * 1000.0f, Application::Get().GetWindow().GetWidth(), Application::Get().GetWindow().GetHeight(), (Resources::Assignment == LightAssignment::Tiled ? "Tiled" : "Clustered")));
 		timer = 0.0f;
 		tempFPS = 0u;
 	}
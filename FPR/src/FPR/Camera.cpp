@@ -18,6 +18,9 @@ void Camera::OnUpdate(float deltaTime)
 	case State::FlyCam:
 		UpdateFlyCam(deltaTime);
 		break;
+	case State::Scripted:
+		UpdateScripted(deltaTime);
+		break;
 
 	default:
 		APP_LOG_ERROR("No proper camera state selected");
@@ -46,6 +49,7 @@ void Camera::SwitchState()
 		m_Pitch = glm::degrees(asin(direction.y));
 		break;
 	case State::FlyCam:
+	case State::Scripted:
 		m_State = State::ArcBall;
 		break;
 
@@ -55,6 +59,14 @@ void Camera::SwitchState()
 	}
 }
 
+void Camera::LookAt(const glm::vec3& position, const glm::vec3& target)
+{
+	m_State = State::Scripted;
+
+	m_Position = position;
+	m_Target = target;
+}
+
 Ref<Camera> Camera::Create()
 {
 	return RefHelper::Create<Camera>();
@@ -93,17 +105,7 @@ void Camera::UpdateArcBall(float deltaTime)
 		);
 
 		m_Camera.View = glm::lookAt(m_Position, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-
-		m_Camera.Projection = glm::perspective(glm::radians(m_FOV), (float)Application::Get().GetWindow().GetWidth() / (float)Application::Get().GetWindow().GetHeight(), m_Near, m_Far);
-		if (RendererSpecification::API == RendererSpecification::RenderingAPI::Vulkan)
-			m_Camera.Projection[1][1] *= -1;
-
-		float depthLinearizeMul = (-m_Camera.Projection[3][2]);
-		float depthLinearizeAdd = (m_Camera.Projection[2][2]);
-		// correct the handedness issue.
-		if (depthLinearizeMul * depthLinearizeAdd < 0)
-			depthLinearizeAdd = -depthLinearizeAdd;
-		m_Camera.DepthUnpackConsts = { depthLinearizeMul, depthLinearizeAdd };
+		UpdateProjection();
 	}
 }
 
@@ -185,16 +187,7 @@ void Camera::UpdateFlyCam(float deltaTime)
 
 		// Update everything
 		m_Camera.View = glm::lookAt(m_Position, m_Position + m_Front, m_Up);
-		m_Camera.Projection = glm::perspective(glm::radians(m_FOV), (float)Application::Get().GetWindow().GetWidth() / (float)Application::Get().GetWindow().GetHeight(), m_Near, m_Far);
-		if (RendererSpecification::API == RendererSpecification::RenderingAPI::Vulkan)
-			m_Camera.Projection[1][1] *= -1;
-
-		float depthLinearizeMul = (-m_Camera.Projection[3][2]);
-		float depthLinearizeAdd = (m_Camera.Projection[2][2]);
-		// correct the handedness issue.
-		if (depthLinearizeMul * depthLinearizeAdd < 0)
-			depthLinearizeAdd = -depthLinearizeAdd;
-		m_Camera.DepthUnpackConsts = { depthLinearizeMul, depthLinearizeAdd };
+		UpdateProjection();
 	}
 }
 
@@ -207,4 +200,28 @@ bool Camera::OnMouseScroll(MouseScrolledEvent& e)
 	}
 
 	return false;
+}
+
+void Camera::UpdateScripted(float deltaTime)
+{
+	if (Application::Get().GetWindow().GetWidth() != 0 && Application::Get().GetWindow().GetHeight() != 0)
+	{
+		m_Camera.View = glm::lookAt(m_Position, m_Target, glm::vec3(0.0f, 1.0f, 0.0f));
+		UpdateProjection();
+	}
+}
+
+void Camera::UpdateProjection()
+{
+	m_Camera.Projection = glm::perspective(glm::radians(m_FOV), (float)Application::Get().GetWindow().GetWidth() / (float)Application::Get().GetWindow().GetHeight(), m_Near, m_Far);
+	if (RendererSpecification::API == RendererSpecification::RenderingAPI::Vulkan)
+		m_Camera.Projection[1][1] *= -1;
+
+	float depthLinearizeMul = (-m_Camera.Projection[3][2]);
+	float depthLinearizeAdd = (m_Camera.Projection[2][2]);
+	// correct the handedness issue.
+	if (depthLinearizeMul * depthLinearizeAdd < 0)
+		depthLinearizeAdd = -depthLinearizeAdd;
+	m_Camera.DepthUnpackConsts = { depthLinearizeMul, depthLinearizeAdd };
+	m_Camera.ClipPlanes = { m_Near, m_Far };
 }
\ No newline at end of file
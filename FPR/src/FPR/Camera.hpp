@@ -13,7 +13,7 @@ class Camera
 public:
 	enum class State
 	{
-		None = 0, ArcBall, FlyCam
+		None = 0, ArcBall, FlyCam, Scripted
 	};
 public:
 	Camera() = default;
@@ -24,6 +24,9 @@ public:
 
 	void SwitchState();
 
+	// Note(Jorben): Switches to the Scripted state, the camera then only moves through this function
+	void LookAt(const glm::vec3& position, const glm::vec3& target);
+
 	inline float& GetFOV() { return m_FOV; }
 	inline float& GetFlyCamSpeed() { return m_MovementSpeed; }
 	inline float& GetArcBallSpeed() { return m_Speed; }
@@ -37,6 +40,9 @@ public:
 private:
 	void UpdateArcBall(float deltaTime);
 	void UpdateFlyCam(float deltaTime);
+	void UpdateScripted(float deltaTime);
+
+	void UpdateProjection();
 
 	bool OnMouseScroll(MouseScrolledEvent& e);
 
@@ -70,4 +76,7 @@ private:
 	float m_Change = 0.5f;
 
 	float m_Speed = 0.005f;
+
+	// Scripted
+	glm::vec3 m_Target = { 0.0f, 0.0f, 0.0f };
 };
\ No newline at end of file
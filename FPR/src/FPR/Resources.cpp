@@ -4,6 +4,19 @@
 #include <Swift/Utils/Mesh.hpp>
 
 #include <Swift/Renderer/Renderer.hpp>
+#include <Swift/Renderer/FrameUploadRing.hpp>
+
+// DrawCulling
+Ref<Pipeline>				Resources::DrawCulling::Pipeline = nullptr;
+Ref<DescriptorSets>			Resources::DrawCulling::DescriptorSets = nullptr;
+
+Ref<ComputeShader>			Resources::DrawCulling::ComputeShader = nullptr;
+Ref<CommandBuffer>			Resources::DrawCulling::CommandBuffer = nullptr;
+
+Ref<StorageBuffer>			Resources::DrawCulling::BatchBuffer = nullptr;
+Ref<StorageBuffer>			Resources::DrawCulling::InstanceBuffer = nullptr;
+Ref<StorageBuffer>			Resources::DrawCulling::VisibleBuffer = nullptr;
+Ref<IndirectBuffer>			Resources::DrawCulling::DrawBuffer = nullptr;
 
 // Depth
 Ref<Pipeline>				Resources::Depth::Pipeline = nullptr;
@@ -19,30 +32,54 @@ Ref<CommandBuffer>			Resources::LightCulling::CommandBuffer = nullptr;
 
 Ref<StorageBuffer>			Resources::LightCulling::LightsBuffer = nullptr;
 Ref<StorageBuffer>			Resources::LightCulling::LightVisibilityBuffer = nullptr;
+Ref<StorageBuffer>			Resources::LightCulling::LightIndexBuffer = nullptr;
+
+// ClusterCulling
+Ref<Pipeline>				Resources::ClusterCulling::Pipeline = nullptr;
+Ref<DescriptorSets>			Resources::ClusterCulling::DescriptorSets = nullptr;
+
+Ref<ComputeShader>			Resources::ClusterCulling::ComputeShader = nullptr;
+Ref<CommandBuffer>			Resources::ClusterCulling::CommandBuffer = nullptr;
 
 // Shading
 Ref<Pipeline>				Resources::Shading::Pipeline = nullptr;
 Ref<RenderPass>				Resources::Shading::RenderPass = nullptr;
 Ref<DescriptorSets>			Resources::Shading::DescriptorSets = nullptr;
 
+Dict<Image2D*, uint32_t>	Resources::Shading::AlbedoSets = { };
+std::vector<Ref<Image2D>>	Resources::Shading::Albedos = { };
+std::vector<uint32_t>		Resources::Shading::FreeAlbedoSets = { };
+
 // Resources
-Ref<UniformBuffer>			Resources::SceneBuffer = nullptr;
-Ref<DynamicUniformBuffer>	Resources::ModelBuffer = nullptr;
-Ref<UniformBuffer>			Resources::CameraBuffer = nullptr;
+Ref<StorageBuffer>			Resources::ModelBuffer = nullptr;
 
 void Resources::Init()
 {
 	Ref<ShaderCompiler> compiler = ShaderCompiler::Create();
 	Ref<ShaderCacher> cacher = ShaderCacher::Create();
 
+	InitDrawCulling(compiler, cacher);
 	InitDepth(compiler, cacher);
 	InitLightCulling(compiler, cacher);
+	InitClusterCulling(compiler, cacher);
 	InitShading(compiler, cacher);
 	InitResources();
 }
 
 void Resources::Destroy()
 {
+	// DrawCulling
+	Resources::DrawCulling::Pipeline.reset();
+	Resources::DrawCulling::DescriptorSets.reset();
+
+	Resources::DrawCulling::ComputeShader.reset();
+	Resources::DrawCulling::CommandBuffer.reset();
+
+	Resources::DrawCulling::BatchBuffer.reset();
+	Resources::DrawCulling::InstanceBuffer.reset();
+	Resources::DrawCulling::VisibleBuffer.reset();
+	Resources::DrawCulling::DrawBuffer.reset();
+
 	// Depth
 	Resources::Depth::Pipeline.reset();
 	Resources::Depth::RenderPass.reset();
@@ -57,16 +94,26 @@ void Resources::Destroy()
 
 	Resources::LightCulling::LightsBuffer.reset();
 	Resources::LightCulling::LightVisibilityBuffer.reset();
+	Resources::LightCulling::LightIndexBuffer.reset();
+
+	// ClusterCulling
+	Resources::ClusterCulling::Pipeline.reset();
+	Resources::ClusterCulling::DescriptorSets.reset();
+
+	Resources::ClusterCulling::ComputeShader.reset();
+	Resources::ClusterCulling::CommandBuffer.reset();
 
 	// Shading
 	Resources::Shading::Pipeline.reset();
 	Resources::Shading::RenderPass.reset();
 	Resources::Shading::DescriptorSets.reset();
 
+	Resources::Shading::AlbedoSets.clear();
+	Resources::Shading::Albedos.clear();
+	Resources::Shading::FreeAlbedoSets.clear();
+
 	// Resources
-	Resources::SceneBuffer.reset();
 	Resources::ModelBuffer.reset();
-	Resources::CameraBuffer.reset();
 }
 
 void Resources::Resize(uint32_t width, uint32_t height)
@@ -78,9 +125,9 @@ void Resources::Resize(uint32_t width, uint32_t height)
 
 	// LightCulling
 	{
-		uint32_t tiles = ((Application::Get().GetWindow().GetWidth() + TILE_SIZE - 1) / TILE_SIZE) * ((Application::Get().GetWindow().GetHeight() + TILE_SIZE - 1) / TILE_SIZE);
-		size_t size = ((sizeof(uint32_t) + (sizeof(char) * 12) + ((sizeof(uint32_t) + (sizeof(char) * 12)) * MAX_POINTLIGHTS_PER_TILE))) * tiles;
-		Resources::LightCulling::LightVisibilityBuffer = StorageBuffer::Create(size);
+		uint32_t cells = LightGridCellCount(width, height);
+		Resources::LightCulling::LightVisibilityBuffer = StorageBuffer::Create(LightGridBufferSize(cells));
+		Resources::LightCulling::LightIndexBuffer = StorageBuffer::Create(LightIndexPoolSize(cells));
 	}
 
 	// Shading
@@ -89,18 +136,149 @@ void Resources::Resize(uint32_t width, uint32_t height)
 	}
 }
 
+// Note(Jorben): Resizing retires the old buffers through the renderer's free stream, the other frames' descriptor sets
+// keep pointing at them until those frames come round (see VulkanDescriptorSet::Flush)
+bool Resources::ReserveModels(uint32_t count)
+{
+	if (count <= AllocatedModels)
+		return false;
+
+	AllocatedModels = std::max(count, AllocatedModels * 2u);
+	ModelBuffer->Resize(sizeof(ShaderModel) * AllocatedModels);
+	Resources::DrawCulling::InstanceBuffer->Resize(InstanceBufferSize(AllocatedModels));
+	Resources::DrawCulling::VisibleBuffer->Resize(sizeof(uint32_t) * AllocatedModels);
+
+	UploadInstanceBuffers();
+	return true;
+}
+
+bool Resources::ReserveBatches(uint32_t count)
+{
+	if (count <= AllocatedBatches)
+		return false;
+
+	AllocatedBatches = std::max(count, AllocatedBatches * 2u);
+	Resources::DrawCulling::BatchBuffer->Resize(sizeof(ShaderBatch) * AllocatedBatches);
+	Resources::DrawCulling::DrawBuffer->Resize(AllocatedBatches);
+
+	UploadBatchBuffers();
+	return true;
+}
+
+void Resources::RegisterAlbedo(Ref<Image2D> albedo)
+{
+	if (Resources::Shading::AlbedoSets.find(albedo.get()) != Resources::Shading::AlbedoSets.end())
+		return;
+
+	// Note(Jorben): A set given back by ReleaseUnusedAlbedos is only rewritten for the current frame right away,
+	// the copies other frames in flight might still have bound are rewritten once those frames come round
+	uint32_t index = (uint32_t)Resources::Shading::Albedos.size();
+	if (!Resources::Shading::FreeAlbedoSets.empty())
+	{
+		index = Resources::Shading::FreeAlbedoSets.back();
+		Resources::Shading::FreeAlbedoSets.pop_back();
+		Resources::Shading::Albedos[index] = albedo;
+	}
+	else
+	{
+		Resources::Shading::Albedos.push_back(albedo);
+	}
+	Resources::Shading::AlbedoSets[albedo.get()] = index;
+
+	auto descriptor = Resources::Shading::DescriptorSets->GetLayout(2).GetDescriptorByName("u_Albedo");
+	uint32_t amount = Resources::Shading::DescriptorSets->GetAmount(2);
+
+	// Note(Jorben): The old pool is retired through the renderer's free stream, so frames in flight can keep using the old sets.
+	// Recreating the sets loses their contents, so all albedos are uploaded again
+	if ((uint32_t)Resources::Shading::Albedos.size() > amount)
+	{
+		Resources::Shading::DescriptorSets->SetAmount(2, amount * 2u);
+
+		auto& sets = Resources::Shading::DescriptorSets->GetSets(2);
+		for (size_t i = 0; i < Resources::Shading::Albedos.size(); i++)
+		{
+			if (Resources::Shading::Albedos[i])
+				Resources::Shading::Albedos[i]->Upload(sets[i], descriptor);
+		}
+
+		return;
+	}
+
+	albedo->Upload(Resources::Shading::DescriptorSets->GetSets(2)[Resources::Shading::AlbedoSets[albedo.get()]], descriptor);
+}
+
+void Resources::ReleaseUnusedAlbedos()
+{
+	for (uint32_t i = 0; i < (uint32_t)Resources::Shading::Albedos.size(); i++)
+	{
+		// Note(Jorben): The last reference is ours, the image itself is destroyed through the renderer's free stream
+		Ref<Image2D>& albedo = Resources::Shading::Albedos[i];
+		if (!albedo || albedo.use_count() > 1)
+			continue;
+
+		Resources::Shading::AlbedoSets.erase(albedo.get());
+		Resources::Shading::FreeAlbedoSets.push_back(i);
+		albedo.reset();
+	}
+}
+
+Ref<DescriptorSet> Resources::GetAlbedoSet(Ref<Image2D> albedo)
+{
+	auto it = Resources::Shading::AlbedoSets.find(albedo.get());
+	if (it == Resources::Shading::AlbedoSets.end())
+	{
+		APP_LOG_ERROR("Albedo image was not registered with Resources::RegisterAlbedo.");
+		return nullptr;
+	}
+
+	return Resources::Shading::DescriptorSets->GetSets(2)[it->second];
+}
+
+void Resources::InitDrawCulling(Ref<ShaderCompiler> compiler, Ref<ShaderCacher> cacher)
+{
+	Resources::DrawCulling::DescriptorSets = DescriptorSets::Create(
+	{
+		// Set 0
+		{ 1, { 0, {
+			{ DescriptorType::StorageBuffer, 0, "u_Batches", ShaderStage::Compute },
+			{ DescriptorType::StorageBuffer, 1, "u_Instances", ShaderStage::Compute },
+			{ DescriptorType::StorageBuffer, 2, "u_Models", ShaderStage::Compute },
+			{ DescriptorType::StorageBuffer, 3, "u_Visible", ShaderStage::Compute },
+			{ DescriptorType::StorageBuffer, 4, "u_Draws", ShaderStage::Compute }
+		}}},
+
+		// Set 1
+		{ 1, { 1, {
+			{ DescriptorType::DynamicUniformBuffer, 0, "u_Camera", ShaderStage::Compute }
+		}}}
+	});
+
+	// Note(Jorben): The culling pass runs on the graphics queue, so the draw buffer can be read by the depth & shading pass without ownership transfers
+	CommandBufferSpecification cmdBufSpecs = {};
+	cmdBufSpecs.Usage = CommandBufferUsage::Sequence;
+
+	Resources::DrawCulling::CommandBuffer = CommandBuffer::Create(cmdBufSpecs);
+
+	ShaderSpecification shaderSpecs = {};
+	shaderSpecs.Compute = cacher->GetLatest(compiler, "assets/shaders/caches/DrawCulling.comp.cache", "assets/shaders/DrawCulling.comp.glsl", ShaderStage::Compute);
+
+	Resources::DrawCulling::ComputeShader = ComputeShader::Create(shaderSpecs);
+	Resources::DrawCulling::Pipeline = Pipeline::Create({ }, Resources::DrawCulling::DescriptorSets, Resources::DrawCulling::ComputeShader);
+}
+
 void Resources::InitDepth(Ref<ShaderCompiler> compiler, Ref<ShaderCacher> cacher)
 {
 	Resources::Depth::DescriptorSets = DescriptorSets::Create(
 	{
 		// Set 0
-		{ PreAllocatedModels, { 0, {
-			{ DescriptorType::DynamicUniformBuffer, 0, "u_Model", ShaderStage::Vertex }
+		{ 1, { 0, {
+			{ DescriptorType::StorageBuffer, 0, "u_Models", ShaderStage::Vertex },
+			{ DescriptorType::StorageBuffer, 1, "u_Visible", ShaderStage::Vertex }
 		}}},
 
 		// Set 1
 		{ 1, { 1, {
-			{ DescriptorType::UniformBuffer, 0, "u_Camera", ShaderStage::Vertex }
+			{ DescriptorType::DynamicUniformBuffer, 0, "u_Camera", ShaderStage::Vertex }
 		}}}
 	});
 
@@ -112,7 +290,8 @@ void Resources::InitDepth(Ref<ShaderCompiler> compiler, Ref<ShaderCacher> cacher
 	RenderPassSpecification renderPassSpecs = {};
 	renderPassSpecs.DepthLoadOp = LoadOperation::Clear;
 	renderPassSpecs.DepthAttachment = Renderer::GetDepthImage();
-	renderPassSpecs.PreviousDepthImageLayout = ImageLayout::Depth;
+	// Note(Jorben): The depth is cleared, so the previous frame's layout (DepthRead, for the heatmap) doesn't matter
+	renderPassSpecs.PreviousDepthImageLayout = ImageLayout::Undefined;
 	renderPassSpecs.FinalDepthImageLayout = ImageLayout::Depth;
 
 	Resources::Depth::RenderPass = RenderPass::Create(renderPassSpecs, cmdBuf);
@@ -141,13 +320,14 @@ void Resources::InitLightCulling(Ref<ShaderCompiler> compiler, Ref<ShaderCacher>
 		{ 1, { 0, {
 			{ DescriptorType::Image, 0, "u_DepthBuffer", ShaderStage::Compute },
 			{ DescriptorType::StorageBuffer, 1, "u_Lights", ShaderStage::Compute },
-			{ DescriptorType::StorageBuffer, 2, "u_Visibility", ShaderStage::Compute }
+			{ DescriptorType::StorageBuffer, 2, "u_Visibility", ShaderStage::Compute },
+			{ DescriptorType::StorageBuffer, 3, "u_LightIndices", ShaderStage::Compute }
 		}}},
 
 		// Set 1
 		{ 1, { 1, {
-			{ DescriptorType::UniformBuffer, 0, "u_Camera", ShaderStage::Compute },
-			{ DescriptorType::UniformBuffer, 1, "u_Scene", ShaderStage::Compute }
+			{ DescriptorType::DynamicUniformBuffer, 0, "u_Camera", ShaderStage::Compute },
+			{ DescriptorType::DynamicUniformBuffer, 1, "u_Scene", ShaderStage::Compute }
 		}}},
 	});
 
@@ -156,13 +336,17 @@ void Resources::InitLightCulling(Ref<ShaderCompiler> compiler, Ref<ShaderCacher>
 		Resources::LightCulling::LightsBuffer = StorageBuffer::Create(size);
 
 		auto& window = Application::Get().GetWindow();
-		uint32_t tiles = ((Application::Get().GetWindow().GetWidth() + TILE_SIZE - 1) / TILE_SIZE) * ((Application::Get().GetWindow().GetHeight() + TILE_SIZE - 1) / TILE_SIZE);
-		size = ((sizeof(uint32_t) + (sizeof(char) * 12) + ((sizeof(uint32_t) + (sizeof(char) * 12)) * MAX_POINTLIGHTS_PER_TILE))) * tiles;
-		Resources::LightCulling::LightVisibilityBuffer = StorageBuffer::Create(size);
+		uint32_t cells = LightGridCellCount(window.GetWidth(), window.GetHeight());
+		Resources::LightCulling::LightVisibilityBuffer = StorageBuffer::Create(LightGridBufferSize(cells));
+		Resources::LightCulling::LightIndexBuffer = StorageBuffer::Create(LightIndexPoolSize(cells));
 	}
 
+	// Note(Jorben): Culling runs on the compute queue and isn't part of the sequence, so it only waits on what it's given (the depth pre pass)
+	// and graphics only waits on it at the shading pass. Every frame in flight has its own copy of the light lists, so the next
+	// frame's culling can run while shading still reads the previous one.
 	CommandBufferSpecification cmdBufSpecs = {};
-	cmdBufSpecs.Usage = CommandBufferUsage::Sequence;
+	cmdBufSpecs.Usage = CommandBufferUsage::Parallel;
+	cmdBufSpecs.SubmitQueue = Queue::Compute;
 
 	Resources::LightCulling::CommandBuffer = CommandBuffer::Create(cmdBufSpecs);
 
@@ -173,22 +357,60 @@ void Resources::InitLightCulling(Ref<ShaderCompiler> compiler, Ref<ShaderCacher>
 	Resources::LightCulling::Pipeline = Pipeline::Create({ }, Resources::LightCulling::DescriptorSets, Resources::LightCulling::ComputeShader);
 }
 
+void Resources::InitClusterCulling(Ref<ShaderCompiler> compiler, Ref<ShaderCacher> cacher)
+{
+	Resources::ClusterCulling::DescriptorSets = DescriptorSets::Create(
+	{
+		// Set 0
+		{ 1, { 0, {
+			{ DescriptorType::StorageBuffer, 0, "u_Lights", ShaderStage::Compute },
+			{ DescriptorType::StorageBuffer, 1, "u_Visibility", ShaderStage::Compute },
+			{ DescriptorType::StorageBuffer, 2, "u_LightIndices", ShaderStage::Compute }
+		}}},
+
+		// Set 1
+		{ 1, { 1, {
+			{ DescriptorType::DynamicUniformBuffer, 0, "u_Camera", ShaderStage::Compute },
+			{ DescriptorType::DynamicUniformBuffer, 1, "u_Scene", ShaderStage::Compute }
+		}}},
+	});
+
+	// Note(Jorben): Doesn't read the depth buffer, so it doesn't wait on anything (see InitLightCulling)
+	CommandBufferSpecification cmdBufSpecs = {};
+	cmdBufSpecs.Usage = CommandBufferUsage::Parallel;
+	cmdBufSpecs.SubmitQueue = Queue::Compute;
+
+	Resources::ClusterCulling::CommandBuffer = CommandBuffer::Create(cmdBufSpecs);
+
+	ShaderSpecification shaderSpecs = {};
+	shaderSpecs.Compute = cacher->GetLatest(compiler, "assets/shaders/caches/ClusterCulling.comp.cache", "assets/shaders/ClusterCulling.comp.glsl", ShaderStage::Compute);
+
+	Resources::ClusterCulling::ComputeShader = ComputeShader::Create(shaderSpecs);
+	Resources::ClusterCulling::Pipeline = Pipeline::Create({ }, Resources::ClusterCulling::DescriptorSets, Resources::ClusterCulling::ComputeShader);
+}
+
 void Resources::InitShading(Ref<ShaderCompiler> compiler, Ref<ShaderCacher> cacher)
 {
 	Resources::Shading::DescriptorSets = DescriptorSets::Create(
 	{
 		// Set 0
-		{ PreAllocatedModels, { 0, {
-			{ DescriptorType::DynamicUniformBuffer, 0, "u_Model", ShaderStage::Vertex },
-			{ DescriptorType::Image, 1, "u_Albedo", ShaderStage::Fragment },
-			{ DescriptorType::StorageBuffer, 2, "u_Lights", ShaderStage::Fragment },
-			{ DescriptorType::StorageBuffer, 3, "u_Visibility", ShaderStage::Fragment }
+		{ 1, { 0, {
+			{ DescriptorType::StorageBuffer, 0, "u_Models", ShaderStage::Vertex },
+			{ DescriptorType::StorageBuffer, 1, "u_Lights", ShaderStage::Fragment },
+			{ DescriptorType::StorageBuffer, 2, "u_Visibility", ShaderStage::Fragment },
+			{ DescriptorType::StorageBuffer, 3, "u_LightIndices", ShaderStage::Fragment },
+			{ DescriptorType::StorageBuffer, 4, "u_Visible", ShaderStage::Vertex }
 		}}},
 
 		// Set 1
 		{ 1, { 1, {
-			{ DescriptorType::UniformBuffer, 0, "u_Camera", ShaderStage::Vertex },
-			{ DescriptorType::UniformBuffer, 1, "u_Scene", ShaderStage::Fragment }
+			{ DescriptorType::DynamicUniformBuffer, 0, "u_Camera", ShaderStage::Vertex | ShaderStage::Fragment },
+			{ DescriptorType::DynamicUniformBuffer, 1, "u_Scene", ShaderStage::Fragment }
+		}}},
+
+		// Set 2 (Grows with the amount of unique albedo images)
+		{ 1, { 2, {
+			{ DescriptorType::Image, 0, "u_Albedo", ShaderStage::Fragment }
 		}}}
 	});
 
@@ -204,10 +426,11 @@ void Resources::InitShading(Ref<ShaderCompiler> compiler, Ref<ShaderCacher> cach
 	renderPassSpecs.PreviousColourImageLayout = ImageLayout::Undefined;
 	renderPassSpecs.FinalColourImageLayout = ImageLayout::Presentation;
 
-	renderPassSpecs.DepthLoadOp = LoadOperation::Clear;
+	// Note(Jorben): The depth buffer is filled by the depth pre-pass, so we reuse it instead of clearing it
+	renderPassSpecs.DepthLoadOp = (ReuseDepth ? LoadOperation::Load : LoadOperation::Clear);
 	renderPassSpecs.DepthAttachment = Renderer::GetDepthImage();
 	renderPassSpecs.PreviousDepthImageLayout = ImageLayout::DepthRead;
-	renderPassSpecs.FinalDepthImageLayout = ImageLayout::Depth;
+	renderPassSpecs.FinalDepthImageLayout = ImageLayout::DepthRead; // Note(Jorben): Sampled by the heatmap afterwards
 
 	Resources::Shading::RenderPass = RenderPass::Create(renderPassSpecs, cmdBuf);
 
@@ -224,13 +447,59 @@ void Resources::InitShading(Ref<ShaderCompiler> compiler, Ref<ShaderCacher> cach
 	pipelineSpecs.LineWidth = 1.0f;
 	pipelineSpecs.Blending = false;
 
+	// Note(Jorben): Only fragments at the pre-pass' depth survive the test, so only the visible surface gets shaded (coplanar surfaces tie)
+	pipelineSpecs.DepthTest = true;
+	pipelineSpecs.DepthWrite = !ReuseDepth;
+	pipelineSpecs.DepthCompareOp = (ReuseDepth ? CompareOperation::LessOrEqual : CompareOperation::Less);
+
 	Resources::Shading::Pipeline = Pipeline::Create(pipelineSpecs, Resources::Shading::DescriptorSets, shader, Resources::Shading::RenderPass);
 }
 
 void Resources::InitResources()
 {
-	SceneBuffer = UniformBuffer::Create(sizeof(ShaderScene));
+	ModelBuffer = StorageBuffer::Create(sizeof(ShaderModel) * AllocatedModels);
+	Resources::DrawCulling::InstanceBuffer = StorageBuffer::Create(InstanceBufferSize(AllocatedModels));
+	Resources::DrawCulling::VisibleBuffer = StorageBuffer::Create(sizeof(uint32_t) * AllocatedModels);
+	UploadInstanceBuffers();
+
+	Resources::DrawCulling::BatchBuffer = StorageBuffer::Create(sizeof(ShaderBatch) * AllocatedBatches);
+	Resources::DrawCulling::DrawBuffer = IndirectBuffer::Create(AllocatedBatches);
+	UploadBatchBuffers();
+
+	// Note(Jorben): The ring's buffers never change, so the descriptors only have to be written once.
+	auto ring = Renderer::GetUploadRing();
+	ring->Upload(Resources::DrawCulling::DescriptorSets->GetSets(1)[0], Resources::DrawCulling::DescriptorSets->GetLayout(1).GetDescriptorByName("u_Camera"), sizeof(ShaderCamera));
+	ring->Upload(Resources::Depth::DescriptorSets->GetSets(1)[0], Resources::Depth::DescriptorSets->GetLayout(1).GetDescriptorByName("u_Camera"), sizeof(ShaderCamera));
 
-	ModelBuffer = DynamicUniformBuffer::Create(PreAllocatedModels, sizeof(ShaderModel));
-	CameraBuffer = UniformBuffer::Create(sizeof(ShaderCamera));
-}
\ No newline at end of file
+	ring->Upload(Resources::LightCulling::DescriptorSets->GetSets(1)[0], Resources::LightCulling::DescriptorSets->GetLayout(1).GetDescriptorByName("u_Camera"), sizeof(ShaderCamera));
+	ring->Upload(Resources::LightCulling::DescriptorSets->GetSets(1)[0], Resources::LightCulling::DescriptorSets->GetLayout(1).GetDescriptorByName("u_Scene"), sizeof(ShaderScene));
+
+	ring->Upload(Resources::ClusterCulling::DescriptorSets->GetSets(1)[0], Resources::ClusterCulling::DescriptorSets->GetLayout(1).GetDescriptorByName("u_Camera"), sizeof(ShaderCamera));
+	ring->Upload(Resources::ClusterCulling::DescriptorSets->GetSets(1)[0], Resources::ClusterCulling::DescriptorSets->GetLayout(1).GetDescriptorByName("u_Scene"), sizeof(ShaderScene));
+
+	ring->Upload(Resources::Shading::DescriptorSets->GetSets(1)[0], Resources::Shading::DescriptorSets->GetLayout(1).GetDescriptorByName("u_Camera"), sizeof(ShaderCamera));
+	ring->Upload(Resources::Shading::DescriptorSets->GetSets(1)[0], Resources::Shading::DescriptorSets->GetLayout(1).GetDescriptorByName("u_Scene"), sizeof(ShaderScene));
+}
+
+void Resources::UploadInstanceBuffers()
+{
+	auto& culling = Resources::DrawCulling::DescriptorSets;
+	ModelBuffer->Upload(culling->GetSets(0)[0], culling->GetLayout(0).GetDescriptorByName("u_Models"));
+	Resources::DrawCulling::InstanceBuffer->Upload(culling->GetSets(0)[0], culling->GetLayout(0).GetDescriptorByName("u_Instances"));
+	Resources::DrawCulling::VisibleBuffer->Upload(culling->GetSets(0)[0], culling->GetLayout(0).GetDescriptorByName("u_Visible"));
+
+	auto& depth = Resources::Depth::DescriptorSets;
+	ModelBuffer->Upload(depth->GetSets(0)[0], depth->GetLayout(0).GetDescriptorByName("u_Models"));
+	Resources::DrawCulling::VisibleBuffer->Upload(depth->GetSets(0)[0], depth->GetLayout(0).GetDescriptorByName("u_Visible"));
+
+	auto& shading = Resources::Shading::DescriptorSets;
+	ModelBuffer->Upload(shading->GetSets(0)[0], shading->GetLayout(0).GetDescriptorByName("u_Models"));
+	Resources::DrawCulling::VisibleBuffer->Upload(shading->GetSets(0)[0], shading->GetLayout(0).GetDescriptorByName("u_Visible"));
+}
+
+void Resources::UploadBatchBuffers()
+{
+	auto& culling = Resources::DrawCulling::DescriptorSets;
+	Resources::DrawCulling::BatchBuffer->Upload(culling->GetSets(0)[0], culling->GetLayout(0).GetDescriptorByName("u_Batches"));
+	Resources::DrawCulling::DrawBuffer->Upload(culling->GetSets(0)[0], culling->GetLayout(0).GetDescriptorByName("u_Draws"));
+}
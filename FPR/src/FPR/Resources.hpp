@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Swift/Renderer/Image.hpp>
 #include <Swift/Renderer/Shader.hpp>
 #include <Swift/Renderer/Buffers.hpp>
 #include <Swift/Renderer/Pipeline.hpp>
@@ -7,11 +8,17 @@
 #include <Swift/Renderer/Descriptors.hpp>
 #include <Swift/Renderer/CommandBuffer.hpp>
 
+// Note(Jorben): Shared with the shaders, defines TILE_SIZE, MAX_POINTLIGHTS & the light grid/index pool layout
+#include "shared/LightCulling.h"
+// Note(Jorben): Shared with the shaders, defines the draw culling's buffer layouts
+#include "shared/DrawCulling.h"
+
 using namespace Swift;
 
-#define TILE_SIZE 16
-#define MAX_POINTLIGHTS 1024
-#define MAX_POINTLIGHTS_PER_TILE 64
+enum class LightAssignment : uint32_t
+{
+	Tiled = LIGHT_ASSIGNMENT_TILED, Clustered = LIGHT_ASSIGNMENT_CLUSTERED
+};
 
 class Resources
 {
@@ -19,6 +26,22 @@ public:
 	static void Init();
 	static void Destroy();
 
+	// Note(Jorben): Frustum culls every instance on the GPU and fills in the draws of the depth & shading pass
+	struct DrawCulling
+	{
+	public:
+		static Ref<Pipeline>		Pipeline;
+		static Ref<DescriptorSets>	DescriptorSets;
+
+		static Ref<ComputeShader>	ComputeShader;
+		static Ref<CommandBuffer>	CommandBuffer;
+
+		static Ref<StorageBuffer>	BatchBuffer; // Bounds per batch
+		static Ref<StorageBuffer>	InstanceBuffer; // Batch per instance
+		static Ref<StorageBuffer>	VisibleBuffer; // Visible instances, indexed by gl_InstanceIndex
+		static Ref<IndirectBuffer>	DrawBuffer; // One command per batch & the amount of commands to draw
+	};
+
 	struct Depth
 	{
 	public:
@@ -37,7 +60,20 @@ public:
 		static Ref<CommandBuffer>	CommandBuffer;
 		
 		static Ref<StorageBuffer>	LightsBuffer;
-		static Ref<StorageBuffer>	LightVisibilityBuffer;
+		// Note(Jorben): One copy per frame in flight, the culling of the next frame (on the compute queue) writes another copy than shading reads
+		static Ref<StorageBuffer>	LightVisibilityBuffer; // (Offset, Count) per tile/cluster, shared between the tiled and clustered assignment
+		static Ref<StorageBuffer>	LightIndexBuffer; // Global index pool, the counter is reset every frame
+	};
+
+	// Note(Jorben): Uses the LightCulling's lights, visibility & index buffer
+	struct ClusterCulling
+	{
+	public:
+		static Ref<Pipeline>		Pipeline;
+		static Ref<DescriptorSets>	DescriptorSets;
+
+		static Ref<ComputeShader>	ComputeShader;
+		static Ref<CommandBuffer>	CommandBuffer;
 	};
 
 	struct Shading
@@ -46,23 +82,55 @@ public:
 		static Ref<Pipeline>		Pipeline;
 		static Ref<RenderPass>		RenderPass;
 		static Ref<DescriptorSets>	DescriptorSets;
+
+		// Note(Jorben): One set (set 2) per unique albedo image, not per entity
+		static Dict<Image2D*, uint32_t>	AlbedoSets;
+		static std::vector<Ref<Image2D>>	Albedos; // Empty for sets in FreeAlbedoSets
+		static std::vector<uint32_t>		FreeAlbedoSets;
 	};
 
-	inline static uint32_t PreAllocatedModels = 10u;
+	inline static LightAssignment Assignment = LightAssignment::Tiled;
+	// Note(Jorben): Read at Init, when false the shading pass clears & writes its own depth instead of reusing the pre-pass' (to measure the overdraw it saves)
+	inline static bool ReuseDepth = true;
+	// Note(Jorben): When false the instances are frustum culled on the CPU and drawn with one draw per visible instance,
+	// recorded on multiple threads through RenderPass::RecordParallel, instead of the DrawCulling pass & indirect draws
+	inline static bool GPUDriven = true;
+	// Note(Jorben): Set to TimingFlags::PipelineStatistics to also gather invocation counts per pass
+	inline static TimingFlags PassTimingFlags = TimingFlags::None;
+
+	inline static uint32_t PreAllocatedModels = 16u;
 	inline static uint32_t AllocatedModels = PreAllocatedModels;
+	inline static uint32_t PreAllocatedBatches = 16u;
+	inline static uint32_t AllocatedBatches = PreAllocatedBatches;
+
+	// Note(Jorben): The camera & scene data live in the renderer's FrameUploadRing
+	static Ref<StorageBuffer>	ModelBuffer; // Indexed by the instances in the DrawCulling's VisibleBuffer
 
-	static Ref<UniformBuffer>			SceneBuffer;
-	static Ref<DynamicUniformBuffer>	ModelBuffer;
-	static Ref<UniformBuffer>			CameraBuffer;
+public:
+	// Grows the model buffer & the DrawCulling's per instance buffers (by doubling) so they can hold at least count models,
+	// returns true if they grew, which loses their contents
+	static bool ReserveModels(uint32_t count);
+	// Grows the DrawCulling's per batch buffers (by doubling) so they can hold at least count batches, same return as ReserveModels
+	static bool ReserveBatches(uint32_t count);
+
+	static void RegisterAlbedo(Ref<Image2D> albedo);
+	// Gives back the sets of albedos no mesh references anymore, so the images can be released
+	static void ReleaseUnusedAlbedos();
+	static Ref<DescriptorSet> GetAlbedoSet(Ref<Image2D> albedo);
 
 public:
 	static void Resize(uint32_t width, uint32_t height);
 
 private:
+	static void InitDrawCulling(Ref<ShaderCompiler> compiler, Ref<ShaderCacher> cacher);
 	static void InitDepth(Ref<ShaderCompiler> compiler, Ref<ShaderCacher> cacher);
 	static void InitLightCulling(Ref<ShaderCompiler> compiler, Ref<ShaderCacher> cacher);
+	static void InitClusterCulling(Ref<ShaderCompiler> compiler, Ref<ShaderCacher> cacher);
 	static void InitShading(Ref<ShaderCompiler> compiler, Ref<ShaderCacher> cacher);
 	static void InitResources();
+
+	static void UploadInstanceBuffers();
+	static void UploadBatchBuffers();
 };
 
 
@@ -74,6 +142,8 @@ struct ShaderScene
 {
 public:
 	glm::uvec2 ScreenSize = {};
+	LightAssignment Assignment = LightAssignment::Tiled;
+	PUBLIC_PADDING(0, 4);
 };
 
 struct ShaderModel
@@ -89,13 +159,23 @@ public:
 	}
 };
 
+static_assert(IndirectBuffer::CommandOffset == sizeof(uint32_t) * DRAW_BUFFER_HEADER_UINTS, "The draw buffer's header has to match the IndirectBuffer's.");
+
+struct ShaderBatch
+{
+public:
+	glm::vec4 Bounds = {}; // xyz = Center, w = Radius of the mesh's bounding sphere
+	uint32_t Command = 0; // Index of the batch's command in the draw buffer
+	PUBLIC_PADDING(0, 12);
+};
+
 struct ShaderCamera
 {
 public:
 	glm::mat4 View = {};
 	glm::mat4 Projection = {};
 	glm::vec2 DepthUnpackConsts = {};
-	PUBLIC_PADDING(0, 8);
+	glm::vec2 ClipPlanes = {}; // x = Near, y = Far
 };
 
 struct ShaderPointLight
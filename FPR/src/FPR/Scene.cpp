@@ -1,6 +1,7 @@
 #include "Scene.hpp"
 
 #include <Swift/Core/Application.hpp>
+#include <Swift/Renderer/GeometryPool.hpp>
 
 #include "FPR/Resources.hpp"
 #include "FPR/Components.hpp"
@@ -15,6 +16,311 @@ Scene::Scene()
 
 	m_Camera = Camera::Create();
 
+	m_Registry.on_construct<MeshComponent>().connect<&Scene::OnMeshChange>(this);
+	m_Registry.on_update<MeshComponent>().connect<&Scene::OnMeshChange>(this);
+	m_Registry.on_destroy<MeshComponent>().connect<&Scene::OnMeshDestroy>(this);
+	m_Registry.on_update<TransformComponent>().connect<&Scene::OnTransformChange>(this);
+
+	InitHeatMap();
+}
+
+Scene::~Scene()
+{
+	m_Registry.on_construct<MeshComponent>().disconnect(this);
+	m_Registry.on_update<MeshComponent>().disconnect(this);
+	m_Registry.on_destroy<MeshComponent>().disconnect(this);
+	m_Registry.on_update<TransformComponent>().disconnect(this);
+
+	Resources::Destroy();
+}
+
+void Scene::OnUpdate(float deltaTime)
+{
+	FrameSnapshot snapshot = {};
+
+	// Camera
+	{
+		m_Camera->OnUpdate(deltaTime);
+		snapshot.Camera = m_Camera->GetCamera();
+	}
+
+	// Meshes & model matrices, grouped into one batch per (albedo, mesh)
+	// Note(Jorben): The instances & batches are kept up to date through the registry's signals, only what changed since the last frame is handed over
+	{
+		auto transforms = m_Registry.view<TransformComponent>();
+
+		// Note(Jorben): Meshes & albedos are uploaded in the background, so entities only show up once both are done
+		std::vector<entt::entity> pending = { };
+		for (auto& entity : m_PendingEntities)
+		{
+			if (!m_Registry.valid(entity) || !m_Registry.all_of<MeshComponent>(entity) || m_InstanceSlots.contains(entity))
+				continue;
+
+			APP_ASSERT(transforms.contains(entity), "Entity with MeshComponent doesn't have TransformComponent.");
+
+			const MeshComponent& mesh = m_Registry.get<MeshComponent>(entity);
+			if (!mesh.MeshObject->IsReady() || !mesh.Albedo->IsReady())
+			{
+				pending.push_back(entity);
+				continue;
+			}
+
+			AddInstance(entity, mesh);
+		}
+		m_PendingEntities = std::move(pending);
+
+		// Note(Jorben): Looked up after every add & remove, so the slots are the ones the instances ended up in
+		snapshot.InstanceCount = (uint32_t)m_Instances.size();
+		snapshot.Slots.reserve(m_DirtyEntities.size());
+		snapshot.Models.reserve(m_DirtyEntities.size());
+		snapshot.Instances.reserve(m_DirtyEntities.size());
+
+		for (auto& entity : m_DirtyEntities)
+		{
+			auto it = m_InstanceSlots.find(entity);
+			if (it == m_InstanceSlots.end())
+				continue;
+
+			snapshot.Slots.push_back(it->second);
+			snapshot.Models.push_back({ transforms.get<TransformComponent>(entity).GetMatrix() });
+			snapshot.Instances.push_back(m_Instances[it->second].Batch);
+		}
+		m_DirtyEntities.clear();
+
+		// Note(Jorben): The map is ordered by albedo, so this puts the commands of every albedo next to each other
+		if (m_BatchesChanged)
+		{
+			snapshot.BatchesChanged = true;
+			snapshot.Batches.resize(m_Batches.size());
+			snapshot.Commands.reserve(m_BatchIndices.size());
+
+			uint32_t firstInstance = 0;
+			for (auto& [key, index] : m_BatchIndices)
+			{
+				const DrawBatch& batch = m_Batches[index];
+				const BoundingSphere& sphere = batch.Mesh.MeshObject->GetBounds();
+				const GeometryRange& geometry = batch.Mesh.MeshObject->GetGeometry();
+
+				if (snapshot.Groups.empty() || snapshot.Groups.back().Albedo.get() != key.first)
+					snapshot.Groups.push_back({ batch.Mesh.Albedo, (uint32_t)snapshot.Commands.size(), 0 });
+				snapshot.Groups.back().BatchCount++;
+
+				ShaderBatch& shaderBatch = snapshot.Batches[index];
+				shaderBatch.Bounds = glm::vec4(sphere.Center, sphere.Radius);
+				shaderBatch.Command = (uint32_t)snapshot.Commands.size();
+
+				// Note(Jorben): The instance count is filled in by the culling pass
+				IndexedIndirectCommand command = {};
+				command.IndexCount = geometry.IndexCount;
+				command.InstanceCount = 0;
+				command.FirstIndex = geometry.FirstIndex;
+				command.VertexOffset = (int32_t)geometry.VertexOffset;
+				command.FirstInstance = firstInstance;
+				snapshot.Commands.push_back(command);
+
+				firstInstance += batch.InstanceCount;
+			}
+
+			m_BatchesChanged = false;
+		}
+	}
+
+	// Point Lights
+	{
+		auto view = m_Registry.view<PointLightComponent>();
+		auto transforms = m_Registry.view<TransformComponent>();
+
+		// Note(Jorben): The lights buffer and the culling shaders' arrays hold MAX_POINTLIGHTS, the rest is dropped
+		if (view.size() > MAX_POINTLIGHTS && !m_LightsClamped)
+		{
+			APP_LOG_WARN("The scene has {0} point lights, only the first {1} are rendered.", view.size(), MAX_POINTLIGHTS);
+			m_LightsClamped = true;
+		}
+
+		snapshot.Lights.reserve(std::min(view.size(), (size_t)MAX_POINTLIGHTS));
+
+		for (auto& entity : view)
+		{
+			if (snapshot.Lights.size() == MAX_POINTLIGHTS)
+				break;
+
+			PointLightComponent pointLight = view.get<PointLightComponent>(entity);
+			APP_ASSERT(transforms.contains(entity), "Entity with PointLightComponent doesn't have TransformComponent.");
+
+			ShaderPointLight light = {};
+			light.Position = transforms.get<TransformComponent>(entity).Position;
+			light.Colour = pointLight.Colour;
+			light.Radius = pointLight.Radius;
+			light.Intensity = pointLight.Intensity;
+
+			snapshot.Lights.push_back(light);
+		}
+	}
+
+	// Scene Data
+	{
+		snapshot.Scene.ScreenSize = { Application::Get().GetWindow().GetWidth(), Application::Get().GetWindow().GetHeight() };
+		snapshot.Scene.Assignment = Resources::Assignment;
+		snapshot.GPUDriven = Resources::GPUDriven;
+	}
+
+	Renderer::Submit([this, snapshot = std::move(snapshot)]() mutable
+	{
+		UploadFrame(snapshot);
+	});
+}
+
+void Scene::OnRender()
+{
+	// Note(Jorben): Read once, so every pass of the frame agrees on which culling ran
+	const bool tiled = (Resources::Assignment == LightAssignment::Tiled);
+
+	// Draw culling
+	RenderDrawCulling();
+
+	// Note(Jorben): The clusters don't depend on the depth buffer, so they're culled on the compute queue alongside the draw culling & depth pre pass
+	if (!tiled)
+		RenderClusterCulling();
+
+	// Depth pre pass
+	Renderer::Submit([this, tiled]()
+	{
+		auto& modelSet = Resources::Depth::DescriptorSets->GetSets(0)[0];
+		auto& cameraSet = Resources::Depth::DescriptorSets->GetSets(1)[0];
+
+		auto commandBuffer = Resources::Depth::RenderPass->GetCommandBuffer();
+		commandBuffer->Begin();
+		commandBuffer->BeginTiming("Depth", Resources::PassTimingFlags);
+
+		auto bind = [&](Ref<CommandBuffer> target)
+		{
+			Resources::Depth::Pipeline->Use(target);
+			modelSet->Bind(Resources::Depth::Pipeline, target);
+			cameraSet->Bind(Resources::Depth::Pipeline, target, PipelineBindPoint::Graphics, { m_CameraAllocation.GetDynamicOffset() });
+
+			// Note(Jorben): Every mesh lives in the same vertex & index buffer
+			Renderer::GetGeometryPool()->Bind(target);
+		};
+
+		if (m_Resident.GPUDriven)
+		{
+			// Note(Jorben): The draws & visible instances come from the draw culling, this also covers the shading pass' reads
+			commandBuffer->Barrier(PipelineAccess::ComputeWrite, PipelineAccess::IndirectRead | PipelineAccess::VertexRead);
+			Resources::Depth::RenderPass->Begin();
+
+			bind(commandBuffer);
+
+			// Note(Jorben): The culling pass filled in the instance counts and how many commands there are to draw,
+			// the instance index is used to retrieve the model matrix through the visible buffer
+			Renderer::DrawIndexedIndirectCount(commandBuffer, Resources::DrawCulling::DrawBuffer, (uint32_t)m_Resident.Commands.size());
+		}
+		else
+		{
+			Resources::Depth::RenderPass->Begin(RenderPassContents::Secondary);
+			RecordDraws(Resources::Depth::RenderPass, bind);
+		}
+
+		Resources::Depth::RenderPass->End();
+		commandBuffer->EndTiming();
+
+		// Note(Jorben): Tile culling reads the depth buffer on the compute queue, which might be of another queue family
+		if (tiled)
+			Renderer::GetDepthImage()->Release(commandBuffer, Queue::Graphics, Queue::Compute, ImageLayout::Depth, ImageLayout::DepthRead);
+		else
+			Renderer::GetDepthImage()->Transition(commandBuffer, ImageLayout::Depth, ImageLayout::DepthRead);
+
+		commandBuffer->End();
+		Resources::Depth::RenderPass->Submit();
+	});
+
+	// Light culling
+	if (tiled)
+		RenderTileCulling();
+
+	// Final shading
+	Renderer::Submit([this, tiled]()
+	{
+		Ref<CommandBuffer> culling = (tiled ? Resources::LightCulling::CommandBuffer : Resources::ClusterCulling::CommandBuffer);
+
+		auto& set0 = Resources::Shading::DescriptorSets->GetSets(0)[0];
+		auto& set1 = Resources::Shading::DescriptorSets->GetSets(1)[0];
+
+		Resources::LightCulling::LightsBuffer->Upload(set0, Resources::Shading::DescriptorSets->GetLayout(0).GetDescriptorByName("u_Lights"));
+		Resources::LightCulling::LightVisibilityBuffer->Upload(set0, Resources::Shading::DescriptorSets->GetLayout(0).GetDescriptorByName("u_Visibility"));
+		Resources::LightCulling::LightIndexBuffer->Upload(set0, Resources::Shading::DescriptorSets->GetLayout(0).GetDescriptorByName("u_LightIndices"));
+
+		auto commandBuffer = Resources::Shading::RenderPass->GetCommandBuffer();
+		commandBuffer->Begin();
+
+		// Handed back by the light culling, the semaphore wait on it makes its writes visible
+		Resources::LightCulling::LightsBuffer->Acquire(commandBuffer, Queue::Compute, Queue::Graphics);
+		Resources::LightCulling::LightVisibilityBuffer->Acquire(commandBuffer, Queue::Compute, Queue::Graphics);
+		Resources::LightCulling::LightIndexBuffer->Acquire(commandBuffer, Queue::Compute, Queue::Graphics);
+		if (tiled)
+			Renderer::GetDepthImage()->Acquire(commandBuffer, Queue::Compute, Queue::Graphics, ImageLayout::DepthRead, ImageLayout::DepthRead);
+
+		commandBuffer->BeginTiming("Shading", Resources::PassTimingFlags);
+		Resources::Shading::RenderPass->Begin(RenderPassContents::Secondary);
+
+		auto bind = [&](Ref<CommandBuffer> secondary)
+		{
+			Resources::Shading::Pipeline->Use(secondary);
+			set0->Bind(Resources::Shading::Pipeline, secondary);
+			set1->Bind(Resources::Shading::Pipeline, secondary, PipelineBindPoint::Graphics, { m_CameraAllocation.GetDynamicOffset(), m_SceneAllocation.GetDynamicOffset() });
+
+			Renderer::GetGeometryPool()->Bind(secondary);
+		};
+
+		if (m_Resident.GPUDriven)
+		{
+			// Note(Jorben): Every albedo has its own descriptor set, so the batches are drawn with one indirect draw per albedo
+			Resources::Shading::RenderPass->RecordParallel((uint32_t)m_Resident.Groups.size(), [&](Ref<CommandBuffer> secondary, uint32_t first, uint32_t count)
+			{
+				bind(secondary);
+
+				for (uint32_t i = first; i < first + count; i++)
+				{
+					const DrawGroup& group = m_Resident.Groups[i];
+
+					Resources::GetAlbedoSet(group.Albedo)->Bind(Resources::Shading::Pipeline, secondary);
+
+					Renderer::DrawIndexedIndirect(secondary, Resources::DrawCulling::DrawBuffer, group.BatchCount, group.FirstBatch);
+				}
+			});
+		}
+		else
+		{
+			RecordDraws(Resources::Shading::RenderPass, bind, Resources::Shading::Pipeline);
+		}
+
+		Resources::Shading::RenderPass->End();
+		commandBuffer->EndTiming();
+		commandBuffer->End();
+
+		// Note(Jorben): The only point graphics waits on the light culling, everything before it runs alongside the culling
+		Resources::Shading::RenderPass->Submit({ culling });
+	});
+
+	// Heatmap
+	RenderHeatMap();
+}
+
+void Scene::OnEvent(Event& e)
+{
+	EventHandler handler(e);
+
+	handler.Handle<WindowResizeEvent>(APP_BIND_EVENT_FN(Scene::OnResize));
+	handler.Handle<KeyPressedEvent>(APP_BIND_EVENT_FN(Scene::OnKeyPress));
+
+	m_Camera->OnEvent(e);
+}
+
+void Scene::OnImGuiRender()
+{
+}
+
+void Scene::LoadDemo()
+{
 	// Manually add some entities
 	{
 		TransformComponent transform = {};
@@ -23,8 +329,8 @@ Scene::Scene()
 		transform.Rotation = { -90.0f, 0.0, 270.0f };
 
 		MeshComponent mesh = {};
-		mesh.MeshObject = Mesh::Create("assets/objects/viking_room.obj");
-		mesh.Albedo = Image2D::Create({"assets/objects/viking_room.png"});
+		mesh.MeshObject = Mesh::CreateAsync("assets/objects/viking_room.obj");
+		mesh.Albedo = Image2D::CreateAsync({"assets/objects/viking_room.png"});
 
 		PointLightComponent light = {};
 		light.Colour = { 0.0f, 1.0f, 1.0f };
@@ -59,126 +365,362 @@ Scene::Scene()
 		m_Registry.emplace<PointLightComponent>(vk2, light);
 	}
 
-	InitHeatMap();
+	// Note(Jorben): Everything above was staged into a single batch, it's submitted at the next BeginFrame and the meshes are drawn once it's done
 }
 
-Scene::~Scene()
+LightListStatistics Scene::GetLightListStatistics()
 {
-	Resources::Destroy();
-}
+	LightListStatistics statistics = {};
 
-void Scene::OnUpdate(float deltaTime)
-{
-	// Camera
+	// Visibility
 	{
-		m_Camera->OnUpdate(deltaTime);
+		auto buffer = Resources::LightCulling::LightVisibilityBuffer;
+		const uint32_t* data = (const uint32_t*)buffer->StartRetrieval();
 
-		Resources::CameraBuffer->SetData((void*)&m_Camera->GetCamera(), sizeof(ShaderCamera));
+		const uint32_t* cells = data + LIGHT_GRID_HEADER_UINTS;
+		const uint32_t capacity = (uint32_t)((buffer->GetSize() / sizeof(uint32_t) - LIGHT_GRID_HEADER_UINTS) / LIGHT_GRID_CELL_UINTS);
 
-		Resources::CameraBuffer->Upload(Resources::Depth::DescriptorSets->GetSets(1)[0], Resources::Depth::DescriptorSets->GetLayout(1).GetDescriptorByName("u_Camera"));
-		Resources::CameraBuffer->Upload(Resources::LightCulling::DescriptorSets->GetSets(1)[0], Resources::LightCulling::DescriptorSets->GetLayout(1).GetDescriptorByName("u_Camera"));
-		Resources::CameraBuffer->Upload(Resources::Shading::DescriptorSets->GetSets(1)[0], Resources::Shading::DescriptorSets->GetLayout(1).GetDescriptorByName("u_Camera"));
+		statistics.Cells = std::min(data[0], capacity);
+		statistics.MinLights = (statistics.Cells ? MAX_UINT32 : 0u);
+
+		uint64_t total = 0;
+		for (uint32_t i = 0; i < statistics.Cells; i++)
+		{
+			uint32_t count = cells[i * LIGHT_GRID_CELL_UINTS + 1];
+
+			statistics.MinLights = std::min(statistics.MinLights, count);
+			statistics.MaxLights = std::max(statistics.MaxLights, count);
+			if (count == 0)
+				statistics.EmptyCells++;
+
+			total += count;
+		}
+
+		statistics.AverageLights = (statistics.Cells ? (float)((double)total / (double)statistics.Cells) : 0.0f);
+		buffer->EndRetrieval();
 	}
 
-	// Model matrices
+	// Index pool
 	{
-		// TODO: Check if we need to resize 
+		auto buffer = Resources::LightCulling::LightIndexBuffer;
+		uint32_t* data = (uint32_t*)buffer->StartRetrieval();
 
-		auto view = m_Registry.view<MeshComponent>();
-		std::vector<ShaderModel> matrices(view.size());
+		statistics.PoolUsed = data[0];
+		statistics.PoolCapacity = (uint32_t)((buffer->GetSize() / sizeof(uint32_t)) - LIGHT_INDEX_POOL_HEADER_UINTS);
 
-		size_t i = 0;
-		for (auto& entity : view)
+		buffer->EndRetrieval();
+	}
+
+	return statistics;
+}
+
+Ref<Scene> Scene::Create()
+{
+	return RefHelper::Create<Scene>();
+}
+
+void Scene::UploadFrame(FrameSnapshot& snapshot)
+{
+	const uint32_t frame = Renderer::GetCurrentFrame();
+
+	// Camera
+	m_CameraAllocation = Renderer::GetUploadRing()->Push(snapshot.Camera);
+
+	// Model matrices
+	// Note(Jorben): Every frame has its own copy of the buffers, so a change is written to the current copy now
+	// and to the others once their frames come round
+	{
+		m_Resident.InstanceCount = snapshot.InstanceCount;
+		m_Resident.Models.resize(snapshot.InstanceCount);
+		m_Resident.Instances.resize(snapshot.InstanceCount);
+
+		for (size_t i = 0; i < snapshot.Slots.size(); i++)
 		{
-			auto transforms = m_Registry.view<TransformComponent>();
-			APP_ASSERT(transforms.contains(entity), "Entity with MeshComponent doesn't have TransformComponent.");
+			m_Resident.Models[snapshot.Slots[i]] = snapshot.Models[i];
+			m_Resident.Instances[snapshot.Slots[i]] = snapshot.Instances[i];
+		}
+
+		for (auto& slots : m_Resident.DirtySlots)
+			slots.insert(slots.end(), snapshot.Slots.begin(), snapshot.Slots.end());
 
-			matrices[i] = { transforms.get<TransformComponent>(entity).GetMatrix() };
-			Resources::ModelBuffer->SetDataIndexed((uint32_t)i, &matrices[i], sizeof(ShaderModel));
+		// Note(Jorben): Growing recreates every copy, so they all have to be written in full again
+		if (Resources::ReserveModels(m_Resident.InstanceCount))
+			m_Resident.DirtyInstances.fill(true);
+
+		if (m_Resident.DirtyInstances[frame])
+		{
+			if (m_Resident.InstanceCount > 0)
+			{
+				Resources::ModelBuffer->SetData((void*)m_Resident.Models.data(), sizeof(ShaderModel) * m_Resident.InstanceCount);
+				Resources::DrawCulling::InstanceBuffer->SetData((void*)m_Resident.Instances.data(), sizeof(uint32_t) * m_Resident.InstanceCount, sizeof(uint32_t) * INSTANCE_BUFFER_HEADER_UINTS);
+			}
 
-			i++;
+			m_Resident.DirtyInstances[frame] = false;
 		}
-		Resources::ModelBuffer->UploadIndexedData();
+		else
+		{
+			for (auto& slot : m_Resident.DirtySlots[frame])
+			{
+				// Note(Jorben): The slot might have been removed (swapped out) since
+				if (slot >= m_Resident.InstanceCount)
+					continue;
+
+				Resources::ModelBuffer->SetData((void*)&m_Resident.Models[slot], sizeof(ShaderModel), sizeof(ShaderModel) * slot);
+				Resources::DrawCulling::InstanceBuffer->SetData((void*)&m_Resident.Instances[slot], sizeof(uint32_t), sizeof(uint32_t) * (INSTANCE_BUFFER_HEADER_UINTS + slot));
+			}
+		}
+		m_Resident.DirtySlots[frame].clear();
+
+		Resources::DrawCulling::InstanceBuffer->SetData((void*)&m_Resident.InstanceCount, sizeof(uint32_t));
 	}
 
-	// Point Lights
+	// Draw culling
 	{
-		auto view = m_Registry.view<PointLightComponent>();
-		std::vector<ShaderPointLight> lights(view.size());
-
-		size_t i = 0;
-		for (auto& entity : view)
+		if (snapshot.BatchesChanged)
 		{
-			PointLightComponent pointLight = view.get<PointLightComponent>(entity);
-
-			auto transforms = m_Registry.view<TransformComponent>();
-			APP_ASSERT(transforms.contains(entity), "Entity with PointLightComponent doesn't have TransformComponent.");
+			m_Resident.Batches = std::move(snapshot.Batches);
+			m_Resident.Commands = std::move(snapshot.Commands);
+			m_Resident.Groups = std::move(snapshot.Groups);
+			m_Resident.DirtyBatches.fill(true);
+
+			m_Resident.CommandGroups.resize(m_Resident.Commands.size());
+			for (uint32_t i = 0; i < (uint32_t)m_Resident.Groups.size(); i++)
+				std::fill_n(m_Resident.CommandGroups.begin() + m_Resident.Groups[i].FirstBatch, m_Resident.Groups[i].BatchCount, i);
+
+			// Note(Jorben): Only batches reference the albedos, so they can only become unused when the batches change
+			Resources::ReleaseUnusedAlbedos();
+			for (auto& group : m_Resident.Groups)
+				Resources::RegisterAlbedo(group.Albedo);
+		}
 
-			ShaderPointLight light = {};
-			light.Position = transforms.get<TransformComponent>(entity).Position;
-			light.Colour = pointLight.Colour;
-			light.Radius = pointLight.Radius;
-			light.Intensity = pointLight.Intensity;
+		if (Resources::ReserveBatches((uint32_t)m_Resident.Batches.size()))
+			m_Resident.DirtyBatches.fill(true);
 
-			lights[i] = light;
+		if (m_Resident.DirtyBatches[frame])
+		{
+			if (!m_Resident.Batches.empty())
+				Resources::DrawCulling::BatchBuffer->SetData((void*)m_Resident.Batches.data(), sizeof(ShaderBatch) * m_Resident.Batches.size());
 
-			i++;
+			m_Resident.DirtyBatches[frame] = false;
 		}
 
-		uint32_t size = (uint32_t)lights.size();
+		// Note(Jorben): Written every frame, the culling pass counts the instances up from 0
+		if (!m_Resident.Commands.empty())
+			Resources::DrawCulling::DrawBuffer->SetCommands(m_Resident.Commands.data(), (uint32_t)m_Resident.Commands.size());
+		Resources::DrawCulling::DrawBuffer->SetCount(0);
+
+		m_Resident.GPUDriven = snapshot.GPUDriven;
+		if (!m_Resident.GPUDriven)
+			CullDraws(snapshot.Camera);
+	}
+
+	// Point Lights
+	{
+		uint32_t size = (uint32_t)snapshot.Lights.size();
 		Resources::LightCulling::LightsBuffer->SetData((void*)&size, sizeof(uint32_t));
-		Resources::LightCulling::LightsBuffer->SetData((void*)lights.data(), sizeof(ShaderPointLight) * lights.size(), sizeof(uint32_t) + (sizeof(char) * 12)); 
+		Resources::LightCulling::LightsBuffer->SetData((void*)snapshot.Lights.data(), sizeof(ShaderPointLight) * snapshot.Lights.size(), sizeof(uint32_t) + (sizeof(char) * 12)); 
 		Resources::LightCulling::LightsBuffer->Upload(Resources::LightCulling::DescriptorSets->GetSets(0)[0], Resources::LightCulling::DescriptorSets->GetLayout(0).GetDescriptorByName("u_Lights"));
 
 		Resources::LightCulling::LightVisibilityBuffer->Upload(Resources::LightCulling::DescriptorSets->GetSets(0)[0], Resources::LightCulling::DescriptorSets->GetLayout(0).GetDescriptorByName("u_Visibility"));
+		Resources::LightCulling::LightIndexBuffer->Upload(Resources::LightCulling::DescriptorSets->GetSets(0)[0], Resources::LightCulling::DescriptorSets->GetLayout(0).GetDescriptorByName("u_LightIndices"));
+
+		Resources::LightCulling::LightsBuffer->Upload(Resources::ClusterCulling::DescriptorSets->GetSets(0)[0], Resources::ClusterCulling::DescriptorSets->GetLayout(0).GetDescriptorByName("u_Lights"));
+		Resources::LightCulling::LightVisibilityBuffer->Upload(Resources::ClusterCulling::DescriptorSets->GetSets(0)[0], Resources::ClusterCulling::DescriptorSets->GetLayout(0).GetDescriptorByName("u_Visibility"));
+		Resources::LightCulling::LightIndexBuffer->Upload(Resources::ClusterCulling::DescriptorSets->GetSets(0)[0], Resources::ClusterCulling::DescriptorSets->GetLayout(0).GetDescriptorByName("u_LightIndices"));
+
+		// Note(Jorben): Reset the index pool's allocation counter, only this frame's copy is written and it isn't in use anymore
+		uint32_t counter = 0;
+		Resources::LightCulling::LightIndexBuffer->SetData((void*)&counter, sizeof(uint32_t));
 	}
 
 	// Scene Data
+	m_SceneAllocation = Renderer::GetUploadRing()->Push(snapshot.Scene);
+}
+
+void Scene::CullDraws(const ShaderCamera& camera)
+{
+	// Note(Jorben): Same planes & test as the DrawCulling pass (see DrawCulling.comp)
+	glm::mat4 viewProjection = camera.Projection * camera.View;
+	glm::vec4 row0 = glm::vec4(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+	glm::vec4 row1 = glm::vec4(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+	glm::vec4 row2 = glm::vec4(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+	glm::vec4 row3 = glm::vec4(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+	std::array<glm::vec4, 6> planes = { row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2 };
+	for (auto& plane : planes)
+		plane /= glm::length(glm::vec3(plane));
+
+	// Note(Jorben): Counted per command first, so the draws can be sorted by command (and so by albedo) without a sort
+	std::vector<uint32_t> visible = { };
+	std::vector<uint32_t> offsets(m_Resident.Commands.size() + 1, 0);
+	visible.reserve(m_Resident.InstanceCount);
+
+	for (uint32_t slot = 0; slot < m_Resident.InstanceCount; slot++)
 	{
-		ShaderScene uniform = { { Application::Get().GetWindow().GetWidth(), Application::Get().GetWindow().GetHeight() } };
-		Resources::SceneBuffer->SetData((void*)&uniform, sizeof(ShaderScene));
-		Resources::SceneBuffer->Upload(Resources::LightCulling::DescriptorSets->GetSets(1)[0], Resources::LightCulling::DescriptorSets->GetLayout(1).GetDescriptorByName("u_Scene"));
-		Resources::SceneBuffer->Upload(Resources::Shading::DescriptorSets->GetSets(1)[0], Resources::Shading::DescriptorSets->GetLayout(1).GetDescriptorByName("u_Scene"));
+		const ShaderBatch& batch = m_Resident.Batches[m_Resident.Instances[slot]];
+		const glm::mat4& model = m_Resident.Models[slot].Model;
+
+		glm::vec3 center = glm::vec3(model * glm::vec4(glm::vec3(batch.Bounds), 1.0f));
+		float scale = std::sqrt(std::max(std::max(glm::dot(glm::vec3(model[0]), glm::vec3(model[0])), glm::dot(glm::vec3(model[1]), glm::vec3(model[1]))), glm::dot(glm::vec3(model[2]), glm::vec3(model[2]))));
+		float radius = batch.Bounds.w * scale;
+
+		bool inside = true;
+		for (auto& plane : planes)
+			inside &= (glm::dot(glm::vec3(plane), center) + plane.w >= -radius);
+
+		if (!inside)
+			continue;
+
+		visible.push_back(slot);
+		offsets[batch.Command + 1]++;
 	}
+
+	for (size_t i = 1; i < offsets.size(); i++)
+		offsets[i] += offsets[i - 1];
+
+	std::vector<uint32_t> sorted(visible.size(), 0);
+	m_Resident.Draws.resize(visible.size());
+	for (auto& slot : visible)
+	{
+		uint32_t command = m_Resident.Batches[m_Resident.Instances[slot]].Command;
+		uint32_t draw = offsets[command]++;
+
+		sorted[draw] = slot;
+		m_Resident.Draws[draw] = command;
+	}
+
+	if (!sorted.empty())
+		Resources::DrawCulling::VisibleBuffer->SetData((void*)sorted.data(), sizeof(uint32_t) * sorted.size());
 }
 
-void Scene::OnRender()
+void Scene::RecordDraws(Ref<RenderPass> renderPass, const std::function<void(Ref<CommandBuffer>)>& bind, Ref<Pipeline> albedoPipeline)
 {
-	// Depth pre pass
-	Renderer::Submit([this]()
+	renderPass->RecordParallel((uint32_t)m_Resident.Draws.size(), [&](Ref<CommandBuffer> secondary, uint32_t first, uint32_t count)
 	{
-		auto modelSets = Resources::Depth::DescriptorSets->GetSets(0);
-		auto cameraSet = Resources::Depth::DescriptorSets->GetSets(1)[0];
+		bind(secondary);
 
-		Resources::Depth::RenderPass->Begin();
+		uint32_t group = MAX_UINT32;
+		for (uint32_t i = first; i < first + count; i++)
+		{
+			const IndexedIndirectCommand& command = m_Resident.Commands[m_Resident.Draws[i]];
 
-		Resources::Depth::Pipeline->Use(Resources::Depth::RenderPass->GetCommandBuffer());
-		cameraSet->Bind(Resources::Depth::Pipeline, Resources::Depth::RenderPass->GetCommandBuffer());
+			if (albedoPipeline && m_Resident.CommandGroups[m_Resident.Draws[i]] != group)
+			{
+				group = m_Resident.CommandGroups[m_Resident.Draws[i]];
+				Resources::GetAlbedoSet(m_Resident.Groups[group].Albedo)->Bind(albedoPipeline, secondary);
+			}
+
+			// Note(Jorben): The instance index is the draw's index in the visible buffer, which holds its model matrix
+			Renderer::DrawIndexed(secondary, command.IndexCount, 1, command.FirstIndex, command.VertexOffset, i);
+		}
+	});
+}
 
-		auto view = m_Registry.view<MeshComponent>();
-		std::vector<ShaderModel> matrices(view.size());
+void Scene::OnMeshChange(entt::registry& registry, entt::entity entity)
+{
+	// Note(Jorben): A changed mesh or albedo moves the entity to another batch, it's added again once both are uploaded
+	RemoveInstance(entity);
+	m_PendingEntities.push_back(entity);
+}
 
-		size_t i = 0;
-		for (auto& entity : view)
+void Scene::OnMeshDestroy(entt::registry& registry, entt::entity entity)
+{
+	RemoveInstance(entity);
+}
+
+void Scene::OnTransformChange(entt::registry& registry, entt::entity entity)
+{
+	m_DirtyEntities.push_back(entity);
+}
+
+void Scene::AddInstance(entt::entity entity, const MeshComponent& mesh)
+{
+	uint32_t index = (uint32_t)m_Batches.size();
+	if (!m_FreeBatches.empty())
+		index = m_FreeBatches.back();
+
+	auto [it, inserted] = m_BatchIndices.try_emplace({ mesh.Albedo.get(), mesh.MeshObject.get() }, index);
+	if (inserted)
+	{
+		if (index == (uint32_t)m_Batches.size())
+			m_Batches.push_back({ mesh, 0 });
+		else
 		{
-			MeshComponent mesh = view.get<MeshComponent>(entity);
+			m_FreeBatches.pop_back();
+			m_Batches[index] = { mesh, 0 };
+		}
+	}
+
+	m_Batches[it->second].InstanceCount++;
+
+	m_InstanceSlots[entity] = (uint32_t)m_Instances.size();
+	m_Instances.push_back({ entity, it->second });
+
+	// Note(Jorben): Every batch after this one has its instances shifted
+	m_BatchesChanged = true;
+	m_DirtyEntities.push_back(entity);
+}
+
+void Scene::RemoveInstance(entt::entity entity)
+{
+	auto it = m_InstanceSlots.find(entity);
+	if (it == m_InstanceSlots.end())
+		return;
+
+	const uint32_t slot = it->second;
+	const uint32_t batch = m_Instances[slot].Batch;
+	m_InstanceSlots.erase(it);
+
+	// Note(Jorben): The last instance takes over the slot, so its model matrix has to be written there
+	if (slot != (uint32_t)m_Instances.size() - 1)
+	{
+		m_Instances[slot] = m_Instances.back();
+		m_InstanceSlots[m_Instances[slot].Entity] = slot;
+		m_DirtyEntities.push_back(m_Instances[slot].Entity);
+	}
+	m_Instances.pop_back();
+
+	DrawBatch& drawBatch = m_Batches[batch];
+	if (--drawBatch.InstanceCount == 0)
+	{
+		m_BatchIndices.erase({ drawBatch.Mesh.Albedo.get(), drawBatch.Mesh.MeshObject.get() });
+		drawBatch.Mesh = {};
+		m_FreeBatches.push_back(batch);
+	}
+
+	m_BatchesChanged = true;
+}
+
+void Scene::RenderDrawCulling()
+{
+	Renderer::Submit([this]()
+	{
+		// Note(Jorben): Without GPU driven rendering the draws & visible buffer are filled in on the CPU (see Scene::CullDraws)
+		const uint32_t instances = (m_Resident.GPUDriven ? m_Resident.InstanceCount : 0u);
+		auto& set0 = Resources::DrawCulling::DescriptorSets->GetSets(0)[0];
+		auto& set1 = Resources::DrawCulling::DescriptorSets->GetSets(1)[0];
 
-			Resources::ModelBuffer->Upload(modelSets[i], Resources::Depth::DescriptorSets->GetLayout(0).GetDescriptorByName("u_Model"), sizeof(ShaderModel) * i);
-			modelSets[i]->Bind(Resources::Depth::Pipeline, Resources::Depth::RenderPass->GetCommandBuffer(), PipelineBindPoint::Graphics, { 0 });
+		Resources::DrawCulling::CommandBuffer->Begin();
+		Resources::DrawCulling::CommandBuffer->BeginTiming("DrawCulling", Resources::PassTimingFlags);
 
-			mesh.MeshObject->GetVertexBuffer()->Bind(Resources::Depth::RenderPass->GetCommandBuffer());
-			mesh.MeshObject->GetIndexBuffer()->Bind(Resources::Depth::RenderPass->GetCommandBuffer());
+		if (instances > 0)
+		{
+			Resources::DrawCulling::Pipeline->Use(Resources::DrawCulling::CommandBuffer, PipelineBindPoint::Compute);
 
-			Renderer::DrawIndexed(Resources::Depth::RenderPass->GetCommandBuffer(), mesh.MeshObject->GetIndexBuffer());
+			set0->Bind(Resources::DrawCulling::Pipeline, Resources::DrawCulling::CommandBuffer, PipelineBindPoint::Compute);
+			set1->Bind(Resources::DrawCulling::Pipeline, Resources::DrawCulling::CommandBuffer, PipelineBindPoint::Compute, { m_CameraAllocation.GetDynamicOffset() });
 
-			i++;
+			Resources::DrawCulling::ComputeShader->Dispatch(Resources::DrawCulling::CommandBuffer, (instances + DRAW_CULLING_THREADS - 1) / DRAW_CULLING_THREADS, 1, 1);
 		}
 
-		Resources::Depth::RenderPass->End();
-		Resources::Depth::RenderPass->Submit();
+		Resources::DrawCulling::CommandBuffer->EndTiming();
+		Resources::DrawCulling::CommandBuffer->End();
+		Resources::DrawCulling::CommandBuffer->Submit(Queue::Graphics);
 	});
+}
 
-	// Light culling
+void Scene::RenderTileCulling()
+{
 	Renderer::Submit([this]()
 	{
 		const glm::uvec2 tiles = GetTileCount();
@@ -186,80 +728,57 @@ void Scene::OnRender()
 		auto& set1 = Resources::LightCulling::DescriptorSets->GetSets(1)[0];
 
 		Resources::LightCulling::CommandBuffer->Begin();
+		Resources::LightCulling::CommandBuffer->BeginTiming("LightCulling", Resources::PassTimingFlags);
 
-		Renderer::GetDepthImage()->Transition(ImageLayout::Depth, ImageLayout::DepthRead);
+		Renderer::GetDepthImage()->Acquire(Resources::LightCulling::CommandBuffer, Queue::Graphics, Queue::Compute, ImageLayout::Depth, ImageLayout::DepthRead);
 		Renderer::GetDepthImage()->Upload(set0, Resources::LightCulling::DescriptorSets->GetLayout(0).GetDescriptorByName("u_DepthBuffer"));
 
 		Resources::LightCulling::Pipeline->Use(Resources::LightCulling::CommandBuffer, PipelineBindPoint::Compute);
 
 		set0->Bind(Resources::LightCulling::Pipeline, Resources::LightCulling::CommandBuffer, PipelineBindPoint::Compute);
-		set1->Bind(Resources::LightCulling::Pipeline, Resources::LightCulling::CommandBuffer, PipelineBindPoint::Compute);
+		set1->Bind(Resources::LightCulling::Pipeline, Resources::LightCulling::CommandBuffer, PipelineBindPoint::Compute, { m_CameraAllocation.GetDynamicOffset(), m_SceneAllocation.GetDynamicOffset() });
 
 		Resources::LightCulling::ComputeShader->Dispatch(Resources::LightCulling::CommandBuffer, tiles.x, tiles.y, 1);
 
+		Resources::LightCulling::CommandBuffer->EndTiming();
+
+		ReleaseLightLists(Resources::LightCulling::CommandBuffer);
+		Renderer::GetDepthImage()->Release(Resources::LightCulling::CommandBuffer, Queue::Compute, Queue::Graphics, ImageLayout::DepthRead, ImageLayout::DepthRead);
+
 		Resources::LightCulling::CommandBuffer->End();
-		Resources::LightCulling::CommandBuffer->Submit(Queue::Compute);
-	});
 
-	// Heatmap
-	RenderHeatMap();
+		// Note(Jorben): Only waits on the depth pre pass, not on everything submitted before it
+		Resources::LightCulling::CommandBuffer->Submit(Queue::Compute, { Resources::Depth::RenderPass->GetCommandBuffer() });
+	});
+}
 
-	// Final shading
+void Scene::RenderClusterCulling()
+{
 	Renderer::Submit([this]()
 	{
-		auto& set0 = Resources::Shading::DescriptorSets->GetSets(0);
-		auto& set1 = Resources::Shading::DescriptorSets->GetSets(1)[0];
-
-		Resources::Shading::RenderPass->Begin();
+		const glm::uvec3 clusters = GetClusterCount();
+		auto& set0 = Resources::ClusterCulling::DescriptorSets->GetSets(0)[0];
+		auto& set1 = Resources::ClusterCulling::DescriptorSets->GetSets(1)[0];
 
-		Resources::Shading::Pipeline->Use(Resources::Shading::RenderPass->GetCommandBuffer());
-		set1->Bind(Resources::Shading::Pipeline, Resources::Shading::RenderPass->GetCommandBuffer());
+		Resources::ClusterCulling::CommandBuffer->Begin();
+		Resources::ClusterCulling::CommandBuffer->BeginTiming("ClusterCulling", Resources::PassTimingFlags);
 
-		auto view = m_Registry.view<MeshComponent>();
+		Resources::ClusterCulling::Pipeline->Use(Resources::ClusterCulling::CommandBuffer, PipelineBindPoint::Compute);
 
-		size_t i = 0;
-		for (auto& entity : view)
-		{
-			MeshComponent mesh = view.get<MeshComponent>(entity);
+		set0->Bind(Resources::ClusterCulling::Pipeline, Resources::ClusterCulling::CommandBuffer, PipelineBindPoint::Compute);
+		set1->Bind(Resources::ClusterCulling::Pipeline, Resources::ClusterCulling::CommandBuffer, PipelineBindPoint::Compute, { m_CameraAllocation.GetDynamicOffset(), m_SceneAllocation.GetDynamicOffset() });
 
-			Resources::ModelBuffer->Upload(set0[i], Resources::Shading::DescriptorSets->GetLayout(0).GetDescriptorByName("u_Model"), sizeof(ShaderModel) * i);
-			mesh.Albedo->Upload(set0[i], Resources::Shading::DescriptorSets->GetLayout(0).GetDescriptorByName("u_Albedo"));
-			Resources::LightCulling::LightsBuffer->Upload(set0[i], Resources::Shading::DescriptorSets->GetLayout(0).GetDescriptorByName("u_Lights"));
-			Resources::LightCulling::LightVisibilityBuffer->Upload(set0[i], Resources::Shading::DescriptorSets->GetLayout(0).GetDescriptorByName("u_Visibility"));
-			
-			set0[i]->Bind(Resources::Shading::Pipeline, Resources::Shading::RenderPass->GetCommandBuffer(), PipelineBindPoint::Graphics, { 0 });
+		Resources::ClusterCulling::ComputeShader->Dispatch(Resources::ClusterCulling::CommandBuffer, clusters.x, clusters.y, clusters.z);
 
-			mesh.MeshObject->GetVertexBuffer()->Bind(Resources::Shading::RenderPass->GetCommandBuffer());
-			mesh.MeshObject->GetIndexBuffer()->Bind(Resources::Shading::RenderPass->GetCommandBuffer());
+		Resources::ClusterCulling::CommandBuffer->EndTiming();
 
-			Renderer::DrawIndexed(Resources::Shading::RenderPass->GetCommandBuffer(), mesh.MeshObject->GetIndexBuffer());
+		ReleaseLightLists(Resources::ClusterCulling::CommandBuffer);
 
-			i++;
-		}
-
-		Resources::Shading::RenderPass->End();
-		Resources::Shading::RenderPass->Submit();
+		Resources::ClusterCulling::CommandBuffer->End();
+		Resources::ClusterCulling::CommandBuffer->Submit(Queue::Compute);
 	});
 }
 
-void Scene::OnEvent(Event& e)
-{
-	EventHandler handler(e);
-
-	handler.Handle<WindowResizeEvent>(APP_BIND_EVENT_FN(Scene::OnResize));
-
-	m_Camera->OnEvent(e);
-}
-
-void Scene::OnImGuiRender()
-{
-}
-
-Ref<Scene> Scene::Create()
-{
-	return RefHelper::Create<Scene>();
-}
-
 void Scene::InitHeatMap()
 {
 	auto& window = Application::Get().GetWindow();
@@ -276,12 +795,14 @@ void Scene::InitHeatMap()
 		// Set 0 
 		{ 1, { 0, {
 			{ DescriptorType::StorageImage, 0, "u_Image", ShaderStage::Compute },
-			{ DescriptorType::StorageBuffer, 1, "u_Visibility", ShaderStage::Compute }
+			{ DescriptorType::StorageBuffer, 1, "u_Visibility", ShaderStage::Compute },
+			{ DescriptorType::Image, 2, "u_DepthBuffer", ShaderStage::Compute }
 		}}},
 
 		// Set 1 
 		{ 1, { 1, {
-			{ DescriptorType::UniformBuffer, 0, "u_Scene", ShaderStage::Compute }
+			{ DescriptorType::DynamicUniformBuffer, 0, "u_Scene", ShaderStage::Compute },
+			{ DescriptorType::DynamicUniformBuffer, 1, "u_Camera", ShaderStage::Compute }
 		}}},
 	});
 
@@ -295,34 +816,53 @@ void Scene::InitHeatMap()
 
 	m_HeatShader = ComputeShader::Create(shaderSpecs);
 	m_HeatPipeline = Pipeline::Create({ }, m_HeatSets, m_HeatShader);
+
+	Renderer::GetUploadRing()->Upload(m_HeatSets->GetSets(1)[0], m_HeatSets->GetLayout(1).GetDescriptorByName("u_Scene"), sizeof(ShaderScene));
+	Renderer::GetUploadRing()->Upload(m_HeatSets->GetSets(1)[0], m_HeatSets->GetLayout(1).GetDescriptorByName("u_Camera"), sizeof(ShaderCamera));
 }
 
 void Scene::RenderHeatMap()
 {
 	Renderer::Submit([this]() 
 	{
-		const glm::uvec2 tiles = GetTileCount();
+		// Note(Jorben): Groups of TILE_SIZE x TILE_SIZE pixels in both modes, every pixel looks up its own tile or cluster (see Heatmap.comp)
+		const glm::uvec2 groups = { (m_HeatAttachment->GetWidth() + TILE_SIZE - 1) / TILE_SIZE, (m_HeatAttachment->GetHeight() + TILE_SIZE - 1) / TILE_SIZE };
 		auto& set0 = m_HeatSets->GetSets(0)[0];
 		auto& set1 = m_HeatSets->GetSets(1)[0];
 
 		m_HeatCommand->Begin();
+		m_HeatCommand->BeginTiming("Heatmap", Resources::PassTimingFlags);
+
+		// Note(Jorben): Runs after shading, which waited on the light culling (at the fragment shader) and acquired its results.
+		// Also overwrites the previous frame's image
+		m_HeatCommand->Barrier(PipelineAccess::FragmentRead | PipelineAccess::ComputeWrite, PipelineAccess::ComputeRead | PipelineAccess::ComputeWrite);
 
 		m_HeatAttachment->Upload(set0, m_HeatSets->GetLayout(0).GetDescriptorByName("u_Image"));
 		Resources::LightCulling::LightVisibilityBuffer->Upload(set0, m_HeatSets->GetLayout(0).GetDescriptorByName("u_Visibility"));
-		Resources::SceneBuffer->Upload(set1, m_HeatSets->GetLayout(1).GetDescriptorByName("u_Scene"));
+		Renderer::GetDepthImage()->Upload(set0, m_HeatSets->GetLayout(0).GetDescriptorByName("u_DepthBuffer"));
 
 		m_HeatPipeline->Use(m_HeatCommand, PipelineBindPoint::Compute);
 
 		set0->Bind(m_HeatPipeline, m_HeatCommand, PipelineBindPoint::Compute);
-		set1->Bind(m_HeatPipeline, m_HeatCommand, PipelineBindPoint::Compute);
+		set1->Bind(m_HeatPipeline, m_HeatCommand, PipelineBindPoint::Compute, { m_SceneAllocation.GetDynamicOffset(), m_CameraAllocation.GetDynamicOffset() });
 
-		m_HeatShader->Dispatch(m_HeatCommand, tiles.x, tiles.y, 1);
+		m_HeatShader->Dispatch(m_HeatCommand, groups.x, groups.y, 1);
 
+		m_HeatCommand->EndTiming();
 		m_HeatCommand->End();
-		m_HeatCommand->Submit(Queue::Compute);
+		m_HeatCommand->Submit();
 	});
 }
 
+void Scene::ReleaseLightLists(Ref<CommandBuffer> commandBuffer)
+{
+	// Note(Jorben): Culling doesn't read the previous contents of the visibility & index buffers (the index counter & lights are written from the host),
+	// so only their way to graphics is a transfer
+	Resources::LightCulling::LightsBuffer->Release(commandBuffer, Queue::Compute, Queue::Graphics);
+	Resources::LightCulling::LightVisibilityBuffer->Release(commandBuffer, Queue::Compute, Queue::Graphics);
+	Resources::LightCulling::LightIndexBuffer->Release(commandBuffer, Queue::Compute, Queue::Graphics);
+}
+
 const glm::uvec2 Scene::GetTileCount() const
 {
 	glm::uvec2 tiles = {};
@@ -331,6 +871,15 @@ const glm::uvec2 Scene::GetTileCount() const
 	return tiles;
 }
 
+const glm::uvec3 Scene::GetClusterCount() const
+{
+	glm::uvec3 clusters = {};
+	clusters.x = (Application::Get().GetWindow().GetWidth() + CLUSTER_TILE_SIZE - 1) / CLUSTER_TILE_SIZE;
+	clusters.y = (Application::Get().GetWindow().GetHeight() + CLUSTER_TILE_SIZE - 1) / CLUSTER_TILE_SIZE;
+	clusters.z = CLUSTER_DEPTH_SLICES;
+	return clusters;
+}
+
 bool Scene::OnResize(WindowResizeEvent& e)
 {
 	Renderer::GetDepthImage()->Transition(ImageLayout::Undefined, ImageLayout::Depth);
@@ -341,3 +890,15 @@ bool Scene::OnResize(WindowResizeEvent& e)
 
 	return false;
 }
+
+bool Scene::OnKeyPress(KeyPressedEvent& e)
+{
+	// Switch between tiled and clustered light assignment
+	if (e.GetKeyCode() == Key::L && e.GetRepeatCount() == 0)
+	{
+		Resources::Assignment = (Resources::Assignment == LightAssignment::Tiled ? LightAssignment::Clustered : LightAssignment::Tiled);
+		APP_LOG_INFO("Light assignment: {0}", (Resources::Assignment == LightAssignment::Tiled ? "Tiled" : "Clustered"));
+	}
+
+	return false;
+}
\ No newline at end of file
@@ -10,39 +10,189 @@
 #include <Swift/Renderer/Buffers.hpp>
 #include <Swift/Renderer/Pipeline.hpp>
 #include <Swift/Renderer/Descriptors.hpp>
+#include <Swift/Renderer/FrameUploadRing.hpp>
+#include <Swift/Renderer/RendererConfig.hpp>
 
 #include <entt/entt.hpp>
 
 #include "FPR/Camera.hpp"
+#include "FPR/Components.hpp"
 
 using namespace Swift;
 
+struct LightListStatistics
+{
+public:
+	uint32_t Cells = 0;
+	uint32_t EmptyCells = 0;
+
+	uint32_t MinLights = 0;
+	uint32_t MaxLights = 0;
+	float AverageLights = 0.0f;
+
+	// In uints, the pool overflowed (and lights got dropped) if Used > Capacity
+	uint32_t PoolUsed = 0;
+	uint32_t PoolCapacity = 0;
+};
+
 class Scene
 {
 public:
 	Scene();
 	virtual ~Scene();
 
+	// Note(Jorben): OnUpdate only turns what changed in the registry into a snapshot, everything touching the GPU
+	// happens in render commands, so it can run while the render thread executes the previous frame.
+	// Transforms have to be changed through entt::registry::patch/replace, otherwise the change isn't picked up.
 	void OnUpdate(float deltaTime);
 	void OnRender();
 	void OnEvent(Event& e);
 	void OnImGuiRender();
 
+	// Note(Jorben): Adds the viking rooms and lights from the original demo
+	void LoadDemo();
+
+	// Note(Jorben): Reads back the light lists of the last frame that used the current frame's buffers,
+	// has to be called from a render command submitted before OnUpdate since that resets the index pool
+	LightListStatistics GetLightListStatistics();
+
+	inline entt::registry& GetRegistry() { return m_Registry; }
+	inline Ref<Camera> GetCamera() { return m_Camera; }
+
 	static Ref<Scene> Create();
 
 private:
+	// Every entity with the same mesh & albedo, drawn with a single instanced draw
+	struct DrawBatch
+	{
+	public:
+		MeshComponent Mesh = {};
+
+		uint32_t InstanceCount = 0; // Note(Jorben): 0 for a batch in m_FreeBatches
+	};
+
+	// An entity's model matrix & batch in the resident model & instance buffers
+	struct DrawInstance
+	{
+	public:
+		entt::entity Entity = entt::null;
+		uint32_t Batch = 0;
+	};
+
+	// Every batch with the same albedo, drawn with a single indirect draw in the shading pass
+	struct DrawGroup
+	{
+	public:
+		Ref<Image2D> Albedo = nullptr;
+
+		uint32_t FirstBatch = 0;
+		uint32_t BatchCount = 0;
+	};
+
+	// Everything a frame needs from the registry, handed to the render commands by value
+	// Note(Jorben): Only holds the instances & batches that changed, the render side keeps the rest resident (see ResidentScene)
+	struct FrameSnapshot
+	{
+	public:
+		ShaderCamera Camera = {};
+		ShaderScene Scene = {};
+		bool GPUDriven = true; // Note(Jorben): Read once, so every pass of the frame agrees on how it's drawn
+
+		uint32_t InstanceCount = 0;
+		std::vector<uint32_t> Slots = { }; // The changed instances, Models[i] & Instances[i] belong to Slots[i]
+		std::vector<ShaderModel> Models = { };
+		std::vector<uint32_t> Instances = { }; // The batch of every changed instance
+
+		// Note(Jorben): Only filled in when an instance or batch was added or removed, the batches' instance ranges shift then
+		bool BatchesChanged = false;
+		std::vector<ShaderBatch> Batches = { }; // Indexed by batch
+		std::vector<IndexedIndirectCommand> Commands = { }; // Sorted by albedo, so every group's commands are contiguous
+		std::vector<DrawGroup> Groups = { };
+
+		std::vector<ShaderPointLight> Lights = { };
+	};
+
+	// Everything resident in the GPU buffers & what every frame's copy of them still misses
+	struct ResidentScene
+	{
+	public:
+		inline static constexpr const size_t Copies = (size_t)RendererSpecification::BufferCount;
+
+	public:
+		uint32_t InstanceCount = 0;
+		std::vector<ShaderModel> Models = { }; // Indexed by slot
+		std::vector<uint32_t> Instances = { }; // Indexed by slot
+
+		std::vector<ShaderBatch> Batches = { };
+		std::vector<IndexedIndirectCommand> Commands = { };
+		std::vector<DrawGroup> Groups = { };
+
+		std::array<std::vector<uint32_t>, Copies> DirtySlots = { };
+		std::array<bool, Copies> DirtyInstances = { }; // Note(Jorben): The copy lost its contents (by growing), every slot is written again
+		std::array<bool, Copies> DirtyBatches = { };
+
+		// Without GPU driven rendering, see Resources::GPUDriven
+		bool GPUDriven = true;
+		std::vector<uint32_t> Draws = { }; // The command of every draw, sorted by command, draw i is instance i in the visible buffer
+		std::vector<uint32_t> CommandGroups = { }; // The group of every command
+	};
+
+	void UploadFrame(FrameSnapshot& snapshot);
+	// Frustum culls the resident instances & fills in the draws and the visible buffer, the CPU side of the DrawCulling pass
+	void CullDraws(const ShaderCamera& camera);
+	// Records a draw per visible instance from multiple threads, bind is called once per secondary command buffer.
+	// Note(Jorben): The albedo sets are only bound when albedoPipeline isn't null
+	void RecordDraws(Ref<RenderPass> renderPass, const std::function<void(Ref<CommandBuffer>)>& bind, Ref<Pipeline> albedoPipeline = nullptr);
+
+	// Registry signals, keep the instances & batches up to date
+	void OnMeshChange(entt::registry& registry, entt::entity entity);
+	void OnMeshDestroy(entt::registry& registry, entt::entity entity);
+	void OnTransformChange(entt::registry& registry, entt::entity entity);
+
+	void AddInstance(entt::entity entity, const MeshComponent& mesh);
+	void RemoveInstance(entt::entity entity);
+
+	void RenderDrawCulling();
+	void RenderTileCulling();
+	void RenderClusterCulling();
+	// Hands the light lists from the compute queue to graphics, recorded at the end of the light culling
+	void ReleaseLightLists(Ref<CommandBuffer> commandBuffer);
+
 	void InitHeatMap();
 	void RenderHeatMap();
 
 	const glm::uvec2 GetTileCount() const;
+	const glm::uvec3 GetClusterCount() const;
 
 	bool OnResize(WindowResizeEvent& e);
+	bool OnKeyPress(KeyPressedEvent& e);
 
 private:
 	entt::registry m_Registry = {};
 
 	Ref<Camera> m_Camera = nullptr;
 
+	bool m_LightsClamped = false; // Note(Jorben): So the warning is only logged once
+
+	// Note(Jorben): Swap removed, so the instances stay contiguous
+	std::vector<DrawInstance> m_Instances = { }; // Indexed by slot
+	Dict<entt::entity, uint32_t> m_InstanceSlots = { };
+
+	std::vector<DrawBatch> m_Batches = { };
+	std::map<std::pair<const Image2D*, const Mesh*>, uint32_t> m_BatchIndices = { }; // Note(Jorben): Ordered by albedo, so the commands can be sorted from it
+	std::vector<uint32_t> m_FreeBatches = { };
+	bool m_BatchesChanged = false;
+
+	std::vector<entt::entity> m_PendingEntities = { }; // Note(Jorben): Waiting on their mesh & albedo upload
+	std::vector<entt::entity> m_DirtyEntities = { };
+
+	// Note(Jorben): Only used from inside render commands
+	ResidentScene m_Resident = {};
+
+	// Per frame data, lives in the renderer's upload ring
+	FrameAllocation m_CameraAllocation = {};
+	FrameAllocation m_SceneAllocation = {};
+
 	// Heatmap
 	Ref<Image2D> m_HeatAttachment = nullptr;
 
@@ -0,0 +1,130 @@
+project "FPRBench"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++20"
+	staticruntime "off"
+	
+	architecture "x86_64"
+	
+	-- Note(Jorben): The benchmark uses FPR's assets, shaders and scene (FPRScene)
+	debugdir ("%{wks.location}/FPR")
+	
+	targetdir ("%{wks.location}/bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("%{wks.location}/bin-int/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"src/**.h",
+		"src/**.hpp",
+		"src/**.cpp"
+	}
+
+	includedirs
+	{
+		"src",
+		"%{wks.location}/FPR/src",
+		"%{wks.location}/FPR/assets/shaders",
+		"%{wks.location}/vendor",
+
+		"%{wks.location}/Core/src",
+
+		"%{Dependencies.GLFW.IncludeDir}",
+		"%{Dependencies.GLM.IncludeDir}",
+		"%{Dependencies.Spdlog.IncludeDir}",
+		"%{Dependencies.Stb_image.IncludeDir}",
+		"%{Dependencies.Assimp.IncludeDir}",
+		"%{Dependencies.ImGui.IncludeDir}",
+		"%{Dependencies.Tracy.IncludeDir}",
+		"%{Dependencies.VMA.IncludeDir}",
+		"%{Dependencies.EnTT.IncludeDir}"
+	}
+
+	links
+	{
+		"FPRScene",
+		"Swift"
+	}
+
+	disablewarnings
+	{
+		"4005",
+		"4996"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+		staticruntime "on"
+
+		defines
+		{
+			"APP_PLATFORM_WINDOWS",
+			"GLFW_INCLUDE_NONE"
+		}
+		
+		includedirs
+		{
+			"%{Dependencies.Vulkan.Windows.IncludeDir}"
+		}
+
+	filter "system:linux"
+		systemversion "latest"
+		staticruntime "on"
+
+		defines
+		{
+			"APP_PLATFORM_LINUX",
+			"GLFW_INCLUDE_NONE"
+		}
+
+		includedirs
+		{
+			"%{Dependencies.Vulkan.Linux.IncludeDir}"
+		}
+
+		links
+		{
+			"pthread",
+			"dl"
+		}
+
+	filter "configurations:Debug"
+		defines "APP_DEBUG"
+		runtime "Debug"
+		symbols "on"
+		editandcontinue "Off"
+
+		defines
+		{
+			"TRACY_ENABLE",
+			"TRACY_ON_DEMAND",
+			"NOMINMAX"
+		}
+
+	filter "configurations:Release"
+		defines "APP_RELEASE"
+		runtime "Release"
+		optimize "on"
+
+		defines
+		{
+			"TRACY_ENABLE",
+			"TRACY_ON_DEMAND",
+			"NOMINMAX"
+		}
+
+	filter "configurations:Dist"
+		defines "APP_DIST"
+		runtime "Release"
+		optimize "Full"
+
+	filter { "system:windows", "configurations:Debug" }
+		postbuildcommands
+		{
+			'{COPYFILE} "%{Dependencies.Assimp.Windows.DebugDynamicLib}" "%{cfg.targetdir}"'
+		}
+
+	filter { "system:windows", "configurations:Release or configurations:Dist" }
+		postbuildcommands
+		{
+			'{COPYFILE} "%{Dependencies.Assimp.Windows.DynamicLib}" "%{cfg.targetdir}"'
+		}
\ No newline at end of file
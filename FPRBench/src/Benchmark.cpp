@@ -0,0 +1,257 @@
+#include "Benchmark.hpp"
+
+#include <Swift/Core/Application.hpp>
+#include <Swift/Renderer/Renderer.hpp>
+#include <Swift/Renderer/UploadManager.hpp>
+
+#include "FPR/Components.hpp"
+
+#include <cmath>
+#include <fstream>
+
+#include <glm/gtc/constants.hpp>
+
+Benchmark::Benchmark(const BenchmarkSpecification& specs)
+	: Layer("Benchmark"), m_Specification(specs), m_Random(specs.Seed)
+{
+	if (m_Specification.Lights > MAX_POINTLIGHTS)
+	{
+		APP_LOG_WARN("Requested {0} lights, the renderer supports up to {1}.", m_Specification.Lights, MAX_POINTLIGHTS);
+		m_Specification.Lights = MAX_POINTLIGHTS;
+	}
+}
+
+void Benchmark::OnAttach()
+{
+	Resources::ReuseDepth = m_Specification.ReuseDepth;
+	m_Scene = Scene::Create();
+	Resources::Assignment = m_Specification.Assignment;
+	Resources::GPUDriven = m_Specification.GPUDriven;
+	Resources::PassTimingFlags = (m_Specification.PipelineStatistics ? TimingFlags::PipelineStatistics : TimingFlags::None);
+
+	BuildScene();
+
+	m_Frames.resize((size_t)m_Specification.WarmupFrames + (size_t)m_Specification.Frames);
+}
+
+void Benchmark::OnDetach()
+{
+	// Note(Jorben): Detaching happens after the render thread has executed every frame
+	if (m_Finished)
+		WriteReport();
+}
+
+void Benchmark::OnUpdate(float deltaTime)
+{
+	double now = Utils::ToolKit::GetTime();
+
+	// Finish the previous frame
+	if (m_FrameIndex > 0 && m_FrameIndex <= (uint32_t)m_Frames.size())
+		m_Frames[m_FrameIndex - 1].FrameTime = (float)((now - m_FrameStart) * 1000.0);
+
+	if (m_FrameIndex == (uint32_t)m_Frames.size() && !m_Finished)
+	{
+		m_Finished = true;
+		Application::Get().Close();
+	}
+
+	m_FrameStart = now;
+
+	// Note(Jorben): Executed before the scene's commands, since those reset the index pool
+	if (m_FrameIndex < (uint32_t)m_Frames.size())
+	{
+		Renderer::Submit([this, index = m_FrameIndex]()
+		{
+			BenchmarkFrame& frame = m_Frames[index];
+			frame.Frame = index;
+			frame.LightLists = m_Scene->GetLightListStatistics();
+			frame.GPUTime = Renderer::GetRenderData().GPUTime;
+			frame.AsyncComputeOverlap = Renderer::GetRenderData().AsyncComputeOverlap;
+			frame.Passes = Renderer::GetRenderData().Timings;
+			frame.BuildWait = Renderer::GetRenderData().BuildWait;
+			frame.ExecuteWait = Renderer::GetRenderData().ExecuteWait;
+		});
+	}
+
+	UpdateCamera();
+	m_Scene->OnUpdate(deltaTime);
+
+	m_FrameIndex++;
+}
+
+void Benchmark::OnRender()
+{
+	m_Scene->OnRender();
+
+	// Note(Jorben): OnUpdate already moved on to the next frame index
+	uint32_t index = m_FrameIndex - 1;
+	if (index >= (uint32_t)m_Frames.size())
+		return;
+
+	// Note(Jorben): Executed at the end of the render queue, after everything of this frame has been recorded & submitted
+	Renderer::Submit([this, index, start = m_FrameStart]()
+	{
+		m_Frames[index].CPUTime = (float)((Utils::ToolKit::GetTime() - start) * 1000.0);
+		m_Frames[index].DrawCalls = Renderer::GetRenderData().DrawCalls;
+	});
+}
+
+void Benchmark::OnEvent(Event& e)
+{
+	m_Scene->OnEvent(e);
+}
+
+void Benchmark::BuildScene()
+{
+	auto& registry = m_Scene->GetRegistry();
+
+	Ref<Mesh> mesh = Mesh::CreateAsync("assets/objects/viking_room.obj");
+	Ref<Image2D> albedo = Image2D::CreateAsync({ "assets/objects/viking_room.png" });
+
+	// Note(Jorben): The scene skips meshes that aren't uploaded yet, so this is waited on to draw the same scene in every frame (warm-up or not)
+	Renderer::GetUploadManager()->Wait();
+	APP_ASSERT((mesh->IsReady() && albedo->IsReady()), "The benchmark's mesh & albedo failed to upload.");
+
+	// Meshes, laid out on a square grid around the origin
+	const float spacing = 2.5f;
+	const uint32_t columns = std::max(1u, (uint32_t)std::ceil(std::sqrt((float)m_Specification.Meshes)));
+	m_Extent = (float)columns * spacing;
+
+	for (uint32_t i = 0; i < m_Specification.Meshes; i++)
+	{
+		TransformComponent transform = {};
+		transform.Position = { ((float)(i % columns) + 0.5f) * spacing - m_Extent * 0.5f, 0.0f, ((float)(i / columns) + 0.5f) * spacing - m_Extent * 0.5f };
+		transform.Rotation = { -90.0f, 0.0f, 270.0f };
+
+		entt::entity entity = registry.create();
+		registry.emplace<TransformComponent>(entity, transform);
+		registry.emplace<MeshComponent>(entity, mesh, albedo);
+	}
+
+	// Lights, scattered over the same area
+	for (uint32_t i = 0; i < m_Specification.Lights; i++)
+	{
+		TransformComponent transform = {};
+		transform.Position = { RandomFloat(-0.5f, 0.5f) * m_Extent, RandomFloat(-0.5f, 1.5f), RandomFloat(-0.5f, 0.5f) * m_Extent };
+
+		PointLightComponent light = {};
+		light.Colour = { RandomFloat(0.2f, 1.0f), RandomFloat(0.2f, 1.0f), RandomFloat(0.2f, 1.0f) };
+		light.Radius = RandomRadius();
+		light.Intensity = 1.0f;
+
+		entt::entity entity = registry.create();
+		registry.emplace<TransformComponent>(entity, transform);
+		registry.emplace<PointLightComponent>(entity, light);
+	}
+
+	APP_LOG_INFO("Benchmark scene: {0} meshes, {1} lights, {2} warm-up frames, {3} measured frames.", m_Specification.Meshes, m_Specification.Lights, m_Specification.WarmupFrames, m_Specification.Frames);
+}
+
+void Benchmark::UpdateCamera()
+{
+	// Note(Jorben): One orbit over the measured frames, with a slow bob so the depth distribution changes as well.
+	// The warm-up frames stay at the start of the orbit.
+	const uint32_t measuredFrame = (m_FrameIndex > m_Specification.WarmupFrames ? m_FrameIndex - m_Specification.WarmupFrames : 0u);
+	const float t = glm::two_pi<float>() * (float)measuredFrame / (float)std::max(1u, m_Specification.Frames);
+	const float radius = m_Extent * 0.6f + 2.0f;
+	const float height = m_Extent * 0.25f + 1.0f + std::sin(t * 2.0f) * m_Extent * 0.1f;
+
+	m_Scene->GetCamera()->LookAt({ std::cos(t) * radius, height, std::sin(t) * radius }, { 0.0f, 0.0f, 0.0f });
+}
+
+void Benchmark::WriteReport()
+{
+	std::ofstream file(m_Specification.Output);
+	if (!file.is_open())
+	{
+		APP_LOG_ERROR("Failed to open benchmark output file: {0}", m_Specification.Output.string());
+		return;
+	}
+
+	// Note(Jorben): Passes only show up once they've been resolved, so the columns are the union over all frames
+	std::vector<std::string> passes = { };
+	for (auto& frame : m_Frames)
+	{
+		if (frame.Frame < m_Specification.WarmupFrames)
+			continue;
+
+		for (auto& [name, timing] : frame.Passes)
+		{
+			if (std::find(passes.begin(), passes.end(), name) == passes.end())
+				passes.push_back(name);
+		}
+	}
+
+	file << "Frame,CpuMs,FrameMs,BuildWaitMs,ExecuteWaitMs,GpuMs,AsyncOverlapMs,DrawCalls,LightCells,EmptyCells,MinLights,AvgLights,MaxLights,PoolUsed,PoolCapacity";
+	for (auto& pass : passes)
+	{
+		file << ',' << pass << "Ms";
+		if (m_Specification.PipelineStatistics)
+			file << ',' << pass << "VertexInvocations," << pass << "FragmentInvocations," << pass << "ComputeInvocations";
+	}
+	file << '\n';
+
+	double cpuTotal = 0.0, frameTotal = 0.0, gpuTotal = 0.0;
+	for (auto& frame : m_Frames)
+	{
+		if (frame.Frame < m_Specification.WarmupFrames)
+			continue;
+
+		const LightListStatistics& lists = frame.LightLists;
+
+		file << frame.Frame << ',' << frame.CPUTime << ',' << frame.FrameTime << ',' << frame.BuildWait << ',' << frame.ExecuteWait << ',' << frame.GPUTime << ',' << frame.AsyncComputeOverlap << ',' << frame.DrawCalls << ','
+			<< lists.Cells << ',' << lists.EmptyCells << ',' << lists.MinLights << ',' << lists.AverageLights << ',' << lists.MaxLights << ','
+			<< lists.PoolUsed << ',' << lists.PoolCapacity;
+
+		for (auto& pass : passes)
+		{
+			auto it = frame.Passes.find(pass);
+			GPUTiming timing = (it != frame.Passes.end() ? it->second : GPUTiming());
+
+			file << ',' << timing.Last;
+			if (m_Specification.PipelineStatistics)
+				file << ',' << timing.Statistics.VertexInvocations << ',' << timing.Statistics.FragmentInvocations << ',' << timing.Statistics.ComputeInvocations;
+		}
+		file << '\n';
+
+		cpuTotal += frame.CPUTime;
+		frameTotal += frame.FrameTime;
+		gpuTotal += frame.GPUTime;
+	}
+
+	if (m_Specification.Frames)
+	{
+		const double count = (double)m_Specification.Frames;
+		APP_LOG_INFO("Benchmark finished: {0} frames, average CPU time {1:.3f}ms, average frame time {2:.3f}ms, average GPU time {3:.3f}ms. Written to {4}", m_Specification.Frames, cpuTotal / count, frameTotal / count, gpuTotal / count, m_Specification.Output.string());
+	}
+}
+
+float Benchmark::RandomFloat(float min, float max)
+{
+	// Note(Jorben): The top 24 bits fit exactly in a float's mantissa
+	float value = (float)(m_Random() >> 8) * (1.0f / 16777216.0f);
+	return min + (max - min) * value;
+}
+
+float Benchmark::RandomRadius()
+{
+	switch (m_Specification.Distribution)
+	{
+	case RadiusDistribution::Constant:
+		return m_Specification.MaxRadius;
+	case RadiusDistribution::Uniform:
+		return RandomFloat(m_Specification.MinRadius, m_Specification.MaxRadius);
+	case RadiusDistribution::Exponential:
+	{
+		// Note(Jorben): Mostly small lights with a long tail, mean at a quarter of the range
+		float value = -std::log(1.0f - RandomFloat()) * 0.25f;
+		return std::min(m_Specification.MinRadius + value * (m_Specification.MaxRadius - m_Specification.MinRadius), m_Specification.MaxRadius);
+	}
+
+	default:
+		APP_LOG_ERROR("Invalid radius distribution selected.");
+		break;
+	}
+
+	return m_Specification.MaxRadius;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <map>
+#include <random>
+#include <vector>
+#include <filesystem>
+
+#include <Swift/Core/Layer.hpp>
+
+#include "FPR/Scene.hpp"
+#include "FPR/Resources.hpp"
+
+using namespace Swift;
+
+enum class RadiusDistribution : uint8_t
+{
+	None = 0, Constant, Uniform, Exponential
+};
+
+struct BenchmarkSpecification
+{
+public:
+	// Scene
+	uint32_t Meshes = 64;
+	uint32_t Lights = 512; // Note(Jorben): Clamped to MAX_POINTLIGHTS
+
+	RadiusDistribution Distribution = RadiusDistribution::Uniform;
+	float MinRadius = 0.5f;
+	float MaxRadius = 2.0f;
+
+	LightAssignment Assignment = LightAssignment::Tiled;
+	uint32_t Seed = 1337u;
+
+	bool PipelineStatistics = false;
+	bool ReuseDepth = true; // Note(Jorben): See Resources::ReuseDepth, compare the Shading pass' FragmentInvocations with & without
+	bool GPUDriven = true; // Note(Jorben): See Resources::GPUDriven, compare the CPU time with & without
+
+	// Run
+	uint32_t WarmupFrames = 60u;
+	uint32_t Frames = 600u;
+
+	std::filesystem::path Output = "FPRBench.csv";
+
+public:
+	BenchmarkSpecification() = default;
+};
+
+struct BenchmarkFrame
+{
+public:
+	uint32_t Frame = 0;
+
+	// Note(Jorben): CPU time is from the start of the frame's update until its render queue has been recorded & submitted
+	// (with the render thread this includes the time the frame was queued), frame time is from the start of this frame
+	// until the start of the next one (includes waiting on the GPU)
+	float CPUTime = 0.0f;
+	float FrameTime = 0.0f;
+
+	// See RenderData::BuildWait & RenderData::ExecuteWait
+	float BuildWait = 0.0f;
+	float ExecuteWait = 0.0f;
+
+	uint32_t DrawCalls = 0;
+
+	// Note(Jorben): These are read back from the GPU, so they describe the frame RendererSpecification::BufferCount frames earlier
+	float GPUTime = 0.0f;
+	float AsyncComputeOverlap = 0.0f;
+	std::map<std::string, GPUTiming> Passes = { };
+	LightListStatistics LightLists = {};
+};
+
+// Note(Jorben): Builds a procedural scene from the specification, moves the camera along a fixed path
+// (driven by the frame index, not the time) and writes every frame after the warm-up to a CSV file once it's detached
+class Benchmark : public Layer
+{
+public:
+	Benchmark(const BenchmarkSpecification& specs);
+	virtual ~Benchmark() = default;
+
+	void OnAttach() override;
+	void OnDetach() override;
+
+	void OnUpdate(float deltaTime) override;
+	void OnRender() override;
+	void OnEvent(Event& e) override;
+
+private:
+	void BuildScene();
+	void UpdateCamera();
+
+	void WriteReport();
+
+	float RandomFloat(float min = 0.0f, float max = 1.0f);
+	float RandomRadius();
+
+private:
+	BenchmarkSpecification m_Specification = {};
+
+	Ref<Scene> m_Scene = nullptr;
+	float m_Extent = 0.0f;
+
+	// Note(Jorben): std::mt19937 is specified by the standard, the distributions aren't, so we map the values ourselves
+	std::mt19937 m_Random = {};
+
+	uint32_t m_FrameIndex = 0;
+	double m_FrameStart = 0.0;
+	bool m_Finished = false;
+
+	// Note(Jorben): Indexed by frame, the GPU side fields are filled in by render commands (possibly on the render thread)
+	std::vector<BenchmarkFrame> m_Frames = { };
+};
@@ -0,0 +1,118 @@
+#include <Swift/Core/Application.hpp>
+#include <Swift/Entrypoint.hpp>
+
+#include <Swift/Utils/Arguments.hpp>
+
+#include "Benchmark.hpp"
+
+class FPRBench : public Swift::Application
+{
+public:
+	FPRBench(const Swift::ApplicationSpecification& appInfo, const BenchmarkSpecification& benchSpecs)
+		: Swift::Application(appInfo)
+	{
+		AddLayer(new Benchmark(benchSpecs));
+	}
+};
+
+
+
+// ----------------------------------------------------------------
+//                    Set Application specs here...
+// ----------------------------------------------------------------
+Swift::Application* Swift::CreateApplication(int argc, char* argv[])
+{
+	ApplicationSpecification appInfo = {};
+	appInfo.WindowSpecs.Name = "SwiftFPR | Benchmark";
+	appInfo.WindowSpecs.Width = 1280;
+	appInfo.WindowSpecs.Height = 720;
+	appInfo.WindowSpecs.VSync = false;
+	appInfo.WindowSpecs.Headless = true;
+
+	BenchmarkSpecification benchSpecs = {};
+
+	// Note(Jorben): Usage: FPRBench [--window] [--statistics] [--no-depth-reuse] [--cpu-draws] [--render-thread] [--frames-ahead <count>] [--width <pixels>] [--height <pixels>] [--meshes <count>] [--lights <count>]
+	// [--radius constant|uniform|exponential] [--min-radius <radius>] [--max-radius <radius>] [--assignment tiled|clustered]
+	// [--seed <seed>] [--warmup <frames>] [--frames <frames>] [--output <file.csv>]
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+
+		if (argument == "--window")
+		{
+			appInfo.WindowSpecs.Headless = false;
+			continue;
+		}
+		else if (argument == "--statistics")
+		{
+			benchSpecs.PipelineStatistics = true;
+			continue;
+		}
+		else if (argument == "--no-depth-reuse")
+		{
+			benchSpecs.ReuseDepth = false;
+			continue;
+		}
+		else if (argument == "--cpu-draws")
+		{
+			benchSpecs.GPUDriven = false;
+			continue;
+		}
+		else if (argument == "--render-thread")
+		{
+			appInfo.RenderThread = true;
+			continue;
+		}
+
+		// Note(Jorben): Everything below takes a value, invalid values exit (see Utils::Arguments) while unknown arguments are ignored
+		if (i + 1 >= argc)
+			break;
+
+		if (argument == "--width")
+			Utils::Arguments::ParseValue(argument, argv[++i], appInfo.WindowSpecs.Width);
+		else if (argument == "--frames-ahead")
+			Utils::Arguments::ParseValue(argument, argv[++i], appInfo.FramesAhead);
+		else if (argument == "--height")
+			Utils::Arguments::ParseValue(argument, argv[++i], appInfo.WindowSpecs.Height);
+		else if (argument == "--meshes")
+			Utils::Arguments::ParseValue(argument, argv[++i], benchSpecs.Meshes);
+		else if (argument == "--lights")
+			Utils::Arguments::ParseValue(argument, argv[++i], benchSpecs.Lights);
+		else if (argument == "--radius")
+		{
+			std::string value = argv[++i];
+			if (value == "constant")
+				benchSpecs.Distribution = RadiusDistribution::Constant;
+			else if (value == "uniform")
+				benchSpecs.Distribution = RadiusDistribution::Uniform;
+			else if (value == "exponential")
+				benchSpecs.Distribution = RadiusDistribution::Exponential;
+			else
+				Utils::Arguments::Invalid(argument, argv[i], "constant, uniform or exponential");
+		}
+		else if (argument == "--min-radius")
+			Utils::Arguments::ParseValue(argument, argv[++i], benchSpecs.MinRadius);
+		else if (argument == "--max-radius")
+			Utils::Arguments::ParseValue(argument, argv[++i], benchSpecs.MaxRadius);
+		else if (argument == "--assignment")
+		{
+			std::string value = argv[++i];
+			if (value == "tiled")
+				benchSpecs.Assignment = LightAssignment::Tiled;
+			else if (value == "clustered")
+				benchSpecs.Assignment = LightAssignment::Clustered;
+			else
+				Utils::Arguments::Invalid(argument, argv[i], "tiled or clustered");
+		}
+		else if (argument == "--seed")
+			Utils::Arguments::ParseValue(argument, argv[++i], benchSpecs.Seed);
+		else if (argument == "--warmup")
+			Utils::Arguments::ParseValue(argument, argv[++i], benchSpecs.WarmupFrames);
+		else if (argument == "--frames")
+			Utils::Arguments::ParseValue(argument, argv[++i], benchSpecs.Frames);
+		else if (argument == "--output")
+			benchSpecs.Output = argv[++i];
+	}
+
+	return new FPRBench(appInfo, benchSpecs);
+}
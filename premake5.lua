@@ -127,4 +127,5 @@ group "Swift"
 group ""
 
 include "FPR"
+include "FPRBench"
 ------------------------------------------------------------------------------
\ No newline at end of file